@@ -0,0 +1,286 @@
+#!/usr/bin/env python
+#
+#                     The MCLinker Project
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+# gen-inputs.py - generate synthetic ELF inputs for the linker benchmarks.
+#
+# The inputs are written as assembly and assembled by llvm-mc, so every target
+# MCLinker supports can be generated on one host. The shape of the link is
+# controlled by the knobs below; the same seed always yields the same inputs.
+#
+# A manifest `link.json' is written next to the objects. It lists the target
+# triple and the linker arguments that link the inputs into an executable.
+
+import argparse
+import json
+import os
+import random
+import subprocess
+import sys
+
+# Relocation kinds and the assembly that produces them on each target. `%s' is
+# the referenced symbol. `text' snippets are put in the function bodies, `data'
+# snippets in the data section of the object. The x86 GOT references are data,
+# since newer assemblers relax the GOT loads in code to GOTPCRELX and GOT32X.
+TARGETS = {
+  'x86_64': {
+    'triple': 'x86_64-unknown-linux-gnu',
+    'word': '.quad',
+    'progbits': '@progbits',
+    'entry': ['_start:', '  call main_0', '  ret'],
+    'ret': '  ret',
+    'cfi': '  .cfi_adjust_cfa_offset 8',
+    'relocs': {
+      'call':  ('text', '  call %s'),
+      'pcrel': ('text', '  leaq %s(%%rip), %%rax'),
+      'got':   ('data', '  .long %s@GOTPCREL'),
+      'abs':   ('data', '  .quad %s'),
+    },
+  },
+  'i386': {
+    'triple': 'i386-unknown-linux-gnu',
+    'word': '.long',
+    'progbits': '@progbits',
+    'entry': ['_start:', '  call main_0', '  ret'],
+    'ret': '  ret',
+    'cfi': '  .cfi_adjust_cfa_offset 4',
+    'relocs': {
+      'call':  ('text', '  call %s'),
+      'pcrel': ('data', '  .long %s - .'),
+      'got':   ('data', '  .long %s@GOT'),
+      'abs':   ('data', '  .long %s'),
+    },
+  },
+  'arm': {
+    'triple': 'armv7-none-linux-gnueabi',
+    'word': '.long',
+    'progbits': '%progbits',
+    'entry': ['_start:', '  bl main_0', '  bx lr'],
+    'ret': '  bx lr',
+    'cfi': '  .cfi_adjust_cfa_offset 4',
+    'relocs': {
+      'call':  ('text', '  bl %s'),
+      'pcrel': ('data', '  .long %s - .'),
+      'got':   ('data', '  .long %s(GOT)'),
+      'abs':   ('data', '  .long %s'),
+    },
+  },
+  'aarch64': {
+    'triple': 'aarch64-none-linux-gnu',
+    'word': '.xword',
+    'progbits': '@progbits',
+    'entry': ['_start:', '  bl main_0', '  ret'],
+    'ret': '  ret',
+    'cfi': '  .cfi_adjust_cfa_offset 16',
+    'relocs': {
+      'call':  ('text', '  bl %s'),
+      'pcrel': ('text', '  adrp x0, %s\n  add x0, x0, :lo12:%s'),
+      'got':   ('text', '  adrp x0, :got:%s\n  ldr x0, [x0, :got_lo12:%s]'),
+      'abs':   ('data', '  .xword %s'),
+    },
+  },
+  'mips': {
+    'triple': 'mipsel-unknown-linux-gnu',
+    'word': '.word',
+    'progbits': '@progbits',
+    'entry': ['_start:', '  jal main_0', '  nop', '  jr $ra', '  nop'],
+    'ret': '  jr $ra\n  nop',
+    'cfi': '  .cfi_adjust_cfa_offset 4',
+    'relocs': {
+      'call':  ('text', '  jal %s\n  nop'),
+      'pcrel': ('data', '  .word %s - .'),
+      'got':   ('text', '  lw $2, %%got(%s)($28)'),
+      'abs':   ('data', '  .word %s'),
+    },
+  },
+}
+
+
+def parse_mix(pMix, pTarget):
+  """parse `kind=weight,...' into a list of (kind, weight)"""
+  mix = []
+  for item in pMix.split(','):
+    kind, _, weight = item.partition('=')
+    kind = kind.strip()
+    if kind not in TARGETS[pTarget]['relocs']:
+      sys.exit('gen-inputs: unknown relocation kind `%s\' for %s (one of %s)'
+               % (kind, pTarget,
+                  ', '.join(sorted(TARGETS[pTarget]['relocs']))))
+    mix.append((kind, float(weight or 1)))
+  return mix
+
+
+def pick(pRandom, pMix):
+  """pick a relocation kind by its weight"""
+  total = sum(weight for _, weight in pMix)
+  point = pRandom.uniform(0, total)
+  for kind, weight in pMix:
+    point -= weight
+    if point <= 0:
+      return kind
+  return pMix[-1][0]
+
+
+def func_name(pObj, pIdx):
+  return 'f_%d_%d' % (pObj, pIdx)
+
+
+def gen_object(pArgs, pObj, pMix, pRandom):
+  """return the assembly of the pObj-th object"""
+  target = TARGETS[pArgs.target]
+  lines = ['  .text']
+  data = []
+  num_funcs = pArgs.symbols
+
+  for idx in range(num_funcs):
+    name = func_name(pObj, idx)
+    # with -ffunction-sections, every function has its own section
+    if pRandom.random() < pArgs.function_sections:
+      lines.append('  .section .text.%s,"ax",%s' % (name, target['progbits']))
+    else:
+      lines.append('  .text')
+    lines.append('  .globl %s' % name)
+    lines.append('  .type %s,%%function' % name)
+    lines.append('%s:' % name)
+
+    cfi = pRandom.random() < pArgs.eh_frame
+    if cfi:
+      lines.append('  .cfi_startproc')
+      lines.extend([target['cfi']] * pArgs.cfi_ops)
+
+    for _ in range(pArgs.relocs):
+      # reference a function of any object, so that the symbols are resolved
+      # across the inputs
+      callee = func_name(pRandom.randrange(pArgs.objects),
+                         pRandom.randrange(num_funcs))
+      section, snippet = target['relocs'][pick(pRandom, pMix)]
+      text = snippet.replace('%s', callee).replace('%%', '%')
+      if 'text' == section:
+        lines.append(text)
+      else:
+        data.append(text)
+
+    lines.append(target['ret'])
+    if cfi:
+      lines.append('  .cfi_endproc')
+    lines.append('  .size %s, .-%s' % (name, name))
+
+  if 0 == pObj:
+    lines.append('  .globl main_0')
+    lines.append('main_0:')
+    lines.append(target['ret'])
+    lines.append('  .globl _start')
+    lines.extend(target['entry'])
+    # pull every archive member into the link
+    for obj in range(1, pArgs.objects):
+      data.append('  %s %s' % (target['word'], func_name(obj, 0)))
+
+  if data:
+    lines.append('  .data')
+    lines.extend(data)
+
+  if pArgs.debug_info > 0:
+    # one address per function, as DW_AT_low_pc does, followed by filler
+    lines.append('  .section .debug_info,"",%s' % target['progbits'])
+    for idx in range(num_funcs):
+      lines.append('  %s %s' % (target['word'], func_name(pObj, idx)))
+    lines.append('  .zero %d' % pArgs.debug_info)
+    lines.append('  .section .debug_str,"MS",%s,1' % target['progbits'])
+    for idx in range(num_funcs):
+      lines.append('  .asciz "%s"' % func_name(pObj, idx))
+
+  return '\n'.join(lines) + '\n'
+
+
+def run(pCmd):
+  try:
+    subprocess.check_call(pCmd)
+  except (OSError, subprocess.CalledProcessError) as error:
+    sys.exit('gen-inputs: `%s\' failed: %s' % (' '.join(pCmd), error))
+
+
+def main():
+  parser = argparse.ArgumentParser(
+      description='Generate synthetic ELF inputs for the linker benchmarks.')
+  parser.add_argument('-o', '--output', required=True,
+                      help='the directory to write the inputs to')
+  parser.add_argument('--target', default='x86_64',
+                      choices=sorted(TARGETS.keys()))
+  parser.add_argument('--objects', type=int, default=100,
+                      help='the number of object files')
+  parser.add_argument('--symbols', type=int, default=100,
+                      help='the number of global functions per object')
+  parser.add_argument('--function-sections', type=float, default=1.0,
+                      help='the fraction of functions in their own section')
+  parser.add_argument('--archives', type=int, default=0,
+                      help='the number of archives the objects are spread '
+                           'over; 0 links the objects directly')
+  parser.add_argument('--eh-frame', type=float, default=1.0,
+                      help='the fraction of functions with an FDE')
+  parser.add_argument('--cfi-ops', type=int, default=1,
+                      help='the number of CFA instructions per FDE')
+  parser.add_argument('--debug-info', type=int, default=0,
+                      help='the bytes of .debug_info per object')
+  parser.add_argument('--relocs', type=int, default=4,
+                      help='the number of relocations per function')
+  parser.add_argument('--reloc-mix', default='call=4,pcrel=2,got=1,abs=1',
+                      help='the relative weights of the relocation kinds')
+  parser.add_argument('--seed', type=int, default=1)
+  parser.add_argument('--llvm-mc', default='llvm-mc')
+  parser.add_argument('--ar', default='ar')
+  args = parser.parse_args()
+
+  if args.objects < 1 or args.symbols < 1:
+    sys.exit('gen-inputs: --objects and --symbols must be positive')
+  if args.archives >= args.objects:
+    sys.exit('gen-inputs: --archives must be less than --objects')
+
+  mix = parse_mix(args.reloc_mix, args.target)
+  rand = random.Random(args.seed)
+  triple = TARGETS[args.target]['triple']
+  if not os.path.isdir(args.output):
+    os.makedirs(args.output)
+
+  objects = []
+  for obj in range(args.objects):
+    asm = os.path.join(args.output, 'obj%d.s' % obj)
+    out = os.path.join(args.output, 'obj%d.o' % obj)
+    with open(asm, 'w') as f:
+      f.write(gen_object(args, obj, mix, rand))
+    run([args.llvm_mc, '-triple=' + triple, '-filetype=obj', asm, '-o', out])
+    os.remove(asm)
+    objects.append(out)
+
+  # object 0 holds the entry; the others go to the archives round-robin
+  inputs = [objects[0]]
+  if args.archives > 0:
+    members = [[] for _ in range(args.archives)]
+    for idx, obj in enumerate(objects[1:]):
+      members[idx % args.archives].append(obj)
+    archives = []
+    for idx, files in enumerate(members):
+      path = os.path.join(args.output, 'lib%d.a' % idx)
+      if os.path.exists(path):
+        os.remove(path)
+      run([args.ar, 'rcs', path] + files)
+      archives.append(path)
+    # the archives refer to each other
+    inputs += ['--start-group'] + archives + ['--end-group']
+  else:
+    inputs += objects[1:]
+
+  manifest = {
+    'target': args.target,
+    'triple': triple,
+    'args': ['-mtriple=' + triple, '-e', '_start'] + inputs,
+  }
+  with open(os.path.join(args.output, 'link.json'), 'w') as f:
+    json.dump(manifest, f, indent=2)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
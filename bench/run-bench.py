@@ -0,0 +1,186 @@
+#!/usr/bin/env python
+#
+#                     The MCLinker Project
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+# run-bench.py - run the linker benchmarks and compare them to the baselines.
+#
+# For every scenario in scenarios.json the inputs are generated by
+# gen-inputs.py (once, they are reused while the scenario is unchanged) and
+# linked several times with --time-trace. The fastest wall time of every
+# linker phase and the highest peak RSS over the runs are kept, and compared
+# to the baseline of the scenario. The script exits with 1 if any phase or the
+# peak RSS regresses by more than the tolerance.
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+BENCH_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def load_json(pPath):
+  with open(pPath) as f:
+    return json.load(f)
+
+
+def save_json(pPath, pValue):
+  with open(pPath, 'w') as f:
+    json.dump(pValue, f, indent=2, sort_keys=True)
+    f.write('\n')
+
+
+def generate(pArgs, pName, pParams):
+  """generate the inputs of scenario pName unless they are up to date"""
+  out = os.path.join(pArgs.work_dir, pName)
+  stamp = os.path.join(out, 'scenario.json')
+  if os.path.exists(stamp) and load_json(stamp) == pParams:
+    return out
+
+  cmd = [sys.executable, os.path.join(BENCH_DIR, 'gen-inputs.py'),
+         '-o', out, '--llvm-mc', pArgs.llvm_mc, '--ar', pArgs.ar]
+  for key in sorted(pParams):
+    cmd += ['--' + key, str(pParams[key])]
+  print('generating %s ...' % pName)
+  sys.stdout.flush()
+  if subprocess.call(cmd) != 0:
+    sys.exit('run-bench: cannot generate the inputs of %s' % pName)
+  save_json(stamp, pParams)
+  return out
+
+
+def link_once(pArgs, pDir):
+  """link the inputs in pDir once and return the trace events"""
+  manifest = load_json(os.path.join(pDir, 'link.json'))
+  trace = os.path.join(pDir, 'trace.json')
+  cmd = [pArgs.mcld] + manifest['args'] + \
+        ['-o', os.path.join(pDir, 'a.out'), '--time-trace=' + trace]
+  if subprocess.call(cmd) != 0:
+    sys.exit('run-bench: `%s\' failed' % ' '.join(cmd))
+  return load_json(trace)['traceEvents']
+
+
+def measure(pArgs, pDir):
+  """return the phase times (ms) and the peak RSS (MB) of the best runs"""
+  phases = {}
+  peak_rss = 0
+  for _ in range(pArgs.repeat):
+    for event in link_once(pArgs, pDir):
+      name = event['name']
+      wall = event['dur'] / 1000.0
+      phases[name] = min(phases.get(name, wall), wall)
+      peak_rss = max(peak_rss, event['args']['peak_rss'])
+  return {
+    'phases': phases,
+    'total': round(sum(phases.values()), 3),
+    'peak_rss': peak_rss / (1024.0 * 1024.0),
+  }
+
+
+def regressed(pBase, pNew, pTolerance, pMinDelta):
+  return pNew > pBase * (1.0 + pTolerance / 100.0) and \
+         pNew - pBase > pMinDelta
+
+
+def compare(pArgs, pName, pResult, pBaseline):
+  """print pResult against pBaseline and return the number of regressions"""
+  print('\n%s' % pName)
+  print('  %-24s %12s %12s %8s' % ('phase', 'base(ms)', 'now(ms)', 'delta'))
+  failures = 0
+  rows = [(name, pResult['phases'][name]) for name in pResult['phases']]
+  rows.sort(key=lambda row: -row[1])
+  rows.append(('total', pResult['total']))
+  for name, now in rows:
+    if 'total' == name:
+      base = pBaseline.get('total')
+    else:
+      base = pBaseline.get('phases', {}).get(name)
+    if base is None:
+      print('  %-24s %12s %12.3f %8s' % (name, '-', now, 'new'))
+      continue
+    mark = ''
+    if regressed(base, now, pArgs.tolerance, pArgs.min_delta):
+      mark = '  REGRESSION'
+      failures += 1
+    delta = (now - base) * 100.0 / base if base > 0 else 0.0
+    print('  %-24s %12.3f %12.3f %+7.1f%%%s' % (name, base, now, delta, mark))
+
+  base = pBaseline.get('peak_rss')
+  now = pResult['peak_rss']
+  if base is not None:
+    mark = ''
+    if regressed(base, now, pArgs.rss_tolerance, 0):
+      mark = '  REGRESSION'
+      failures += 1
+    print('  %-24s %12.1f %12.1f %+7.1f%%%s' % (
+        'peak rss(MB)', base, now, (now - base) * 100.0 / base, mark))
+  return failures
+
+
+def main():
+  parser = argparse.ArgumentParser(
+      description='Run the linker benchmarks and compare them to the '
+                  'baselines.')
+  parser.add_argument('--mcld', required=True, help='the ld.mcld to measure')
+  parser.add_argument('scenario', nargs='*',
+                      help='the scenarios to run (default: all)')
+  parser.add_argument('--scenarios',
+                      default=os.path.join(BENCH_DIR, 'scenarios.json'))
+  parser.add_argument('--baselines',
+                      default=os.path.join(BENCH_DIR, 'baselines'),
+                      help='the directory of the baselines')
+  parser.add_argument('--work-dir', default='bench-inputs',
+                      help='the directory of the generated inputs')
+  parser.add_argument('--repeat', type=int, default=3,
+                      help='the number of links per scenario')
+  parser.add_argument('--tolerance', type=float, default=10.0,
+                      help='the allowed slowdown of a phase, in percent')
+  parser.add_argument('--min-delta', type=float, default=5.0,
+                      help='slowdowns below this many ms are noise')
+  parser.add_argument('--rss-tolerance', type=float, default=5.0,
+                      help='the allowed growth of the peak RSS, in percent')
+  parser.add_argument('--update-baselines', action='store_true',
+                      help='record the results as the new baselines')
+  parser.add_argument('--llvm-mc', default='llvm-mc')
+  parser.add_argument('--ar', default='ar')
+  args = parser.parse_args()
+
+  scenarios = load_json(args.scenarios)
+  names = args.scenario or sorted(scenarios)
+  for name in names:
+    if name not in scenarios:
+      sys.exit('run-bench: unknown scenario `%s\'' % name)
+
+  failures = 0
+  for name in names:
+    params = scenarios[name]
+    result = measure(args, generate(args, name, params))
+    path = os.path.join(args.baselines, name + '.json')
+    if args.update_baselines:
+      if not os.path.isdir(args.baselines):
+        os.makedirs(args.baselines)
+      result['scenario'] = params
+      save_json(path, result)
+      print('%s: baseline written to %s' % (name, path))
+      continue
+    if not os.path.exists(path):
+      print('%s: no baseline (run with --update-baselines)' % name)
+      compare(args, name, result, {})
+      continue
+    baseline = load_json(path)
+    if baseline.get('scenario') != params:
+      print('%s: the baseline was recorded for other inputs' % name)
+    failures += compare(args, name, result, baseline)
+
+  if failures:
+    print('\n%d regression(s)' % failures)
+    return 1
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -103,6 +103,10 @@ class HashTableImpl {
   //  return the index of the element, or -1 when the element does not exist.
   int findKey(const key_type& pKey) const;
 
+  /// findKey - finds an element with key pKey whose full hash value pHash is
+  /// computed by the hasher in advance
+  int findKey(const key_type& pKey, unsigned int pHash) const;
+
   /// mayRehash - check the load_factor, compute the new size, and then doRehash
   void mayRehash();
 
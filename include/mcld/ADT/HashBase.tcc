@@ -157,10 +157,17 @@ template <typename HashEntryTy, typename HashFunctionTy>
 int HashTableImpl<HashEntryTy, HashFunctionTy>::findKey(
     const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey)
     const {
+  return findKey(pKey, m_Hasher(pKey));
+}
+
+template <typename HashEntryTy, typename HashFunctionTy>
+int HashTableImpl<HashEntryTy, HashFunctionTy>::findKey(
+    const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey,
+    unsigned int pHash) const {
   if (m_NumOfBuckets == 0)
     return -1;
 
-  unsigned int full_hash = m_Hasher(pKey);
+  unsigned int full_hash = pHash;
   unsigned int index = full_hash % m_NumOfBuckets;
 
   const unsigned int probe = 1;
@@ -82,6 +82,14 @@ class HashTable : public HashTableImpl<HashEntryTy, HashFunctionTy> {
   //  If the element does not exist, return end()
   const_iterator find(const key_type& pKey) const;
 
+  /// find - finds an element with key pKey whose hash value pHash is computed
+  /// by hasher in advance
+  iterator find(const key_type& pKey, unsigned int pHash);
+
+  /// find - finds an element with key pKey and hash value pHash, constant
+  /// version
+  const_iterator find(const key_type& pKey, unsigned int pHash) const;
+
   size_type count(const key_type& pKey) const;
 
   // -----  hash policy  ----- //
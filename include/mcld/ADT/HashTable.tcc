@@ -137,6 +137,36 @@ HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
   return const_iterator(this, index);
 }
 
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::iterator
+HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
+    const typename HashTable<HashEntryTy,
+                             HashFunctionTy,
+                             EntryFactoryTy>::key_type& pKey,
+    unsigned int pHash) {
+  int index;
+  if ((index = BaseTy::findKey(pKey, pHash)) == -1)
+    return end();
+  return iterator(this, index);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::const_iterator
+HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
+    const typename HashTable<HashEntryTy,
+                             HashFunctionTy,
+                             EntryFactoryTy>::key_type& pKey,
+    unsigned int pHash) const {
+  int index;
+  if ((index = BaseTy::findKey(pKey, pHash)) == -1)
+    return end();
+  return const_iterator(this, index);
+}
+
 template <typename HashEntryTy,
           typename HashFunctionTy,
           typename EntryFactoryTy>
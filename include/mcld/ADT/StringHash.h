@@ -107,7 +107,7 @@ struct StringHash<ELF>
     uint32_t x = 0;
 
     for (unsigned int i = 0; i < pKey.size(); ++i) {
-      hash_val = (hash_val << 4) + pKey[i];
+      hash_val = (hash_val << 4) + static_cast<unsigned char>(pKey[i]);
       if ((x = hash_val & 0xF0000000L) != 0)
         hash_val ^= (x >> 24);
       hash_val &= ~x;
@@ -159,7 +159,8 @@ struct StringHash<DJB>
     uint32_t hash_val = 5381;
 
     for (uint32_t i = 0; i < pKey.size(); ++i)
-      hash_val = ((hash_val << 5) + hash_val) + pKey[i];
+      hash_val = ((hash_val << 5) + hash_val) +
+                 static_cast<unsigned char>(pKey[i]);
 
     return hash_val;
   }
@@ -77,6 +77,9 @@ class NodeFactory : public GCFactory<Node<DataType>, 64> {
     Alloc::m_pCurrent = pClient.Alloc::m_pCurrent;
     Alloc::m_AllocatedNum = pClient.Alloc::m_AllocatedNum;
     Alloc::m_NumAllocData = pClient.Alloc::m_NumAllocData;
+    Alloc::m_NumOfChunks = pClient.Alloc::m_NumOfChunks;
+    Alloc::m_NumOfObjects = pClient.Alloc::m_NumOfObjects;
+    Alloc::addObjects(0);
   }
 
   /// concatenate - conncet two factories
@@ -85,6 +88,9 @@ class NodeFactory : public GCFactory<Node<DataType>, 64> {
     Alloc::m_pCurrent = pClient.Alloc::m_pCurrent;
     Alloc::m_AllocatedNum += pClient.Alloc::m_AllocatedNum;
     Alloc::m_NumAllocData += pClient.Alloc::m_NumAllocData;
+    Alloc::m_NumOfChunks += pClient.Alloc::m_NumOfChunks;
+    Alloc::m_NumOfObjects += pClient.Alloc::m_NumOfObjects;
+    Alloc::addObjects(0);
   }
 };
 
@@ -0,0 +1,63 @@
+//===- CompressedRegionFragment.h -----------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_FRAGMENT_COMPRESSEDREGIONFRAGMENT_H_
+#define MCLD_FRAGMENT_COMPRESSEDREGIONFRAGMENT_H_
+
+#include "mcld/Fragment/RegionFragment.h"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Allocator.h>
+#include <llvm/Support/DataTypes.h>
+
+namespace mcld {
+
+class Input;
+class LDSection;
+
+/** \class CompressedRegionFragment
+ *  \brief CompressedRegionFragment is the content of a compressed input
+ *  section.
+ *
+ *  The content is uncompressed into the link-owned pAllocator at the first
+ *  getRegion(), so the debug sections which are only copied to the output
+ *  are not uncompressed until they are emitted, and the ones which are
+ *  discarded are never uncompressed.
+ */
+class CompressedRegionFragment : public RegionFragment {
+ public:
+  /// CompressedRegionFragment
+  ///   @param pType       one of the ELF::ELFCOMPRESS values
+  ///   @param pCompressed the compressed stream, without any header
+  ///   @param pSize       the uncompressed size
+  ///   @param pInput      the input file, for diagnostics
+  ///   @param pSection    the input section, for diagnostics
+  CompressedRegionFragment(uint32_t pType,
+                           llvm::StringRef pCompressed,
+                           size_t pSize,
+                           llvm::BumpPtrAllocator& pAllocator,
+                           const Input& pInput,
+                           const LDSection& pSection,
+                           SectionData* pSD = NULL);
+
+  ~CompressedRegionFragment();
+
+ private:
+  void materialize() const;
+
+ private:
+  uint32_t m_Type;
+  llvm::StringRef m_Compressed;
+  llvm::BumpPtrAllocator& m_Allocator;
+  const Input& m_Input;
+  const LDSection& m_Section;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_FRAGMENT_COMPRESSEDREGIONFRAGMENT_H_
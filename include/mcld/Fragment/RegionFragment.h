@@ -24,8 +24,17 @@ class RegionFragment : public Fragment {
 
   ~RegionFragment();
 
-  const llvm::StringRef getRegion() const { return m_Region; }
-  llvm::StringRef getRegion() { return m_Region; }
+  const llvm::StringRef getRegion() const {
+    if (m_bPending)
+      materialize();
+    return m_Region;
+  }
+
+  llvm::StringRef getRegion() {
+    if (m_bPending)
+      materialize();
+    return m_Region;
+  }
 
   static bool classof(const Fragment* F) {
     return F->getKind() == Fragment::Region;
@@ -35,8 +44,22 @@ class RegionFragment : public Fragment {
 
   size_t size() const;
 
+ protected:
+  /// RegionFragment - a region of pSize bytes whose content is produced by
+  /// materialize() at the first call of getRegion().
+  RegionFragment(size_t pSize, SectionData* pSD);
+
+  /// setRegion - set the materialized content of a pending region
+  void setRegion(llvm::StringRef pRegion) const;
+
+ private:
+  /// materialize - produce the content of a pending region by setRegion()
+  virtual void materialize() const;
+
  private:
-  llvm::StringRef m_Region;
+  mutable llvm::StringRef m_Region;
+  size_t m_Size;
+  mutable bool m_bPending;
 };
 
 }  // namespace mcld
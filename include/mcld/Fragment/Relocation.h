@@ -45,7 +45,8 @@ class Relocation : public llvm::ilist_node<Relocation> {
   ~Relocation();
 
  public:
-  /// Initialize - set up the relocation factory
+  /// Initialize - set up the relocation factory of every thread. No thread
+  /// may create relocations while SetUp() runs.
   static void SetUp(const LinkerConfig& pConfig);
 
   /// Clear - Clean up the relocation factory
@@ -62,7 +63,8 @@ class Relocation : public llvm::ilist_node<Relocation> {
                             FragmentRef& pFragRef,
                             Address pAddend = 0);
 
-  /// Destroy - destroy a relocation entry
+  /// Destroy - destroy a relocation entry. The memory is given back to the
+  /// arena of the calling thread, which ignores entries of other arenas.
   static void Destroy(Relocation*& pRelocation);
 
   /// type - relocation type
@@ -11,6 +11,8 @@
 
 #include "mcld/Fragment/Fragment.h"
 
+#include <cstddef>
+
 namespace mcld {
 
 class SectionData;
@@ -18,6 +20,12 @@ class SectionData;
 /** \class TargetFragment
  *  \brief TargetFragment is a kind of MCFragment inherited by
  *  target-depedent Fragment.
+ *
+ *  The GOT and PLT entries are TargetFragments. A large output has hundreds
+ *  of thousands of them, so they are not allocated one by one: they are
+ *  carved from slabs, which are released at once by Clear() when the link is
+ *  reset. Entries are not contiguous by table; only the malloc per entry is
+ *  saved. Deleting a TargetFragment only runs its destructor.
  */
 class TargetFragment : public Fragment {
  protected:
@@ -32,6 +40,13 @@ class TargetFragment : public Fragment {
   }
 
   static bool classof(const TargetFragment*) { return true; }
+
+  static void* operator new(size_t pSize);
+
+  static void operator delete(void* pPtr) {}
+
+  /// Clear - release the memory of all TargetFragments
+  static void Clear();
 };
 
 }  // namespace mcld
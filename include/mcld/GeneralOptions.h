@@ -36,8 +36,21 @@ class GeneralOptions {
 
   enum HashStyle { SystemV = 0x1, GNU = 0x2, Both = 0x3 };
 
+  enum PackDynRelocs {
+    PackDynRelocs_None = 0x0,
+    PackDynRelocs_Android = 0x1,
+    PackDynRelocs_Relr = 0x2,
+    PackDynRelocs_AndroidRelr = 0x3
+  };
+
   enum ICF { ICF_None, ICF_All, ICF_Safe };
 
+  enum CompressDebug {
+    CompressDebug_None,
+    CompressDebug_Zlib,
+    CompressDebug_Zstd
+  };
+
   typedef std::vector<std::string> RpathList;
   typedef RpathList::iterator rpath_iterator;
   typedef RpathList::const_iterator const_rpath_iterator;
@@ -65,6 +78,30 @@ class GeneralOptions {
 
   bool trace() const { return m_bTrace; }
 
+  // --print-stats
+  void setPrintStats(bool pEnable = true) { m_bPrintStats = pEnable; }
+
+  bool printStats() const { return m_bPrintStats; }
+
+  // --print-hash-stats
+  void setPrintHashStats(bool pEnable = true) { m_bPrintHashStats = pEnable; }
+
+  bool printHashStats() const { return m_bPrintHashStats; }
+
+  // --print-memory-usage
+  void setPrintMemoryUsage(bool pEnable = true) {
+    m_bPrintMemoryUsage = pEnable;
+  }
+
+  bool printMemoryUsage() const { return m_bPrintMemoryUsage; }
+
+  // --time-trace=<file>
+  void setTimeTraceFile(const std::string& pFile) { m_TimeTraceFile = pFile; }
+
+  const std::string& timeTraceFile() const { return m_TimeTraceFile; }
+
+  bool hasTimeTrace() const { return !m_TimeTraceFile.empty(); }
+
   void setBsymbolic(bool pBsymbolic = true) { m_Bsymbolic = pBsymbolic; }
 
   bool Bsymbolic() const { return m_Bsymbolic; }
@@ -156,6 +193,10 @@ class GeneralOptions {
 
   bool hasOrigin() const { return m_bOrigin; }
 
+  bool hasPackRelativeRelocs() const {
+    return m_bPackRelativeRelocs || (m_PackDynRelocs & PackDynRelocs_Relr);
+  }
+
   uint64_t commPageSize() const { return m_CommPageSize; }
 
   uint64_t maxPageSize() const { return m_MaxPageSize; }
@@ -222,6 +263,13 @@ class GeneralOptions {
 
   bool printMap() const { return m_bPrintMap; }
 
+  // -Map=<file>
+  void setMapFile(const std::string& pFile) { m_MapFile = pFile; }
+
+  const std::string& mapFile() const { return m_MapFile; }
+
+  bool hasMapFile() const { return !m_MapFile.empty(); }
+
   void setWarnMismatch(bool pEnable = true) { m_bWarnMismatch = pEnable; }
 
   bool warnMismatch() const { return m_bWarnMismatch; }
@@ -241,6 +289,13 @@ class GeneralOptions {
 
   bool genUnwindInfo() const { return m_bGenUnwindInfo; }
 
+  // --lazy-shared-symbols
+  void setLazySharedSymbols(bool pEnable = true) {
+    m_bLazySharedSymbols = pEnable;
+  }
+
+  bool lazySharedSymbols() const { return m_bLazySharedSymbols; }
+
   // -G, max GP size option
   void setGPSize(int gpsize) { m_GPSize = gpsize; }
 
@@ -250,6 +305,21 @@ class GeneralOptions {
 
   void setHashStyle(unsigned int pStyle) { m_HashStyle = pStyle; }
 
+  // --hash-size=<number>, the bucket count of the hash tables. 0 lets the
+  // linker choose it.
+  unsigned int getHashSize() const { return m_HashSize; }
+
+  void setHashSize(unsigned int pSize) { m_HashSize = pSize; }
+
+  // --pack-dyn-relocs=[none|android|relr|android+relr]
+  unsigned int getPackDynRelocs() const { return m_PackDynRelocs; }
+
+  void setPackDynRelocs(unsigned int pStyle) { m_PackDynRelocs = pStyle; }
+
+  bool hasAndroidPackedRelocs() const {
+    return (m_PackDynRelocs & PackDynRelocs_Android) != 0;
+  }
+
   ICF getICFMode() const { return m_ICF; }
 
   void setICFMode(ICF pMode) { m_ICF = pMode; }
@@ -264,6 +334,51 @@ class GeneralOptions {
     m_bPrintICFSections = pPrintICFSections;
   }
 
+  // --compress-debug-sections=[none|zlib|zstd]
+  CompressDebug getCompressDebugSections() const { return m_CompressDebug; }
+
+  void setCompressDebugSections(CompressDebug pType) {
+    m_CompressDebug = pType;
+  }
+
+  // --symbol-ordering-file=<file>
+  void setSymbolOrderingFile(const std::string& pFile) {
+    m_SymbolOrderingFile = pFile;
+  }
+
+  const std::string& symbolOrderingFile() const { return m_SymbolOrderingFile; }
+
+  bool hasSymbolOrderingFile() const { return !m_SymbolOrderingFile.empty(); }
+
+  // --call-graph-profile-sort=<file>
+  void setCallGraphProfileFile(const std::string& pFile) {
+    m_CallGraphProfileFile = pFile;
+  }
+
+  const std::string& callGraphProfileFile() const {
+    return m_CallGraphProfileFile;
+  }
+
+  bool hasCallGraphProfile() const { return !m_CallGraphProfileFile.empty(); }
+
+  // --archive-index-cache=<dir>
+  void setArchiveIndexCache(const std::string& pDir) {
+    m_ArchiveIndexCache = pDir;
+  }
+
+  const std::string& archiveIndexCache() const { return m_ArchiveIndexCache; }
+
+  // --incremental
+  void setIncremental(bool pEnable = true) { m_bIncremental = pEnable; }
+
+  bool incremental() const { return m_bIncremental; }
+
+  // the command line of an incremental link. A link patches the output of a
+  // previous link only if their keys are the same.
+  void setIncrementalKey(const std::string& pKey) { m_IncrementalKey = pKey; }
+
+  const std::string& incrementalKey() const { return m_IncrementalKey; }
+
   // -----  link-in rpath  ----- //
   const RpathList& getRpathList() const { return m_RpathList; }
   RpathList& getRpathList() { return m_RpathList; }
@@ -325,6 +440,8 @@ class GeneralOptions {
   std::string m_DefaultLDScript;
   std::string m_Dyld;
   std::string m_SOName;
+  std::string m_TimeTraceFile;  // --time-trace=<file>
+  std::string m_MapFile;        // -Map=<file>
   int8_t m_Verbose;          // --verbose[=0,1,2]
   uint16_t m_MaxErrorNum;    // --error-limit=N
   uint16_t m_MaxWarnNum;     // --warning-limit=N
@@ -346,6 +463,7 @@ class GeneralOptions {
   bool m_bRelro : 1;         // relro, norelro
   bool m_bNow : 1;           // lazy, now
   bool m_bOrigin : 1;        // origin
+  bool m_bPackRelativeRelocs : 1;  // pack-relative-relocs
   bool m_bTrace : 1;         // --trace
   bool m_Bsymbolic : 1;      // --Bsymbolic
   bool m_Bgroup : 1;
@@ -368,15 +486,27 @@ class GeneralOptions {
   bool m_bPrintGCSections : 1;    // --print-gc-sections
   bool m_bGenUnwindInfo : 1;      // --ld-generated-unwind-info
   bool m_bPrintICFSections : 1;   // --print-icf-sections
+  bool m_bPrintStats : 1;         // --print-stats
+  bool m_bPrintHashStats : 1;     // --print-hash-stats
+  bool m_bPrintMemoryUsage : 1;   // --print-memory-usage
+  bool m_bLazySharedSymbols : 1;  // --lazy-shared-symbols
+  bool m_bIncremental : 1;        // --incremental
   ICF m_ICF;
   size_t m_ICFIterations;
+  CompressDebug m_CompressDebug;  // --compress-debug-sections
   uint32_t m_GPSize;  // -G, --gpsize
   StripSymbolMode m_StripSymbols;
   RpathList m_RpathList;
   ScriptList m_ScriptList;
   UndefSymList m_UndefSymList;  // -u [symbol], --undefined [symbol]
   unsigned int m_HashStyle;
+  unsigned int m_HashSize;       // --hash-size
+  unsigned int m_PackDynRelocs;  // --pack-dyn-relocs
   std::string m_Filter;
+  std::string m_SymbolOrderingFile;    // --symbol-ordering-file=<file>
+  std::string m_CallGraphProfileFile;  // --call-graph-profile-sort=<file>
+  std::string m_ArchiveIndexCache;     // --archive-index-cache=<dir>
+  std::string m_IncrementalKey;        // the command line of --incremental
   AuxiliaryList m_AuxiliaryList;
   ExcludeLIBS m_ExcludeLIBS;
 };
@@ -29,8 +29,10 @@
 
 namespace mcld {
 
+class DynObjReader;
 class InputTree;
 class LinkerConfig;
+class MemoryAreaFactory;
 class Module;
 
 /** \class IRBuilder
@@ -52,6 +54,12 @@ class IRBuilder {
  public:
   IRBuilder(Module& pModule, const LinkerConfig& pConfig);
 
+  /// IRBuilder - create an IRBuilder whose inputs share the MemoryAreas of
+  /// pMemoryFactory, which may outlive this IRBuilder.
+  IRBuilder(Module& pModule,
+            const LinkerConfig& pConfig,
+            MemoryAreaFactory& pMemoryFactory);
+
   ~IRBuilder();
 
   const InputBuilder& getInputBuilder() const { return m_InputBuilder; }
@@ -59,6 +67,11 @@ class IRBuilder {
   const Module& getModule() const { return m_Module; }
   Module& getModule() { return m_Module; }
 
+  /// setDynObjReader - set the reader of the dynamic objects whose symbols
+  /// are read lazily (--lazy-shared-symbols). AddSymbol<> looks up the name
+  /// in those objects before it decides how to define the symbol.
+  void setDynObjReader(DynObjReader* pReader) { m_pDynObjReader = pReader; }
+
   /// @}
   /// @name Input Files On The Command Line
   /// @{
@@ -300,6 +313,8 @@ class IRBuilder {
   /// AlignFragment before pFrag if the section header's alignment is larger
   /// than 1.
   /// @note This function does not update offset of section headers.
+  /// @note Threads may append to different section data at the same time,
+  /// but not to the same one.
   ///
   /// @param pFrag [in, out] The appended fragment. Its offset is set as the
   ///                        section offset in pSD.
@@ -312,6 +327,8 @@ class IRBuilder {
   /// This function tells MCLinker to add a general relocation to the
   /// relocation data. This function does not update offset and size of section
   /// headers.
+  /// @note Threads may append to different relocation data at the same time,
+  /// but not to the same one.
   ///
   /// @param pReloc [in]      The appended relocation.
   /// @param pRD    [in, out] The relocation data being appended.
@@ -456,6 +473,10 @@ class IRBuilder {
   bool shouldForceLocal(const ResolveInfo& pInfo, const LinkerConfig& pConfig);
 
  private:
+  /// resolveLazySymbol - read the entries named pName of the lazily read
+  /// dynamic objects
+  void resolveLazySymbol(const llvm::StringRef& pName);
+
   LDSymbol* addSymbolFromObject(const std::string& pName,
                                 ResolveInfo::Type pType,
                                 ResolveInfo::Desc pDesc,
@@ -479,6 +500,8 @@ class IRBuilder {
   const LinkerConfig& m_Config;
 
   InputBuilder m_InputBuilder;
+
+  DynObjReader* m_pDynObjReader;
 };
 
 template <>
@@ -15,6 +15,8 @@
 #include "mcld/ADT/StringHash.h"
 #include "mcld/Support/GCFactory.h"
 
+#include <llvm/ADT/StringRef.h>
+
 #include <string>
 #include <vector>
 
@@ -90,18 +92,30 @@ class Archive {
                     hash::StringHash<hash::DJB>,
                     EntryFactory<ArchiveMemberEntryType> > ArchiveMemberMapType;
 
+  /** \class Symbol
+   *  \brief Symbol is an entry of the armap.
+   *
+   *  The name is not copied; it refers to the armap of the mapped archive or
+   *  to the archive index cache. The hash is the hash value of the name in
+   *  the NamePool, so that the symbol is looked up without hashing the name
+   *  again.
+   */
   struct Symbol {
    public:
     enum Status { Include, Exclude, Unknown };
 
-    Symbol(const char* pName, uint32_t pOffset, enum Status pStatus)
-        : name(pName), fileOffset(pOffset), status(pStatus) {}
+    Symbol(const llvm::StringRef& pName,
+           uint32_t pOffset,
+           unsigned int pHash,
+           enum Status pStatus)
+        : name(pName), fileOffset(pOffset), hash(pHash), status(pStatus) {}
 
     ~Symbol() {}
 
    public:
-    std::string name;
+    llvm::StringRef name;
     uint32_t fileOffset;
+    unsigned int hash;
     enum Status status;
   };
 
@@ -180,14 +194,19 @@ class Archive {
   size_t numOfSymbols() const;
 
   /// addSymbol - add a symtab entry to symtab
-  /// @param pName - symbol name
+  /// @param pName - symbol name, which must outlive the archive
   /// @param pFileOffset - file offset in symtab represents a object file
-  void addSymbol(const char* pName,
+  /// @param pHash - the hash value of pName in the NamePool
+  void addSymbol(const llvm::StringRef& pName,
                  uint32_t pFileOffset,
+                 unsigned int pHash,
                  enum Symbol::Status pStatus = Archive::Symbol::Unknown);
 
   /// getSymbolName - get the symbol name with the given index
-  const std::string& getSymbolName(size_t pSymIdx) const;
+  llvm::StringRef getSymbolName(size_t pSymIdx) const;
+
+  /// getSymbolHash - get the NamePool hash value of the symbol name
+  unsigned int getSymbolHash(size_t pSymIdx) const;
 
   /// getObjFileOffset - get the file offset that represent a object file
   uint32_t getObjFileOffset(size_t pSymIdx) const;
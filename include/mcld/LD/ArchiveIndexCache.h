@@ -0,0 +1,82 @@
+//===- ArchiveIndexCache.h ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_ARCHIVEINDEXCACHE_H_
+#define MCLD_LD_ARCHIVEINDEXCACHE_H_
+
+#include <string>
+#include <vector>
+
+namespace llvm {
+class MemoryBuffer;
+}  // namespace llvm
+
+namespace mcld {
+
+class Archive;
+
+namespace sys {
+namespace fs {
+class FileStatus;
+}  // namespace fs
+}  // namespace sys
+
+/** \class ArchiveIndexCache
+ *  \brief ArchiveIndexCache keeps the armaps of archives in a directory
+ *  (--archive-index-cache=<dir>) across links.
+ *
+ *  An index holds the armap symbols of one archive, the NamePool hash value
+ *  of every symbol name, and the extended name table. It is keyed by the
+ *  absolute path, the size, the modification time (with nanoseconds where
+ *  the file system has them) and the inode of the archive, and is used only
+ *  if all of them match. No index is written for an archive modified within
+ *  the last couple of seconds, since a change in the same clock tick could
+ *  keep all of the key. The index is mapped and
+ *  the symbol names of the Archive refer into it, so a cached archive is
+ *  opened without parsing, and its symbols are looked up in the NamePool
+ *  without hashing the names. The mapped indexes live as long as the cache.
+ *
+ *  An index is written to a temporary file and renamed, so concurrent links
+ *  never read a partial index.
+ */
+class ArchiveIndexCache {
+ public:
+  explicit ArchiveIndexCache(const std::string& pDir);
+
+  ~ArchiveIndexCache();
+
+  /// read - read the symtab and the strtab of pArchive from its index
+  /// @return false if pArchive has no valid index
+  bool read(Archive& pArchive);
+
+  /// write - write the index of pArchive, whose symtab and strtab are read
+  /// @return false if the index cannot be written, or if pArchive was
+  /// modified too recently to be keyed by its status
+  bool write(const Archive& pArchive) const;
+
+ private:
+  /// getKey - get the absolute path and the status of the archive file
+  /// @return false if pArchive is not a regular file
+  bool getKey(const Archive& pArchive,
+              std::string& pPath,
+              sys::fs::FileStatus& pStatus) const;
+
+  /// getIndexPath - get the path of the index of the archive pPath
+  std::string getIndexPath(const std::string& pPath) const;
+
+ private:
+  typedef std::vector<llvm::MemoryBuffer*> IndexList;
+
+ private:
+  std::string m_Dir;
+  IndexList m_Indexes;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_ARCHIVEINDEXCACHE_H_
@@ -14,6 +14,8 @@
 
 #include <llvm/Support/DataTypes.h>
 
+#include <vector>
+
 namespace mcld {
 
 class Fragment;
@@ -49,7 +51,15 @@ class BranchIslandFactory : public GCFactory<BranchIsland, 0> {
   /// @return - return the pair of <fwd island, bwd island>
   std::pair<BranchIsland*, BranchIsland*> getIslands(const Fragment& pFragment);
 
+  /// islandSize - the total size of all islands
+  size_t islandSize() const;
+
+ private:
+  typedef std::vector<BranchIsland*> IslandListType;
+
  private:
+  /// m_Islands - the islands in the address order
+  IslandListType m_Islands;
   int64_t m_MaxFwdBranchRange;
   int64_t m_MaxBwdBranchRange;
   size_t m_MaxIslandSize;
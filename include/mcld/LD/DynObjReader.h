@@ -10,6 +10,8 @@
 #define MCLD_LD_DYNOBJREADER_H_
 #include "mcld/LD/LDReader.h"
 
+#include <llvm/ADT/StringRef.h>
+
 namespace mcld {
 
 class TargetLDBackend;
@@ -29,6 +31,15 @@ class DynObjReader : public LDReader {
   virtual bool readHeader(Input& pFile) = 0;
 
   virtual bool readSymbols(Input& pFile) = 0;
+
+  /// resolveSymbol - if the symbols of the dynamic objects are read lazily,
+  /// read the entries named pName of the dynamic objects read so far.
+  ///   @return true if any entry is read
+  virtual bool resolveSymbol(const llvm::StringRef& pName) { return false; }
+
+  /// resolveSymbols - if the symbols of the dynamic objects are read lazily,
+  /// read the entries of the names which the output leaves unresolved.
+  virtual void resolveSymbols() {}
 };
 
 }  // namespace mcld
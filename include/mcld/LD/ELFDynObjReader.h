@@ -10,6 +10,14 @@
 #define MCLD_LD_ELFDYNOBJREADER_H_
 #include "mcld/LD/DynObjReader.h"
 
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <utility>
+#include <vector>
+
 namespace mcld {
 
 class ELFReaderIF;
@@ -21,6 +29,13 @@ class LinkerConfig;
 /** \class ELFDynObjReader
  *  \brief ELFDynObjReader reads ELF dynamic shared objects.
  *
+ *  With --lazy-shared-symbols, the defined symbols of a dynamic object are
+ *  not all inserted into the NamePool. The .dynsym and the .gnu.hash or .hash
+ *  of the object are kept mapped, and the entries of a name are read only
+ *  when an archive member or the output refers to or defines the name. The
+ *  undefined entries are still read at once, since they decide which symbols
+ *  the output must export. The names the linker defines after the inputs are
+ *  read are looked up by IRBuilder::AddSymbol.
  */
 class ELFDynObjReader : public DynObjReader {
  public:
@@ -37,9 +52,71 @@ class ELFDynObjReader : public DynObjReader {
 
   bool readSymbols(Input& pInput);
 
+  /// resolveSymbol - read the entries named pName of the lazily read dynamic
+  /// objects. Every object is looked up only once for a name.
+  bool resolveSymbol(const llvm::StringRef& pName);
+
+  /// resolveSymbols - look up the undefined names in the NamePool in the
+  /// lazily read dynamic objects. The defined names are looked up as well
+  /// with --gc-sections, which keeps the definitions seen in dynamic objects.
+  void resolveSymbols();
+
+ private:
+  /** \class LazyDynObj
+   *  \brief LazyDynObj keeps the tables of a lazily read dynamic object.
+   */
+  struct LazyDynObj {
+    typedef std::vector<std::pair<uint64_t, uint32_t> > ObjectList;
+
+    Input* input;
+    llvm::StringRef symtab;
+    llvm::StringRef strtab;
+    llvm::StringRef gnuHash;
+    llvm::StringRef hash;
+
+    /// the defined data objects sorted by value, for the weak alias analysis
+    ObjectList objects;
+    bool hasObjects;
+
+    /// the entries that have been read
+    llvm::DenseSet<uint32_t> readEntries;
+  };
+
+  typedef std::vector<LazyDynObj*> LazyDynObjList;
+
  private:
+  /// readLazily - keep the tables of pInput and read its undefined entries.
+  ///   @return false if pInput has no usable hash table
+  bool readLazily(Input& pInput,
+                  llvm::StringRef pSymTab,
+                  llvm::StringRef pStrTab);
+
+  /// findSymbol - collect the entries named pName of pDynObj
+  void findSymbol(const LazyDynObj& pDynObj,
+                  const llvm::StringRef& pName,
+                  std::vector<uint32_t>& pEntries) const;
+
+  /// findAliases - collect the data objects at the address of pEntry
+  void findAliases(LazyDynObj& pDynObj,
+                   uint32_t pEntry,
+                   std::vector<uint32_t>& pEntries) const;
+
+  /// readEntries - read the entries of pDynObj that are not read yet
+  bool readEntries(LazyDynObj& pDynObj, std::vector<uint32_t>& pEntries);
+
+  /// getSymName - the name of the entry pIdx of pDynObj
+  llvm::StringRef getSymName(const LazyDynObj& pDynObj, uint32_t pIdx) const;
+
+ private:
+  const LinkerConfig& m_Config;
   ELFReaderIF* m_pELFReader;
   IRBuilder& m_Builder;
+  size_t m_SymSize;
+
+  LazyDynObjList m_LazyDynObjs;
+
+  /// the number of the lazily read dynamic objects looked up for a name
+  llvm::StringMap<size_t> m_Lookups;
 };
 
 }  // namespace mcld
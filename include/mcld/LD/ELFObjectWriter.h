@@ -38,6 +38,8 @@ class ELFObjectWriter : public ObjectWriter {
 
   size_t getOutputSize(const Module& pModule) const;
 
+  void emitSectionData(const LDSection& pSection, MemoryRegion& pRegion) const;
+
  private:
   void writeSection(Module& pModule,
                     FileOutputBuffer& pOutput,
@@ -70,8 +72,6 @@ class ELFObjectWriter : public ObjectWriter {
                     const Module& pModule,
                     FileOutputBuffer& pOutput);
 
-  void emitSectionData(const LDSection& pSection, MemoryRegion& pRegion) const;
-
   void emitEhFrame(Module& pModule,
                    EhFrame& pFrame,
                    MemoryRegion& pRegion) const;
@@ -66,7 +66,9 @@ class ELFReader<32, true> : public ELFReaderIF {
   bool readSectionHeaders(Input& pInput, const void* pELFHeader) const;
 
   /// readRegularSection - read a regular section and create fragments.
-  bool readRegularSection(Input& pInput, SectionData& pSD) const;
+  bool readRegularSection(Input& pInput,
+                          SectionData& pSD,
+                          IRBuilder& pBuilder) const;
 
   /// readSymbols - read ELF symbols and create LDSymbol
   bool readSymbols(Input& pInput,
@@ -151,7 +153,9 @@ class ELFReader<64, true> : public ELFReaderIF {
   bool readSectionHeaders(Input& pInput, const void* pELFHeader) const;
 
   /// readRegularSection - read a regular section and create fragments.
-  bool readRegularSection(Input& pInput, SectionData& pSD) const;
+  bool readRegularSection(Input& pInput,
+                          SectionData& pSD,
+                          IRBuilder& pBuilder) const;
 
   /// readSymbols - read ELF symbols and create LDSymbol
   bool readSymbols(Input& pInput,
@@ -57,7 +57,9 @@ class ELFReaderIF {
                                   const void* pELFHeader) const = 0;
 
   /// readRegularSection - read a regular section and create fragments.
-  virtual bool readRegularSection(Input& pInput, SectionData& pSD) const = 0;
+  virtual bool readRegularSection(Input& pInput,
+                                  SectionData& pSD,
+                                  IRBuilder& pBuilder) const = 0;
 
   /// readSymbols - read ELF symbols and create LDSymbol
   virtual bool readSymbols(Input& pInput,
@@ -99,6 +99,8 @@ class ELFSegment {
 
   /* factory methods */
   static ELFSegment* Create(uint32_t pType, uint32_t pFlag = llvm::ELF::PF_R);
+  /// Destroy - destroy a segment. The memory is given back to the arena of
+  /// the calling thread, which ignores objects of other arenas.
   static void Destroy(ELFSegment*& pSegment);
   static void Clear();
 
@@ -15,16 +15,20 @@
 #include "mcld/Support/Allocators.h"
 #include "mcld/Support/Compiler.h"
 
+#include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
 
 #include <list>
 #include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace mcld {
 
 class Input;
 class LDSection;
+class RelocData;
 class Relocation;
 
 /** \class EhFrame
@@ -111,6 +115,7 @@ class EhFrame {
 
     void add(FDE& pFDE) { m_FDEs.push_back(&pFDE); }
     void remove(FDE& pFDE) { m_FDEs.remove(&pFDE); }
+    fde_iterator erase(fde_iterator pIter) { return m_FDEs.erase(pIter); }
     void clearFDEs() { m_FDEs.clear(); }
     size_t numOfFDEs() const { return m_FDEs.size(); }
 
@@ -168,6 +173,8 @@ class EhFrame {
  public:
   static EhFrame* Create(LDSection& pSection);
 
+  /// Destroy - destroy an .eh_frame. The memory is given back to the arena of
+  /// the calling thread, which ignores objects of other arenas.
   static void Destroy(EhFrame*& pSection);
 
   static void Clear();
@@ -220,12 +227,26 @@ class EhFrame {
   }
 
  private:
+  /// RelocIndex - the relocations of an input .eh_frame sorted by the offset
+  /// they apply to. A removed relocation is left as NULL.
+  typedef std::vector<std::pair<uint64_t, Relocation*> > RelocIndex;
+
+  /// CIEIndex - the output CIEs hashed by their personality and augmentation
+  /// data
+  typedef llvm::StringMap<CIE*> CIEIndex;
+
   // We needs to check if it is mergeable and check personality name
   // before merging them. The important note is we must do this after
   // ALL readSections done, that is the reason why we don't check this
   // immediately when reading.
   void setupAttributes(const LDSection* reloc_sect);
-  void removeDiscardedFDE(CIE& pCIE, const LDSection* pRelocEhFrameSect);
+  void removeDiscardedFDE(CIE& pCIE, RelocIndex& pIndex, RelocData& pRelocs);
+
+  /// findReloc - find the relocation applied to pOffset in pIndex
+  static RelocIndex::iterator findReloc(RelocIndex& pIndex, uint64_t pOffset);
+
+  /// lookUpCIE - find an output CIE that pCIE can be merged into
+  CIE* lookUpCIE(const CIE& pCIE);
 
  private:
   void removeAndUpdateCIEForFDE(EhFrame& pInFrame,
@@ -250,6 +271,12 @@ class EhFrame {
   // to the nearest CIE.
   CIEMap m_FoundCIEs;
 
+  // The first m_NumOfIndexedCIEs CIEs of m_CIEs are in m_CIEIndex. CIEs are
+  // indexed lazily, since the personality of an input CIE is known only after
+  // setupAttributes().
+  CIEIndex m_CIEIndex;
+  size_t m_NumOfIndexedCIEs;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(EhFrame);
 };
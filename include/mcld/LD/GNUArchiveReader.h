@@ -15,6 +15,8 @@
 namespace mcld {
 
 class Archive;
+class ArchiveIndexCache;
+class DynObjReader;
 class ELFObjectReader;
 class Input;
 class LinkerConfig;
@@ -25,7 +27,9 @@ class Module;
  */
 class GNUArchiveReader : public ArchiveReader {
  public:
-  GNUArchiveReader(Module& pModule, ELFObjectReader& pELFObjectReader);
+  GNUArchiveReader(Module& pModule,
+                   ELFObjectReader& pELFObjectReader,
+                   DynObjReader* pDynObjReader = NULL);
 
   ~GNUArchiveReader();
 
@@ -69,8 +73,10 @@ class GNUArchiveReader : public ArchiveReader {
 
   /// shouldIncludeSymbol - given a sym name from armap and check if we should
   /// include the corresponding archive member, and then return the decision
+  /// @param pHash - the NamePool hash value of pSymName
   enum Archive::Symbol::Status shouldIncludeSymbol(
-      const llvm::StringRef& pSymName) const;
+      const llvm::StringRef& pSymName,
+      unsigned int pHash) const;
 
   /// includeMember - include the object member in the given file offset, and
   /// return the size of the object
@@ -88,6 +94,8 @@ class GNUArchiveReader : public ArchiveReader {
  private:
   Module& m_Module;
   ELFObjectReader& m_ELFObjectReader;
+  DynObjReader* m_pDynObjReader;
+  ArchiveIndexCache* m_pIndexCache;  // --archive-index-cache
 };
 
 }  // namespace mcld
@@ -11,6 +11,7 @@
 
 #include <llvm/ADT/MapVector.h>
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,13 @@ class TargetLDBackend;
 
 /** \class IdenticalCodeFolding
  *  \brief Implementation of identical code folding for --icf=[none|all|safe]
+ *
+ *  Besides code sections, read-only data sections (SHF_ALLOC without
+ *  SHF_WRITE or SHF_EXECINSTR) are folded, unless their addresses are
+ *  significant. A section is address-significant if it defines a symbol
+ *  listed in the .llvm_addrsig table of any input. With --icf=safe, every
+ *  symbol of an input without .llvm_addrsig is taken as address-significant.
+ *
  *  @ref Safe ICF: Pointer Safe and Unwinding Aware Identical Code Folding in
  *       Gold, http://research.google.com/pubs/pub36912.html
  */
@@ -56,6 +64,8 @@ class IdenticalCodeFolding {
 
   typedef std::vector<FoldingCandidate> FoldingCandidates;
 
+  typedef std::set<const LDSection*> SectionSet;
+
  public:
   IdenticalCodeFolding(const LinkerConfig& pConfig,
                        const TargetLDBackend& pBackend,
@@ -66,6 +76,10 @@ class IdenticalCodeFolding {
  private:
   void findCandidates(FoldingCandidates& pCandidateList);
 
+  /// findAddrsigSections - collect the sections whose addresses are
+  /// significant
+  void findAddrsigSections(SectionSet& pSectionSet);
+
   bool matchCandidates(FoldingCandidates& pCandidateList);
 
  private:
@@ -11,6 +11,7 @@
 
 #include "mcld/LD/LDFileFormat.h"
 
+#include <llvm/ADT/StringMap.h>
 #include <llvm/Support/DataTypes.h>
 
 #include <cassert>
@@ -60,6 +61,8 @@ class LDContext {
   size_t numOfSections() const { return m_SectionTable.size(); }
 
   // -----  symbols  ----- //
+  size_t numOfSymbols() const { return m_SymTab.size(); }
+
   const LDSymbol* getSymbol(unsigned int pIdx) const;
   LDSymbol* getSymbol(unsigned int pIdx);
 
@@ -86,7 +89,8 @@ class LDContext {
   SymbolTable m_SymTab;
   SectionTable m_RelocSections;
 
-  // FIXME : maintain a map<section name, section index>
+  // the index of the first section with each name
+  llvm::StringMap<size_t> m_SectionIndex;
 };
 
 }  // namespace mcld
@@ -51,6 +51,8 @@ class LDSection {
                            uint64_t pSize = 0,
                            uint64_t pAddr = 0);
 
+  /// Destroy - destroy a section. The memory is given back to the arena of
+  /// the calling thread, which ignores objects of other arenas.
   static void Destroy(LDSection*& pSection);
 
   static void Clear();
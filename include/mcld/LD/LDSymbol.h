@@ -43,6 +43,8 @@ class LDSymbol {
   // -----  factory method ----- //
   static LDSymbol* Create(ResolveInfo& pResolveInfo);
 
+  /// Destroy - destroy a symbol. The memory is given back to the arena of
+  /// the calling thread, which ignores objects of other arenas.
   static void Destroy(LDSymbol*& pSymbol);
 
   /// Clear - This function tells MCLinker to clear all created LDSymbols.
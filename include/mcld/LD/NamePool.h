@@ -27,6 +27,9 @@ namespace mcld {
  *  \brief Store symbol and search symbol by name. Can help symbol resolution.
  *
  *  - MCLinker is responsed for creating NamePool.
+ *  - NamePool and the ResolveInfos it creates are not guarded. Unlike the
+ *    sections, symbols and relocations of the inputs, which are created in
+ *    per-thread arenas, symbols are resolved by one thread at a time.
  */
 class NamePool {
  public:
@@ -82,6 +85,16 @@ class NamePool {
   const ResolveInfo* findInfo(const llvm::StringRef& pName) const;
   ResolveInfo* findInfo(const llvm::StringRef& pName);
 
+  /// findInfo - find the resolved ResolveInfo by pName and its hash value
+  /// pHash, which is computed by hash() in advance
+  const ResolveInfo* findInfo(const llvm::StringRef& pName,
+                              unsigned int pHash) const;
+
+  /// hash - the hash value of pName in the pool
+  static unsigned int hash(const llvm::StringRef& pName) {
+    return Table::hasher()(pName);
+  }
+
   /// insertString - insert a string
   /// if the string has existed, modify pString to the existing string
   /// @return the StringRef points to the hash table
@@ -32,6 +32,10 @@ class LDSection;
  *  Since Relocations are created by GCFactory, we use GCFactoryListTraits for
  *the
  *  RelocationList here to avoid iplist to delete Relocations.
+ *
+ *  RelocData and Relocations are allocated in the arena of the calling
+ *  thread, so readers can build different RelocData in parallel. A RelocData
+ *  itself is not guarded; only one thread may modify it at a time.
  */
 class RelocData {
  private:
@@ -56,6 +60,8 @@ class RelocData {
  public:
   static RelocData* Create(LDSection& pSection);
 
+  /// Destroy - destroy a relocation data. The memory is given back to the arena
+  /// of the calling thread, which ignores objects of other arenas.
   static void Destroy(RelocData*& pSection);
 
   static void Clear();
@@ -35,6 +35,8 @@ class RelocationFactory
 
   void setConfig(const LinkerConfig& pConfig);
 
+  bool hasConfig() const { return (m_pConfig != NULL); }
+
   // ----- production ----- //
   /// produce - produce a relocation entry
   /// @param pType - the type of the relocation entry
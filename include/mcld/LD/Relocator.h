@@ -11,11 +11,16 @@
 
 #include "mcld/Fragment/Relocation.h"
 
+#include <vector>
+
 namespace mcld {
 
 class Input;
 class IRBuilder;
+class LDSection;
+class LDSymbol;
 class Module;
+class ResolveInfo;
 class TargetLDBackend;
 
 /** \class Relocator
@@ -28,18 +33,48 @@ class Relocator {
   typedef Relocation::DWord DWord;
   typedef Relocation::SWord SWord;
   typedef Relocation::Size Size;
+  typedef std::vector<Relocation*> RelocList;
+
+  /** \struct ScanIntent
+   *  \brief ScanIntent is what the decision pass of a split scan found a
+   *  relocation to need. The reservation pass acts on it.
+   */
+  struct ScanIntent {
+    Relocation* reloc;
+    LDSection* section;
+    uint64_t order;  // the position of the relocation in the input order
+    uint32_t flags;  // ScanIntentFlag and the target bits above them
+  };
+
+  typedef std::vector<ScanIntent> ScanIntentList;
+
+  enum ScanIntentFlag {
+    ScanReserve = 0x1,   // the entries of the relocation may be reserved
+    ScanUndefRef = 0x2,  // the relocation refers to an undefined symbol
+    ScanTarget = 0x4     // the first bit a target may use
+  };
 
  public:
   enum Result { OK, BadReloc, Overflow, Unsupported, Unknown };
 
  public:
-  explicit Relocator(const LinkerConfig& pConfig) : m_Config(pConfig) {}
+  explicit Relocator(const LinkerConfig& pConfig)
+      : m_Config(pConfig), m_pLastOutSect(NULL), m_pLastOutSectSym(NULL) {}
 
   virtual ~Relocator() = 0;
 
   /// apply - general apply function
   virtual Result applyRelocation(Relocation& pRelocation) = 0;
 
+  /// applyRelocations - apply all relocations of an input. The default
+  /// implementation applies them one by one in the given order. Targets whose
+  /// relocations do not depend on each other may reorder pRelocs and dispatch
+  /// once per relocation type.
+  virtual void applyRelocations(RelocList& pRelocs);
+
+  /// checkResult - report the result of applying pRelocation
+  void checkResult(Result pResult, const Relocation& pRelocation) const;
+
   /// scanRelocation - When read in relocations, backend can do any modification
   /// to relocation and generate empty entries, such as GOT, dynamic relocation
   /// entries and other target dependent entries. These entries are generated
@@ -48,12 +83,42 @@ class Relocator {
   /// @param pInputSym - the input LDSymbol of relocation target symbol
   /// @param pSection - the section of relocation applying target
   /// @param pInput - the input file of relocation
+  /// @note The entries are reserved as the relocations are scanned, so the
+  /// relocations must be scanned in the input order for the same GOT and PLT
+  /// slots.
   virtual void scanRelocation(Relocation& pReloc,
                               IRBuilder& pBuilder,
                               Module& pModule,
                               LDSection& pSection,
                               Input& pInput) = 0;
 
+  /// hasSplitScan - whether the target scans the relocations in two passes,
+  /// decideScan() and reserveScan(), instead of scanRelocation()
+  virtual bool hasSplitScan() const { return false; }
+
+  /// prepareScan - set up the state that decideScan() shares between the
+  /// inputs. It runs once, before any decision.
+  virtual void prepareScan(Module& pModule) {}
+
+  /// decideScan - the decision pass of a split scan. It finds out what pReloc
+  /// needs without creating any entry, and appends an intent to pIntents if
+  /// it needs anything. It only reads the IR and the state of prepareScan(),
+  /// so different threads can decide different inputs, each one into its own
+  /// list.
+  /// @param pOrder - the position of pReloc in the input order
+  virtual void decideScan(Relocation& pReloc,
+                          LDSection& pSection,
+                          uint64_t pOrder,
+                          ScanIntentList& pIntents) {}
+
+  /// reserveScan - the reservation pass of a split scan. It creates the
+  /// entries of pIntent. The intents are reserved by one thread in the input
+  /// order, so the GOT and PLT slots are the same as scanRelocation() gives.
+  virtual void reserveScan(const ScanIntent& pIntent,
+                           IRBuilder& pBuilder,
+                           Module& pModule,
+                           Input& pInput) {}
+
   /// issueUndefRefError - Provides a basic version for undefined reference
   /// dump.
   /// It will handle the filename and function name automatically.
@@ -89,6 +154,13 @@ class Relocator {
   virtual void partialScanRelocation(Relocation& pReloc,
                                      Module& pModule);
 
+  /// resetScanCache - forget the lookups cached while scanning the
+  /// relocations of the previous module
+  void resetScanCache() {
+    m_pLastOutSect = NULL;
+    m_pLastOutSectSym = NULL;
+  }
+
   // ------ observers -----//
   virtual TargetLDBackend& getTarget() = 0;
 
@@ -119,8 +191,18 @@ class Relocator {
  protected:
   const LinkerConfig& config() const { return m_Config; }
 
+  /// getOutputSectionSymbol - get the output section symbol for the input
+  /// section symbol pInputSym. The relocations of a section mostly refer to
+  /// the same few sections, so the last lookup is cached.
+  ResolveInfo* getOutputSectionSymbol(const LDSymbol& pInputSym,
+                                      Module& pModule);
+
  private:
   const LinkerConfig& m_Config;
+
+  // the cache of getOutputSectionSymbol()
+  const LDSection* m_pLastOutSect;
+  ResolveInfo* m_pLastOutSectSym;
 };
 
 }  // namespace mcld
@@ -24,6 +24,10 @@ class LDSection;
 
 /** \class SectionData
  *  \brief SectionData provides a container for all Fragments.
+ *
+ *  SectionData are allocated in the arena of the calling thread, so readers
+ *  can build different SectionData in parallel. A SectionData itself is not
+ *  guarded; only one thread may modify it at a time.
  */
 class SectionData {
  private:
@@ -47,6 +51,8 @@ class SectionData {
  public:
   static SectionData* Create(LDSection& pSection);
 
+  /// Destroy - destroy a section data. The memory is given back to the arena of
+  /// the calling thread, which ignores objects of other arenas.
   static void Destroy(SectionData*& pSection);
 
   static void Clear();
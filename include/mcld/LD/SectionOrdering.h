@@ -0,0 +1,101 @@
+//===- SectionOrdering.h --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_SECTIONORDERING_H_
+#define MCLD_LD_SECTIONORDERING_H_
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mcld {
+
+class Input;
+class LDSection;
+class LDSymbol;
+class LinkerConfig;
+class Module;
+
+/** \class SectionOrdering
+ *  \brief SectionOrdering decides which input sections are placed first in
+ *  their output sections, and in which order.
+ *
+ *  - --symbol-ordering-file=<file> lists one symbol per line. The input
+ *    sections defining the listed symbols are placed in the listed order.
+ *  - --call-graph-profile-sort=<file> lists "caller callee weight" per line.
+ *    Input sections are clustered by the C3 heuristic (Ottoni and Maher,
+ *    "Optimizing Function Placement for Large-Scale Data-Center
+ *    Applications", CGO 2017), so that hot callers are placed next to their
+ *    callees.
+ *
+ *  If both are given, the symbol ordering file wins. The input sections not
+ *  mentioned keep the input order after the ordered ones.
+ */
+class SectionOrdering {
+ public:
+  typedef std::pair<Input*, LDSection*> Entry;
+  typedef std::vector<Entry> EntryList;
+  typedef EntryList::const_iterator const_iterator;
+
+ public:
+  SectionOrdering(const LinkerConfig& pConfig, Module& pModule);
+
+  /// run - compute the order of input sections.
+  ///   @return false if the ordering file or the call graph cannot be read
+  bool run();
+
+  /// isOrdered - whether pSection is placed by this ordering
+  bool isOrdered(const LDSection& pSection) const;
+
+  const_iterator begin() const { return m_Ordered.begin(); }
+  const_iterator end() const { return m_Ordered.end(); }
+  size_t size() const { return m_Ordered.size(); }
+  bool empty() const { return m_Ordered.empty(); }
+
+ private:
+  typedef llvm::DenseMap<const LDSection*, size_t> SectionIndexMap;
+
+  /// collectCandidates - collect the input sections that can be ordered
+  void collectCandidates();
+
+  /// getSectionIndex - get the candidate index of the section defining
+  /// pSymbol, or -1 if there is no such candidate.
+  int getSectionIndex(const LDSymbol& pSymbol) const;
+
+  /// readFile - read the content of pPath into pBuffer
+  static bool readFile(const std::string& pPath,
+                       std::unique_ptr<llvm::MemoryBuffer>& pBuffer);
+
+  /// orderBySymbolFile - order sections by --symbol-ordering-file
+  bool orderBySymbolFile(const std::string& pPath);
+
+  /// orderByCallGraph - order sections by --call-graph-profile-sort
+  bool orderByCallGraph(const std::string& pPath);
+
+ private:
+  const LinkerConfig& m_Config;
+  Module& m_Module;
+
+  // all input sections which can be ordered, in the input order
+  EntryList m_Candidates;
+  SectionIndexMap m_CandidateIndex;
+
+  // the result
+  EntryList m_Ordered;
+  SectionIndexMap m_OrderedIndex;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_SECTIONORDERING_H_
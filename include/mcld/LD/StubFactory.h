@@ -26,6 +26,8 @@ class Stub;
  */
 class StubFactory {
  public:
+  StubFactory();
+
   ~StubFactory();
 
   /// addPrototype - register a stub prototype
@@ -37,6 +39,14 @@ class StubFactory {
                IRBuilder& pBuilder,
                BranchIslandFactory& pBRIslandFactory);
 
+  // -----  observers  ----- //
+  /// numOfCreatedStubs - the number of stubs cloned from the prototypes
+  size_t numOfCreatedStubs() const { return m_NumOfCreatedStubs; }
+
+  /// numOfReusedStubs - the number of times create() returned an existing
+  /// stub of an island
+  size_t numOfReusedStubs() const { return m_NumOfReusedStubs; }
+
  private:
   /// findPrototype - find if there is a registered stub prototype for the given
   ///                 relocation
@@ -49,6 +59,8 @@ class StubFactory {
 
  private:
   StubPoolType m_StubPool;  // stub pool
+  size_t m_NumOfCreatedStubs;
+  size_t m_NumOfReusedStubs;
 };
 
 }  // namespace mcld
@@ -15,6 +15,7 @@ namespace mcld {
 
 class FileHandle;
 class FileOutputBuffer;
+class IncrementalLink;
 class IRBuilder;
 class LinkerConfig;
 class LinkerScript;
@@ -75,6 +76,7 @@ class Linker {
   const Target* m_pTarget;
   TargetLDBackend* m_pBackend;
   ObjectLinker* m_pObjLinker;
+  IncrementalLink* m_pIncremental;
 };
 
 }  // namespace mcld
@@ -0,0 +1,78 @@
+//===- LinkerService.h ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LINKERSERVICE_H_
+#define MCLD_LINKERSERVICE_H_
+
+#include <string>
+
+namespace mcld {
+
+class IRBuilder;
+class LinkerConfig;
+class LinkerScript;
+class MemoryAreaFactory;
+class Module;
+
+/** \class LinkerService
+ *  \brief LinkerService runs many links in one process.
+ *
+ *  mcld::Linker is a one-shot API: all per-link IR is released by
+ *  Linker::reset(). LinkerService keeps the states that can be shared by
+ *  links alive between link requests. The memory-mapped input files are kept
+ *  in a MemoryAreaFactory owned by the service, so that the system libraries
+ *  and archives used by every link are mapped only once. A cached file is
+ *  mapped again if its size or modification time changes.
+ *
+ *  Links are run one at a time, since the diagnostic engine and the IR
+ *  factories are process-global.
+ */
+class LinkerService {
+ public:
+  /** \class Job
+   *  \brief Job describes one link request.
+   */
+  class Job {
+   public:
+    virtual ~Job() {}
+
+    /// addInputs - add the inputs to pBuilder. It is called after the target
+    /// is emulated, so the search directories are ready.
+    virtual bool addInputs(IRBuilder& pBuilder) = 0;
+  };
+
+ public:
+  LinkerService();
+
+  ~LinkerService();
+
+  /// link - emulate the target of pConfig, link the inputs of pJob and emit
+  /// the result to pOutput.
+  bool link(LinkerScript& pScript,
+            LinkerConfig& pConfig,
+            Module& pModule,
+            Job& pJob,
+            const std::string& pOutput);
+
+  /// getMemoryAreaFactory - the memory-mapped files shared by all links
+  const MemoryAreaFactory& getMemoryAreaFactory() const {
+    return *m_pMemFactory;
+  }
+  MemoryAreaFactory& getMemoryAreaFactory() { return *m_pMemFactory; }
+
+  /// numOfLinks - the number of links run by this service
+  unsigned int numOfLinks() const { return m_NumOfLinks; }
+
+ private:
+  MemoryAreaFactory* m_pMemFactory;
+  unsigned int m_NumOfLinks;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LINKERSERVICE_H_
@@ -33,6 +33,10 @@ class InputBuilder {
  public:
   explicit InputBuilder(const LinkerConfig& pConfig);
 
+  /// InputBuilder - create an InputBuilder which owns its input and context
+  /// factories, but shares the MemoryAreas of pMemoryFactory.
+  InputBuilder(const LinkerConfig& pConfig, MemoryAreaFactory& pMemoryFactory);
+
   InputBuilder(const LinkerConfig& pConfig,
                InputFactory& pInputFactory,
                ContextFactory& pContextFactory,
@@ -94,6 +98,7 @@ class InputBuilder {
   std::stack<InputTree::iterator> m_ReturnStack;
 
   bool m_bOwnFactory;
+  bool m_bOwnMemFactory;
 };
 
 //===----------------------------------------------------------------------===//
@@ -18,6 +18,9 @@
 #include "mcld/LD/SectionSymbolSet.h"
 #include "mcld/MC/SymbolCategory.h"
 
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Allocator.h>
+
 #include <vector>
 #include <string>
 
@@ -103,8 +106,15 @@ class Module {
   /// @{
 
   // -----  sections  ----- //
+  // The section table is modified only by addSection() and clearSections(),
+  // which keep the name index of getSection() in sync.
   const SectionTable& getSectionTable() const { return m_SectionTable; }
-  SectionTable& getSectionTable() { return m_SectionTable; }
+
+  /// addSection - append pSection to the section table
+  void addSection(LDSection& pSection);
+
+  /// clearSections - remove all sections from the section table
+  void clearSections();
 
   iterator begin() { return m_SectionTable.begin(); }
   const_iterator begin() const { return m_SectionTable.begin(); }
@@ -152,6 +162,12 @@ class Module {
   const NamePool& getNamePool() const { return m_NamePool; }
   NamePool& getNamePool() { return m_NamePool; }
 
+  // -----  memory  ----- //
+  /// getAllocator - the memory which lives as long as the link, such as the
+  /// uncompressed contents of the input sections and the compressed contents
+  /// of the output sections.
+  llvm::BumpPtrAllocator& getAllocator() { return m_Allocator; }
+
   // -----  Aliases  ----- //
   // create an alias list for pSym, the aliases of pSym
   // can be added into the list by calling addAlias
@@ -168,10 +184,12 @@ class Module {
   LibraryList m_LibraryList;
   InputTree m_MainTree;
   SectionTable m_SectionTable;
+  llvm::StringMap<LDSection*> m_SectionIndex;  // name -> first section
   SymbolTable m_SymbolTable;
   NamePool m_NamePool;
   SectionSymbolSet m_SectSymbolSet;
   std::vector<AliasList*> m_AliasLists;
+  llvm::BumpPtrAllocator m_Allocator;
 };
 
 }  // namespace mcld
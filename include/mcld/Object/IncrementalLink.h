@@ -0,0 +1,162 @@
+//===- IncrementalLink.h --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_OBJECT_INCREMENTALLINK_H_
+#define MCLD_OBJECT_INCREMENTALLINK_H_
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <string>
+#include <vector>
+
+namespace mcld {
+
+class FileOutputBuffer;
+class Input;
+class LDSection;
+class LinkerConfig;
+class Module;
+class RegionFragment;
+
+/** \class IncrementalLink
+ *  \brief IncrementalLink patches the output of the previous link in place
+ *  (--incremental) when only the contents of some input sections changed.
+ *
+ *  After a full link, the state of the link is written next to the output
+ *  (<output>.mcld-state): the command line, the fingerprint of the output,
+ *  and for every input file its size, modification time, inode and hashes.
+ *  For every section of a relocatable object, the state keeps the hash of
+ *  its header and of its contents, and one of
+ *    - Patchable: the section is copied to the output as it is, except for
+ *      the bytes around its relocation sites. Its output offset is kept.
+ *    - Dropped: the section is not in the output (e.g., --gc-sections).
+ *    - Fixed: anything else, e.g., symbol tables, relocation sections,
+ *      mergeable strings and .eh_frame.
+ *
+ *  The next link with the same command line checks the inputs. The output is
+ *  patched only if every change is in the contents of Patchable or Dropped
+ *  sections and keeps the bytes around every relocation site. Then the
+ *  layout, the symbols and the relocations are the same as those of the
+ *  previous link, so the new contents are written at the recorded offsets
+ *  and the relocated bytes of the previous output are kept. Any other change
+ *  falls back to a full link, which records a new state.
+ *
+ *  Only changes that keep the size of every section are patched. No slack is
+ *  reserved after the sections in the output, and no relocation is applied
+ *  again, so a section that grows or shrinks, or a relocation that changes,
+ *  always needs a full link.
+ */
+class IncrementalLink {
+ public:
+  IncrementalLink(const LinkerConfig& pConfig, const Module& pModule);
+
+  ~IncrementalLink();
+
+  /// relink - patch the output of the previous link
+  /// @return false if a full link is needed
+  bool relink();
+
+  /// isRelinked - the output is up to date after relink()
+  bool isRelinked() const { return m_bRelinked; }
+
+  /// collectRegions - record the region fragment of every input section. It
+  /// must be called before the input sections are merged.
+  void collectRegions();
+
+  /// record - record the state of the link emitted to pOutput
+  void record(FileOutputBuffer& pOutput);
+
+  /// write - write the recorded state for the output file pPath
+  /// @return false if the state cannot be written
+  bool write(const std::string& pPath) const;
+
+ private:
+  enum SectionState { Fixed, Patchable, Dropped };
+
+  enum FileFlag {
+    ELFObject = 0x1  // the file is a relocatable ELF object
+  };
+
+  struct SectionRecord {
+    uint64_t header;     // the hash of the section header except sh_offset
+    uint64_t content;    // the hash of the contents
+    uint64_t windows;    // the hash of the bytes around the relocation sites
+    uint64_t outOffset;  // the file offset in the output if Patchable
+    uint64_t size;       // the size of the section
+    uint32_t state;
+    uint32_t padding;
+  };
+
+  struct FileRecord {
+    std::string path;
+    uint64_t size;
+    uint64_t modTime;
+    uint64_t inode;
+    uint64_t hash;  // the hash of the file, or of the ELF header of an object
+    uint32_t flags;
+    std::vector<SectionRecord> sections;
+  };
+
+  typedef std::vector<FileRecord> FileList;
+
+  typedef llvm::DenseMap<const LDSection*, const RegionFragment*> RegionMap;
+
+  struct Patch;
+  struct StateHeader;
+
+ private:
+  /// collectExtraFiles - collect the files the output depends on which are
+  /// not in the input tree
+  void collectExtraFiles(std::vector<std::string>& pFiles) const;
+
+  /// tryRelink - patch the output
+  /// @return false with pReason if a full link is needed
+  bool tryRelink(std::string& pReason);
+
+  /// diffObject - compare the object pFile to its record pRecord, add the
+  /// patches of its changed sections to pPatches, and update pRecord
+  /// @return false with pReason if the object cannot be patched
+  bool diffObject(FileRecord& pRecord,
+                  llvm::StringRef pFile,
+                  std::vector<Patch>& pPatches,
+                  std::string& pReason) const;
+
+  /// getOutputOffset - get the offset in pOutput of pSection if the section
+  /// is copied to the output as a whole
+  bool getOutputOffset(const LDSection& pSection,
+                       uint64_t pSize,
+                       const FileOutputBuffer& pOutput,
+                       uint64_t& pOffset) const;
+
+  /// recordFile - fingerprint the input pPath, which is read as pObject if
+  /// it is a relocatable object
+  void recordFile(const std::string& pPath,
+                  const Input* pObject,
+                  FileOutputBuffer& pOutput);
+
+  /// readState - read the state file pState
+  /// @return false if the state is corrupt
+  bool readState(llvm::StringRef pState,
+                 StateHeader& pHeader,
+                 FileList& pFiles) const;
+
+  static std::string getStatePath(const std::string& pOutput);
+
+ private:
+  const LinkerConfig& m_Config;
+  const Module& m_Module;
+  RegionMap m_Regions;
+  FileList m_Files;
+  uint64_t m_Inputs;  // the hash of the paths of the inputs on command line
+  bool m_bRelinked;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_OBJECT_INCREMENTALLINK_H_
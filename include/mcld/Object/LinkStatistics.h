@@ -0,0 +1,105 @@
+//===- LinkStatistics.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_OBJECT_LINKSTATISTICS_H_
+#define MCLD_OBJECT_LINKSTATISTICS_H_
+#include <llvm/Support/DataTypes.h>
+
+#include <string>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}  // namespace llvm
+
+namespace mcld {
+
+class Module;
+
+/** \class LinkStatistics
+ *  \brief LinkStatistics records the cost of each ObjectLinker phase.
+ *
+ *  For every phase, LinkStatistics records the wall-clock time, the CPU time,
+ *  the peak resident set size and the size of the IR (inputs, sections,
+ *  fragments, symbols and relocations) when the phase finishes. The result
+ *  can be printed as a table (--print-stats) or written as a Chrome
+ *  trace-event file (--time-trace=<file>).
+ *
+ *  Phases may nest. Each record keeps its own start times, and only the
+ *  outermost phases are summed into the totals.
+ */
+class LinkStatistics {
+ public:
+  struct Record {
+    std::string name;
+    unsigned depth;     // the number of enclosing phases
+    uint64_t start;     // wall-clock time at the beginning (us)
+    uint64_t cpuStart;  // CPU time at the beginning (us)
+    uint64_t wallTime;  // elapsed wall-clock time (us)
+    uint64_t cpuTime;   // elapsed CPU time (us)
+    uint64_t peakRSS;   // peak resident set size at the end (bytes)
+    size_t numInputs;
+    size_t numSections;
+    size_t numFragments;
+    size_t numSymbols;
+    size_t numRelocations;
+  };
+
+  typedef std::vector<Record> RecordList;
+  typedef RecordList::const_iterator const_iterator;
+
+  /** \class Phase
+   *  \brief Phase measures a scope as a named phase. A Phase on a NULL
+   *  LinkStatistics does nothing, so callers need not check whether the
+   *  statistics are enabled.
+   */
+  class Phase {
+   public:
+    Phase(LinkStatistics* pStatistics, const char* pName);
+
+    ~Phase();
+
+   private:
+    LinkStatistics* m_pStatistics;
+  };
+
+ public:
+  explicit LinkStatistics(const Module& pModule);
+
+  /// start - begin to measure the phase pName
+  void start(const char* pName);
+
+  /// stop - finish the innermost phase that is not finished yet
+  void stop();
+
+  /// print - print all finished phases as a table
+  void print(llvm::raw_ostream& pOS) const;
+
+  /// writeTimeTrace - write all finished phases to pPath in Chrome trace-event
+  /// format.
+  ///   @return false if the file cannot be opened
+  bool writeTimeTrace(const std::string& pPath) const;
+
+  const_iterator begin() const { return m_Records.begin(); }
+  const_iterator end() const { return m_Records.end(); }
+  size_t size() const { return m_Records.size(); }
+
+ private:
+  /// count - fill the IR counters of pRecord from the module
+  void count(Record& pRecord) const;
+
+ private:
+  const Module& m_Module;
+  RecordList m_Records;
+  std::vector<size_t> m_Running;  // indexes of the unfinished records
+  uint64_t m_Origin;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_OBJECT_LINKSTATISTICS_H_
@@ -0,0 +1,86 @@
+//===- MapFile.h ----------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_OBJECT_MAPFILE_H_
+#define MCLD_OBJECT_MAPFILE_H_
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}  // namespace llvm
+
+namespace mcld {
+
+class Fragment;
+class Input;
+class LDSection;
+class LDSymbol;
+class LinkerConfig;
+class Module;
+
+/** \class MapFile
+ *  \brief MapFile writes the link map (-M, -Map=<file>) in the format of GNU
+ *  ld.
+ *
+ *  For every output section, the map lists the input sections placed in it
+ *  with their addresses, sizes and files, followed by the global symbols
+ *  defined in each input section. Fragments are spliced from the input
+ *  sections into the output sections by mergeSections(), so the first
+ *  fragment of every input section must be recorded by collectInputs()
+ *  before that.
+ *
+ *  The map is streamed to the output one section at a time; it is never held
+ *  in memory as a whole.
+ */
+class MapFile {
+ public:
+  MapFile(const LinkerConfig& pConfig, const Module& pModule);
+
+  /// collectInputs - record the first fragment of every input section. It
+  /// must be called before the input sections are merged.
+  void collectInputs();
+
+  /// print - write the link map to pOS
+  void print(llvm::raw_ostream& pOS) const;
+
+  /// write - write the link map to pPath
+  ///   @return false if the file cannot be opened
+  bool write(const std::string& pPath) const;
+
+ private:
+  typedef std::pair<const Input*, const LDSection*> InputSection;
+  typedef llvm::DenseMap<const Fragment*, InputSection> InputMap;
+
+  typedef std::vector<const LDSymbol*> SymbolList;
+  typedef llvm::DenseMap<const Fragment*, SymbolList> SymbolMap;
+
+  /// collectSymbols - bucket the global symbols by their fragments
+  void collectSymbols(SymbolMap& pSymbols) const;
+
+  /// printSection - write the map of the output section pSection to pOS
+  void printSection(const LDSection& pSection,
+                    const SymbolMap& pSymbols,
+                    llvm::raw_ostream& pOS) const;
+
+  /// printAddress - write pAddr in the width of the target address
+  void printAddress(uint64_t pAddr, llvm::raw_ostream& pOS) const;
+
+ private:
+  const LinkerConfig& m_Config;
+  const Module& m_Module;
+  InputMap m_Inputs;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_OBJECT_MAPFILE_H_
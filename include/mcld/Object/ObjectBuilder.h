@@ -10,6 +10,7 @@
 #define MCLD_OBJECT_OBJECTBUILDER_H_
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDFileFormat.h"
+#include "mcld/Object/SectionMap.h"
 
 #include <llvm/Support/DataTypes.h>
 
@@ -22,6 +23,7 @@ class Input;
 class LDSection;
 class Module;
 class SectionData;
+class SectionOrdering;
 
 /** \class ObjectBuilder
  *  \brief ObjectBuilder recieve ObjectAction and build the mcld::Module.
@@ -64,7 +66,20 @@ class ObjectBuilder {
   /// is not defined, return NULL.
   LDSection* MergeSection(const Input& pInputFile, LDSection& pInputSection);
 
+  /// SortSections - order the input sections deferred by MergeSection()
+  /// according to the SORT_BY_NAME, SORT_BY_ALIGNMENT and
+  /// SORT_BY_INIT_PRIORITY policies of pInput, and then move them into the
+  /// section data of pInput.
+  ///
+  /// The sort is stable, so sections with equal keys keep the input order.
+  /// The sections placed by pOrdering, if any, are kept in front in the
+  /// order of pOrdering, as in the descriptions without SORT_*.
+  static void SortSections(SectionMap::Input& pInput,
+                           const SectionOrdering* pOrdering = NULL);
+
   /// MoveSectionData - move the fragment of pFrom to pTo section data.
+  /// The input sections are moved one by one in the input order, so the
+  /// output is the same no matter which threads built the input sections.
   static bool MoveSectionData(SectionData& pFrom, SectionData& pTo);
 
   /// UpdateSectionAlign - update alignment for input section
@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 #ifndef MCLD_OBJECT_OBJECTLINKER_H_
 #define MCLD_OBJECT_OBJECTLINKER_H_
+#include <llvm/ADT/DenseSet.h>
 #include <llvm/Support/DataTypes.h>
 
 namespace mcld {
@@ -21,7 +22,10 @@ class ExecWriter;
 class FileOutputBuffer;
 class GroupReader;
 class IRBuilder;
+class LDSection;
+class LinkStatistics;
 class LinkerConfig;
+class MapFile;
 class Module;
 class ObjectReader;
 class ObjectWriter;
@@ -114,6 +118,12 @@ class ObjectLinker {
   /// and push_back into the relocation section
   bool relocation();
 
+  /// compressDebugSections - compress the non-allocated debug sections of
+  /// the output (--compress-debug-sections). The relocation results against
+  /// them are written into their contents first, so it must be called after
+  /// relocation().
+  bool compressDebugSections();
+
   /// finalizeSymbolValue - finalize the symbol value
   bool finalizeSymbolValue();
 
@@ -123,6 +133,15 @@ class ObjectLinker {
   /// postProcessing - do modificatiion after all processes
   bool postProcessing(FileOutputBuffer& pOutput);
 
+  /// reportStatistics - print the per-phase statistics and the stubs of the
+  /// relaxation (--print-stats) and the memory pools (--print-memory-usage),
+  /// and write the trace-event file (--time-trace)
+  void reportStatistics() const;
+
+  /// writeMapFile - print the link map (-M) and write it to the map file
+  /// (-Map=<file>)
+  void writeMapFile() const;
+
   // -----  readers and writers  ----- //
   const ObjectReader* getObjectReader() const { return m_pObjectReader; }
   ObjectReader* getObjectReader() { return m_pObjectReader; }
@@ -146,6 +165,10 @@ class ObjectLinker {
   ObjectWriter* getWriter() { return m_pWriter; }
 
  private:
+  /// splitScanRelocations - scan the relocations by the decideScan() and the
+  /// reserveScan() of the target relocator
+  bool splitScanRelocations();
+
   /// normalSyncRelocationResult - sync relocation result when producing shared
   /// objects or executables
   void normalSyncRelocationResult(FileOutputBuffer& pOutput);
@@ -158,6 +181,14 @@ class ObjectLinker {
   /// relocation target data to output
   void writeRelocationResult(Relocation& pReloc, uint8_t* pOutput);
 
+  /// writeRelocationTarget - write the relocation target data to pTarget
+  void writeRelocationTarget(Relocation& pReloc, uint8_t* pTarget);
+
+  /// writeCompressionHeader - write the ElfXX_Chdr of pSection to pOutput
+  void writeCompressionHeader(uint32_t pType,
+                              const LDSection& pSection,
+                              uint8_t* pOutput) const;
+
   /// addSymbolToOutput - add a symbol to output symbol table if it's not a
   /// section symbol and not defined in the discarded section
   void addSymbolToOutput(ResolveInfo& pInfo, Module& pModule);
@@ -177,6 +208,15 @@ class ObjectLinker {
   BinaryReader* m_pBinaryReader;
   ScriptReader* m_pScriptReader;
   ObjectWriter* m_pWriter;
+
+  // -----  per-phase statistics  ----- //
+  LinkStatistics* m_pStatistics;
+
+  // -----  link map  ----- //
+  MapFile* m_pMapFile;
+
+  // the output sections compressed by compressDebugSections()
+  llvm::DenseSet<const LDSection*> m_CompressedSections;
 };
 
 }  // namespace mcld
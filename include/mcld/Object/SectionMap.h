@@ -12,6 +12,7 @@
 #include "mcld/Script/Assignment.h"
 #include "mcld/Script/InputSectDesc.h"
 #include "mcld/Script/OutputSectDesc.h"
+#include "mcld/Script/WildcardPattern.h"
 
 #include <llvm/Support/DataTypes.h>
 
@@ -22,6 +23,7 @@ namespace mcld {
 
 class Fragment;
 class LDSection;
+class Input;
 
 /** \class SectionMap
  *  \brief descirbe how to map input sections into output sections
@@ -34,6 +36,17 @@ class SectionMap {
     typedef DotAssignments::const_iterator const_dot_iterator;
     typedef DotAssignments::iterator dot_iterator;
 
+    /// SortEntry - an input section whose merge is deferred until all input
+    /// sections matching this description are known, so that they can be
+    /// ordered by the SORT_* policy of the matched pattern.
+    struct SortEntry {
+      const mcld::Input* file;
+      LDSection* section;
+      WildcardPattern::SortPolicy policy;  // the policy of the pattern
+      size_t pattern;  // the index of the matched pattern in the description
+    };
+    typedef std::vector<SortEntry> SortList;
+
     Input(const std::string& pName, InputSectDesc::KeepPolicy pPolicy);
     explicit Input(const InputSectDesc& pInputDesc);
 
@@ -52,11 +65,26 @@ class SectionMap {
     const DotAssignments& dotAssignments() const { return m_DotAssignments; }
     DotAssignments& dotAssignments() { return m_DotAssignments; }
 
+    /// needSort - whether the file or any section pattern of this description
+    /// has a SORT_* policy.
+    bool needSort() const { return m_bNeedSort; }
+
+    /// sortFiles - whether the file pattern is wrapped in SORT_BY_NAME.
+    bool sortFiles() const;
+
+    const SortList& sortList() const { return m_SortList; }
+    SortList& sortList() { return m_SortList; }
+
+   private:
+    void initSortPolicy();
+
    private:
     InputSectDesc::KeepPolicy m_Policy;
     InputSectDesc::Spec m_Spec;
     LDSection* m_pSection;
     DotAssignments m_DotAssignments;
+    bool m_bNeedSort;
+    SortList m_SortList;
   };
 
   class Output {
@@ -191,6 +219,12 @@ class SectionMap {
 
   iterator insert(iterator pPosition, LDSection* pSection);
 
+  /// sortPolicy - the sort policy of the first section pattern in pInput that
+  /// matches pInputSection. pPattern is set to the index of the pattern.
+  WildcardPattern::SortPolicy sortPolicy(const Input& pInput,
+                                         const std::string& pInputSection,
+                                         size_t& pPattern) const;
+
   // fixupDotSymbols - ensure the dot assignments are valid
   void fixupDotSymbols();
 
@@ -10,7 +10,9 @@
 #define MCLD_SUPPORT_ALLOCATORS_H_
 #include "mcld/ADT/TypeTraits.h"
 #include "mcld/Support/Compiler.h"
+#include "mcld/Support/MemoryPool.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 
@@ -19,6 +21,9 @@ namespace mcld {
 /** \class Chunk
  *  \brief Chunk is the basic unit of the storage of the LinearAllocator
  *
+ *  size() is the capacity of the first chunk of a LinearAllocator; the later
+ *  chunks may be larger.
+ *
  *  @see LinearAllocator
  */
 template <typename DataType, size_t ChunkSize>
@@ -27,7 +32,13 @@ class Chunk {
   typedef DataType value_type;
 
  public:
-  Chunk() : next(NULL), bound(0) {}
+  explicit Chunk(size_t pCapacity)
+      : next(NULL),
+        bound(0),
+        capacity(pCapacity),
+        data(new DataType[pCapacity]) {}
+
+  ~Chunk() { delete[] data; }
 
   static size_t size() { return ChunkSize; }
 
@@ -42,7 +53,11 @@ class Chunk {
  public:
   Chunk* next;
   size_t bound;
-  DataType data[ChunkSize];
+  size_t capacity;
+  DataType* data;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(Chunk);
 };
 
 template <typename DataType>
@@ -51,9 +66,10 @@ class Chunk<DataType, 0> {
   typedef DataType value_type;
 
  public:
-  Chunk() : next(NULL), bound(0) {
-    if (m_Size != 0)
-      data = reinterpret_cast<DataType*>(malloc(sizeof(DataType) * m_Size));
+  explicit Chunk(size_t pCapacity)
+      : next(NULL), bound(0), capacity(pCapacity) {
+    if (capacity != 0)
+      data = reinterpret_cast<DataType*>(malloc(sizeof(DataType) * capacity));
     else
       data = 0;
   }
@@ -78,15 +94,27 @@ class Chunk<DataType, 0> {
  public:
   Chunk* next;
   size_t bound;
+  size_t capacity;
   DataType* data;
   static size_t m_Size;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(Chunk);
 };
 
 template <typename DataType>
 size_t Chunk<DataType, 0>::m_Size = 0;
 
+/** \class LinearAllocatorBase
+ *  \brief LinearAllocatorBase allocates objects from a list of chunks.
+ *
+ *  The first chunk holds chunk_type::size() objects. A later chunk holds a
+ *  quarter of the objects reserved so far, at most MaxChunkGrowth times the
+ *  first one, so a large pool needs few chunks while its last chunk wastes
+ *  little.
+ */
 template <typename ChunkType>
-class LinearAllocatorBase {
+class LinearAllocatorBase : public MemoryPool {
  public:
   typedef ChunkType chunk_type;
   typedef typename ChunkType::value_type value_type;
@@ -98,8 +126,17 @@ class LinearAllocatorBase {
   typedef ptrdiff_t difference_type;
   typedef unsigned char byte_type;
 
+  enum { MaxChunkGrowth = 64 };
+
  protected:
-  LinearAllocatorBase() : m_pRoot(NULL), m_pCurrent(NULL), m_AllocatedNum(0) {}
+  LinearAllocatorBase()
+      : m_pRoot(NULL),
+        m_pCurrent(NULL),
+        m_AllocatedNum(0),
+        m_NumOfChunks(0),
+        m_NumOfObjects(0),
+        m_PeakObjects(0),
+        m_PeakAllocatedNum(0) {}
 
   // LinearAllocatorBase does NOT mean to destroy the allocated memory.
   // If you want a memory allocator to release memory at destruction, please
@@ -143,12 +180,13 @@ class LinearAllocatorBase {
     if (empty())
       initialize();
 
-    size_type rest_num_elem = chunk_type::size() - m_pCurrent->bound;
+    size_type rest_num_elem = m_pCurrent->capacity - m_pCurrent->bound;
     pointer result = 0;
     if (N > rest_num_elem)
       getNewChunk();
     result = m_pCurrent->data + m_pCurrent->bound;
     m_pCurrent->bound += N;
+    addObjects(N);
     return result;
   }
 
@@ -158,10 +196,11 @@ class LinearAllocatorBase {
       initialize();
 
     pointer result = 0;
-    if (chunk_type::size() == m_pCurrent->bound)
+    if (m_pCurrent->capacity == m_pCurrent->bound)
       getNewChunk();
     result = m_pCurrent->data + m_pCurrent->bound;
     ++m_pCurrent->bound;
+    addObjects(1);
     return result;
   }
 
@@ -169,29 +208,32 @@ class LinearAllocatorBase {
   //  - if we can simply release some memory, then do it. Otherwise, do
   //    nothing.
   void deallocate(pointer& pPtr, size_type N) {
-    if (N == 0 || N > chunk_type::size() || m_pCurrent->bound == 0 ||
+    if (empty() || N == 0 || N > chunk_type::size() ||
+        m_pCurrent->bound == 0 ||
         N >= m_pCurrent->bound)
       return;
     if (!isAvailable(pPtr))
       return;
     m_pCurrent->bound -= N;
+    m_NumOfObjects -= N;
     pPtr = 0;
   }
 
   /// deallocate - clone function of deallocating one datum
   void deallocate(pointer& pPtr) {
-    if (m_pCurrent->bound == 0)
+    if (empty() || m_pCurrent->bound == 0)
       return;
     if (!isAvailable(pPtr))
       return;
     m_pCurrent->bound -= 1;
+    m_NumOfObjects -= 1;
     pPtr = 0;
   }
 
   /// isIn - whether the pPtr is in the current chunk?
   bool isIn(pointer pPtr) const {
     if (pPtr >= &(m_pCurrent->data[0]) &&
-        pPtr <= &(m_pCurrent->data[chunk_type::size() - 1]))
+        pPtr <= &(m_pCurrent->data[m_pCurrent->capacity - 1]))
       return true;
     return false;
   }
@@ -199,15 +241,18 @@ class LinearAllocatorBase {
   /// isIn - whether the pPtr is allocated, and can be constructed.
   bool isAvailable(pointer pPtr) const {
     if (pPtr >= &(m_pCurrent->data[m_pCurrent->bound]) &&
-        pPtr <= &(m_pCurrent->data[chunk_type::size() - 1]))
+        pPtr <= &(m_pCurrent->data[m_pCurrent->capacity - 1]))
       return true;
     return false;
   }
 
+  /// reset - forget all chunks. The high-water marks are kept.
   void reset() {
     m_pRoot = 0;
     m_pCurrent = 0;
     m_AllocatedNum = 0;
+    m_NumOfChunks = 0;
+    m_NumOfObjects = 0;
   }
 
   /// clear - clear all chunks
@@ -228,25 +273,58 @@ class LinearAllocatorBase {
 
   size_type max_size() const { return m_AllocatedNum; }
 
+  /// getUsage - get the usage of the chunks
+  void getUsage(Usage& pUsage) const {
+    pUsage.name = GetTypeName<value_type>();
+    pUsage.objectSize = sizeof(value_type);
+    pUsage.pools = 1;
+    pUsage.chunks = m_NumOfChunks;
+    pUsage.objects = m_NumOfObjects;
+    pUsage.peakObjects = m_PeakObjects;
+    pUsage.reservedBytes =
+        m_AllocatedNum * sizeof(value_type) + m_NumOfChunks * sizeof(chunk_type);
+    pUsage.peakReservedBytes = m_PeakAllocatedNum * sizeof(value_type);
+    pUsage.usedBytes = m_NumOfObjects * sizeof(value_type);
+  }
+
  protected:
   inline void initialize() {
-    m_pRoot = new chunk_type();
+    m_pRoot = createChunk();
     m_pCurrent = m_pRoot;
-    m_AllocatedNum += chunk_type::size();
   }
 
   inline chunk_type* getNewChunk() {
-    chunk_type* result = new chunk_type();
+    chunk_type* result = createChunk();
     m_pCurrent->next = result;
     m_pCurrent = result;
-    m_AllocatedNum += chunk_type::size();
     return result;
   }
 
+  inline chunk_type* createChunk() {
+    size_type capacity =
+        std::min(m_AllocatedNum / 4, chunk_type::size() * MaxChunkGrowth);
+    capacity = std::max(capacity, chunk_type::size());
+    ++m_NumOfChunks;
+    m_AllocatedNum += capacity;
+    if (m_AllocatedNum > m_PeakAllocatedNum)
+      m_PeakAllocatedNum = m_AllocatedNum;
+    return new chunk_type(capacity);
+  }
+
+  inline void addObjects(size_type N) {
+    m_NumOfObjects += N;
+    if (m_NumOfObjects > m_PeakObjects)
+      m_PeakObjects = m_NumOfObjects;
+  }
+
  protected:
   chunk_type* m_pRoot;
   chunk_type* m_pCurrent;
   size_type m_AllocatedNum;
+  size_type m_NumOfChunks;
+  size_type m_NumOfObjects;
+  size_type m_PeakObjects;
+  size_type m_PeakAllocatedNum;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(LinearAllocatorBase);
@@ -266,7 +344,7 @@ class LinearAllocatorBase {
  *  ordered_free().
  *
  *  template argument DataType is the DataType to be allocated
- *  template argument ChunkSize is the number of bytes of a chunk
+ *  template argument ChunkSize is the number of objects of the first chunk
  */
 template <typename DataType, size_t ChunkSize>
 class LinearAllocator
@@ -0,0 +1,43 @@
+//===- Compression.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_COMPRESSION_H_
+#define MCLD_SUPPORT_COMPRESSION_H_
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+namespace mcld {
+namespace compression {
+
+/// isAvailable - whether the compression algorithm pType (one of the
+/// ELF::ELFCOMPRESS values) is supported by this build.
+bool isAvailable(uint32_t pType);
+
+/// getName - the name of the compression algorithm pType
+const char* getName(uint32_t pType);
+
+/// compress - compress pInput with the algorithm pType
+///   @return false if the algorithm is unavailable or compression fails
+bool compress(uint32_t pType,
+              llvm::StringRef pInput,
+              llvm::SmallVectorImpl<char>& pOutput);
+
+/// uncompress - uncompress pInput with the algorithm pType. pOutput will hold
+/// exactly pSize bytes.
+///   @return false if the algorithm is unavailable or the data is corrupted
+bool uncompress(uint32_t pType,
+                llvm::StringRef pInput,
+                llvm::SmallVectorImpl<char>& pOutput,
+                size_t pSize);
+
+}  // namespace compression
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_COMPRESSION_H_
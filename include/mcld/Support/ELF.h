@@ -9,6 +9,8 @@
 #ifndef MCLD_SUPPORT_ELF_H_
 #define MCLD_SUPPORT_ELF_H_
 
+#include <llvm/Support/DataTypes.h>
+
 namespace mcld {
 namespace ELF {
 
@@ -19,9 +21,53 @@ enum SHF {
   SHF_ORDERED = 0x40000000,
 
   // Section with data that is GP relative addressable.
-  SHF_MIPS_GPREL = 0x10000000
+  SHF_MIPS_GPREL = 0x10000000,
+
+  // Section data starts with an ElfXX_Chdr and is compressed.
+  SHF_COMPRESSED = 0x800
 };  // enum SHF
 
+// Section types
+enum SHT {
+  // Packed relative relocations
+  SHT_RELR = 19,
+  // Android APS2 packed relocations
+  SHT_ANDROID_REL = 0x60000001,
+  SHT_ANDROID_RELA = 0x60000002
+};  // enum SHT
+
+// Dynamic table tags
+enum DT {
+  DT_RELRSZ = 35,   // Size of the packed relative relocation table
+  DT_RELR = 36,     // Address of the packed relative relocation table
+  DT_RELRENT = 37,  // Size of one packed relative relocation entry
+  DT_ANDROID_REL = 0x6000000F,     // Address of the APS2 packed REL table
+  DT_ANDROID_RELSZ = 0x60000010,   // Size of the APS2 packed REL table
+  DT_ANDROID_RELA = 0x60000011,    // Address of the APS2 packed RELA table
+  DT_ANDROID_RELASZ = 0x60000012   // Size of the APS2 packed RELA table
+};  // enum DT
+
+// Compression algorithms, ElfXX_Chdr::ch_type
+enum ELFCOMPRESS {
+  ELFCOMPRESS_ZLIB = 1,
+  ELFCOMPRESS_ZSTD = 2
+};  // enum ELFCOMPRESS
+
+// Compression header of 32-bit SHF_COMPRESSED sections
+struct Elf32_Chdr {
+  uint32_t ch_type;
+  uint32_t ch_size;
+  uint32_t ch_addralign;
+};
+
+// Compression header of 64-bit SHF_COMPRESSED sections
+struct Elf64_Chdr {
+  uint32_t ch_type;
+  uint32_t ch_reserved;
+  uint64_t ch_size;
+  uint64_t ch_addralign;
+};
+
 }  // namespace ELF
 }  // namespace mcld
 
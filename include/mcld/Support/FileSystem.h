@@ -16,6 +16,8 @@
 #include "mcld/Config/Config.h"
 #include "mcld/Support/PathCache.h"
 
+#include <llvm/Support/DataTypes.h>
+
 #include <iosfwd>
 #include <locale>
 #include <string>
@@ -47,15 +49,42 @@ enum FileType {
  */
 class FileStatus {
  public:
-  FileStatus() : m_Value(StatusError) {}
+  FileStatus()
+      : m_Value(StatusError),
+        m_Size(0),
+        m_ModTime(0),
+        m_ModTimeNSec(0),
+        m_Inode(0) {}
 
-  explicit FileStatus(FileType v) : m_Value(v) {}
+  explicit FileStatus(FileType v)
+      : m_Value(v), m_Size(0), m_ModTime(0), m_ModTimeNSec(0), m_Inode(0) {}
 
   void setType(FileType v) { m_Value = v; }
   FileType type() const { return m_Value; }
 
+  /// size - the size of the file in bytes
+  void setSize(uint64_t pSize) { m_Size = pSize; }
+  uint64_t size() const { return m_Size; }
+
+  /// modTime - the last modification time in seconds since the epoch
+  void setModTime(uint64_t pTime) { m_ModTime = pTime; }
+  uint64_t modTime() const { return m_ModTime; }
+
+  /// modTimeNSec - the sub-second part of the last modification time in
+  /// nanoseconds, or 0 if the host or the file system does not record it
+  void setModTimeNSec(uint32_t pNSec) { m_ModTimeNSec = pNSec; }
+  uint32_t modTimeNSec() const { return m_ModTimeNSec; }
+
+  /// inode - the inode number of the file, or 0 if the host has none
+  void setInode(uint64_t pInode) { m_Inode = pInode; }
+  uint64_t inode() const { return m_Inode; }
+
  private:
   FileType m_Value;
+  uint64_t m_Size;
+  uint64_t m_ModTime;
+  uint32_t m_ModTimeNSec;
+  uint64_t m_Inode;
 };
 
 inline bool operator==(const FileStatus& rhs, const FileStatus& lhs) {
@@ -73,6 +102,12 @@ class Directory;
 bool exists(const Path& pPath);
 bool is_directory(const Path& pPath);
 
+/// is_racy - whether the file of pStatus was modified so recently that a
+/// later change in the same clock tick may keep its size and modification
+/// time. The caller should not trust the status of a racy file to tell
+/// whether its content changed.
+bool is_racy(const FileStatus& pStatus);
+
 namespace detail {
 
 extern Path::StringType static_library_extension;
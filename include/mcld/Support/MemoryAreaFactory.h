@@ -9,6 +9,7 @@
 #ifndef MCLD_SUPPORT_MEMORYAREAFACTORY_H_
 #define MCLD_SUPPORT_MEMORYAREAFACTORY_H_
 #include "mcld/Support/FileHandle.h"
+#include "mcld/Support/FileSystem.h"
 #include "mcld/Support/GCFactory.h"
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/Path.h"
@@ -33,6 +34,15 @@ namespace mcld {
  *  file operations, MemoryAreaFactory actually open the file untill the first
  *  MemoryRegion is requested.
  *
+ *  A MemoryAreaFactory may outlive a link (@see LinkerService). A MemoryArea
+ *  of a file is reused only if the size, the modification time in
+ *  nanoseconds and the inode of the file have not changed since the
+ *  MemoryArea was created, and the file was not modified within the clock
+ *  granularity before it was mapped. Otherwise the file is mapped again into
+ *  a new MemoryArea; the old one is kept until the factory is destroyed,
+ *  since the inputs mapped earlier still refer into it. MemoryAreas of
+ *  in-memory buffers are never reused.
+ *
  *  @see MemoryRegion
  */
 class MemoryAreaFactory : public GCFactory<MemoryArea, 0> {
@@ -60,7 +70,25 @@ class MemoryAreaFactory : public GCFactory<MemoryArea, 0> {
   void destruct(MemoryArea* pArea);
 
  private:
-  llvm::StringMap<MemoryArea*> m_AreaMap;
+  struct AreaEntry {
+    /// setStatus - remember the status of the file when it is mapped
+    void setStatus(const sys::fs::FileStatus& pStatus);
+
+    /// isUnchanged - whether the file still has the remembered status
+    bool isUnchanged(const sys::fs::FileStatus& pStatus) const;
+
+    MemoryArea* area;
+    uint64_t size;
+    uint64_t modTime;
+    uint32_t modTimeNSec;
+    uint64_t inode;
+    bool racy;
+  };
+
+  typedef llvm::StringMap<AreaEntry> AreaMap;
+
+ private:
+  AreaMap m_AreaMap;
 };
 
 }  // namespace mcld
@@ -0,0 +1,90 @@
+//===- MemoryPool.h -------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_MEMORYPOOL_H_
+#define MCLD_SUPPORT_MEMORYPOOL_H_
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}  // namespace llvm
+
+namespace mcld {
+
+/** \class MemoryPool
+ *  \brief MemoryPool is the base of the chunk pools of the linker, such as
+ *  LinearAllocator and GCFactory. Every live pool is registered, so the
+ *  memory held by the IR can be inspected (--print-memory-usage).
+ */
+class MemoryPool {
+ public:
+  /// Usage - the usage of a pool, or of all pools of the same type
+  struct Usage {
+    std::string name;        // the type of the objects
+    size_t objectSize;       // sizeof an object
+    size_t pools;            // the number of pools
+    size_t chunks;           // the number of chunks
+    size_t objects;          // the live objects
+    size_t peakObjects;      // the high-water mark of the live objects
+    size_t reservedBytes;    // the bytes of the chunks
+    size_t peakReservedBytes;
+    size_t usedBytes;        // the bytes of the live objects
+
+    Usage();
+  };
+
+  typedef std::vector<Usage> UsageList;
+
+ public:
+  /// getUsage - get the usage of the pool
+  virtual void getUsage(Usage& pUsage) const = 0;
+
+  /// CollectUsage - get the usage of every live pool, summed up by the type
+  /// of the objects and sorted by the reserved bytes
+  static void CollectUsage(UsageList& pUsages);
+
+  /// PrintUsage - print the usage of every live pool
+  static void PrintUsage(llvm::raw_ostream& pOS);
+
+ protected:
+  MemoryPool();
+
+  virtual ~MemoryPool();
+
+  /// GetTypeName - the name of type T, for the reports only
+  template <typename T>
+  static std::string GetTypeName() {
+#if defined(__GNUC__)
+    // "... GetTypeName() [with T = mcld::LDSection; ...]" or, by clang,
+    // "... GetTypeName() [T = mcld::LDSection]"
+    return ParseTypeName(__PRETTY_FUNCTION__);
+#else
+    return "unknown";
+#endif
+  }
+
+ private:
+  static std::string ParseTypeName(llvm::StringRef pFunction);
+
+ private:
+  MemoryPool* m_pPrev;
+  MemoryPool* m_pNext;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(MemoryPool);
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_MEMORYPOOL_H_
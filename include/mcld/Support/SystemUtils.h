@@ -36,6 +36,18 @@ long GetRandomNum();
 /// SetRandomSeed - set the initial seed value for future calls to random().
 void SetRandomSeed(unsigned pSeed);
 
+/// GetWallClockTime - the elapsed wall-clock time in microseconds since an
+/// arbitrary, fixed point in the past.
+uint64_t GetWallClockTime();
+
+/// GetProcessCPUTime - the user plus system CPU time consumed by the current
+/// process in microseconds.
+uint64_t GetProcessCPUTime();
+
+/// GetPeakMemoryUsage - the peak resident set size of the current process in
+/// bytes. Return 0 if the host does not provide it.
+uint64_t GetPeakMemoryUsage();
+
 }  // namespace sys
 }  // namespace mcld
 
@@ -0,0 +1,115 @@
+//===- ThreadArenas.h -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_THREADARENAS_H_
+#define MCLD_SUPPORT_THREADARENAS_H_
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/Support/Compiler.h>
+#include <llvm/Support/DataTypes.h>
+#include <llvm/Support/Mutex.h>
+#include <llvm/Support/ThreadLocal.h>
+
+#include <atomic>
+#include <vector>
+
+namespace mcld {
+
+/** \class ThreadArenas
+ *  \brief ThreadArenas gives every thread its own arena, such as a GCFactory,
+ *  so that the IR can be built by several threads without locking every
+ *  allocation.
+ *
+ *  The arena of a thread is created at its first local() call and lives until
+ *  ThreadArenas is destroyed, even after the thread exits. Only the creation
+ *  of an arena takes the lock. The objects of an arena can be used by any
+ *  thread. The Destroy() of LDSection, LDSymbol, EhFrame, ELFSegment,
+ *  SectionData, RelocData and Relocation deallocates through the arena of
+ *  the calling thread, which is a no-op for an object of another arena, as
+ *  deallocate() of LinearAllocator is for any object out of its current
+ *  chunk. Such an object is released by clear().
+ *
+ *  clear() clears every arena. No thread may allocate while clear() runs.
+ *
+ *  A thread remembers the last arena it got for each ArenaType, so the
+ *  thread-local key is only looked up when it switches between
+ *  ThreadArenas of the same ArenaType.
+ */
+template <typename ArenaType>
+class ThreadArenas {
+ public:
+  typedef std::vector<ArenaType*> ArenaList;
+  typedef typename ArenaList::iterator iterator;
+  typedef typename ArenaList::const_iterator const_iterator;
+
+ public:
+  ThreadArenas() : m_Serial(++s_Serial) {}
+
+  ~ThreadArenas() {
+    iterator arena, arenaEnd = m_Arenas.end();
+    for (arena = m_Arenas.begin(); arena != arenaEnd; ++arena)
+      delete *arena;
+  }
+
+  /// local - the arena of the calling thread
+  ArenaType& local() {
+    // the serial is never reused, so a stale cache never matches
+    static LLVM_THREAD_LOCAL uint64_t t_Serial = 0;
+    static LLVM_THREAD_LOCAL ArenaType* t_Arena = NULL;
+    if (t_Serial == m_Serial)
+      return *t_Arena;
+
+    ArenaType* arena = m_Local.get();
+    if (arena == NULL) {
+      arena = new ArenaType();
+      {
+        llvm::sys::SmartScopedLock<true> guard(m_Lock);
+        m_Arenas.push_back(arena);
+      }
+      m_Local.set(arena);
+    }
+    t_Serial = m_Serial;
+    t_Arena = arena;
+    return *arena;
+  }
+
+  /// clear - clear the objects of every arena
+  void clear() {
+    llvm::sys::SmartScopedLock<true> guard(m_Lock);
+    iterator arena, arenaEnd = m_Arenas.end();
+    for (arena = m_Arenas.begin(); arena != arenaEnd; ++arena)
+      (*arena)->clear();
+  }
+
+  // -----  observers  ----- //
+  /// size - the number of arenas, i.e., the threads that have allocated
+  size_t size() const { return m_Arenas.size(); }
+
+  iterator begin() { return m_Arenas.begin(); }
+  const_iterator begin() const { return m_Arenas.begin(); }
+  iterator end() { return m_Arenas.end(); }
+  const_iterator end() const { return m_Arenas.end(); }
+
+ private:
+  static std::atomic<uint64_t> s_Serial;
+
+  llvm::sys::ThreadLocal<ArenaType> m_Local;
+  llvm::sys::SmartMutex<true> m_Lock;
+  ArenaList m_Arenas;
+  uint64_t m_Serial;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ThreadArenas);
+};
+
+template <typename ArenaType>
+std::atomic<uint64_t> ThreadArenas<ArenaType>::s_Serial(0);
+
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_THREADARENAS_H_
@@ -0,0 +1,130 @@
+//===- AndroidPackedRelocSection.h ----------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_TARGET_ANDROIDPACKEDRELOCSECTION_H_
+#define MCLD_TARGET_ANDROIDPACKEDRELOCSECTION_H_
+
+#include "mcld/Support/MemoryRegion.h"
+
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcld {
+
+class GNULDBackend;
+class LDSection;
+class Relocation;
+
+/** \class AndroidPackedRelocSection
+ *  \brief .rel.dyn or .rela.dyn packed in the Android APS2 format
+ *  (SHT_ANDROID_REL/SHT_ANDROID_RELA).
+ *
+ *  The section starts with "APS2", the number of relocations and the initial
+ *  offset, followed by groups of relocations. All numbers are SLEB128. A
+ *  group is headed by its size and flags, then the fields shared by the
+ *  group: the offset delta, the r_info, and the addend delta. Each member
+ *  carries the fields not shared. The offset and the addend are running
+ *  values; the addend resets to zero after a group without addends.
+ *
+ *  The addends of RELA relocations are computed after layout, so they are
+ *  written with a fixed width that is decided when the section is sized.
+ */
+class AndroidPackedRelocSection {
+ public:
+  AndroidPackedRelocSection(const GNULDBackend& pBackend,
+                            LDSection& pSection,
+                            unsigned int pBitClass);
+
+  ~AndroidPackedRelocSection();
+
+  /// finalizeSectionSize - size the section by the current addresses. The
+  /// section never shrinks, so that layout iterations converge.
+  ///   @param pAddrEnd - the end of the output image. The addends of
+  ///                     relative relocations are assumed to be below it.
+  ///   @param pNumDynSyms - the number of entries in .dynsym. The symbol
+  ///                        indexes are not known yet and are below it.
+  ///   @return true if the size of the section is changed
+  bool finalizeSectionSize(uint64_t pAddrEnd, size_t pNumDynSyms);
+
+  /// emit - encode the relocations to pRegion
+  void emit(MemoryRegion& pRegion) const;
+
+  const LDSection& getSection() const { return m_Section; }
+  LDSection& getSection() { return m_Section; }
+
+ private:
+  enum GroupFlags {
+    GroupedByInfo = 0x1,
+    GroupedByOffsetDelta = 0x2,
+    GroupedByAddend = 0x4,
+    GroupHasAddend = 0x8
+  };
+
+  struct Entry {
+    uint64_t offset;
+    uint64_t info;
+    uint64_t key;  // the relocations sharing r_info share the key
+    int64_t addend;
+    bool relative;
+    const Relocation* reloc;
+  };
+
+  struct EntryCompare {
+    bool operator()(const Entry& X, const Entry& Y) const;
+  };
+
+  typedef std::vector<Entry> EntryList;
+  typedef std::vector<const Entry*> Group;
+  typedef std::vector<uint8_t> Buffer;
+
+ private:
+  /// collect - collect the relocations, relative relocations first in the
+  /// order of offsets, then the others grouped by symbol and type
+  ///   @param pFinal - compose r_info with the symbol indexes in .dynsym.
+  ///                   Otherwise, r_info is composed with the largest index
+  ///                   possible, and it bounds the final encoding.
+  void collect(EntryList& pEntries, bool pFinal) const;
+
+  /// encode - encode pEntries to pOut
+  ///   @return false if an addend does not fit in its fixed width
+  bool encode(const EntryList& pEntries, Buffer& pOut) const;
+
+  void writeGroup(const Group& pGroup,
+                  uint64_t pFlags,
+                  uint64_t& pOffset,
+                  int64_t& pAddend,
+                  bool& pFit,
+                  Buffer& pOut) const;
+
+  void writeSLEB(int64_t pValue, Buffer& pOut) const;
+
+  /// writeSLEB - write pValue in exactly pWidth bytes
+  ///   @return false if pValue does not fit
+  bool writeSLEB(int64_t pValue, unsigned int pWidth, Buffer& pOut) const;
+
+  /// getDelta - pTo - pFrom, wrapped to the word size
+  int64_t getDelta(uint64_t pTo, uint64_t pFrom) const;
+
+ private:
+  const GNULDBackend& m_Backend;
+  LDSection& m_Section;
+  unsigned int m_BitClass;
+  bool m_bIsRela;
+
+  // the width of the addend deltas of relative and other relocations
+  unsigned int m_RelativeAddendWidth;
+  unsigned int m_AddendWidth;
+
+  // the number of entries in .dynsym, which bounds the symbol indexes
+  size_t m_SymIdxBound;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_TARGET_ANDROIDPACKEDRELOCSECTION_H_
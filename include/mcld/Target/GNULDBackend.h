@@ -20,9 +20,11 @@
 #include <llvm/Support/ELF.h>
 
 #include <cstdint>
+#include <vector>
 
 namespace mcld {
 
+class AndroidPackedRelocSection;
 class BranchIslandFactory;
 class EhFrameHdr;
 class ELFAttribute;
@@ -39,6 +41,7 @@ class LinkerConfig;
 class LinkerScript;
 class Module;
 class Relocation;
+class RelrSection;
 class StubFactory;
 
 /** \class GNULDBackend
@@ -140,6 +143,12 @@ class GNULDBackend : public TargetLDBackend {
   /// emitInterp - emit the .interp
   virtual void emitInterp(FileOutputBuffer& pOutput);
 
+  /// emitRelrDyn - emit the packed relative relocations of .relr.dyn
+  void emitRelrDyn(MemoryRegion& pRegion) const;
+
+  /// emitAndroidRelDyn - emit the APS2 packed .rel.dyn/.rela.dyn
+  void emitAndroidRelDyn(MemoryRegion& pRegion) const;
+
   /// hasEntryInStrTab - symbol has an entry in a .strtab
   virtual bool hasEntryInStrTab(const LDSymbol& pSym) const;
 
@@ -184,6 +193,13 @@ class GNULDBackend : public TargetLDBackend {
   /// getSymbolIdx - get the symbol index of ouput symbol table
   size_t getSymbolIdx(const LDSymbol* pSymbol) const;
 
+  /// isRelativeReloc - whether pReloc is a dynamic relocation of RELATIVE
+  /// type, which can be packed into .relr.dyn. Backends supporting
+  /// -z pack-relative-relocs should override this function.
+  virtual bool isRelativeReloc(const Relocation& pReloc) const {
+    return false;
+  }
+
   /// allocateCommonSymbols - allocate common symbols in the corresponding
   /// sections.
   /// Different concrete target backend may overlap this function.
@@ -358,6 +374,24 @@ class GNULDBackend : public TargetLDBackend {
   /// getGNUHashMaskbitslog2 - calculate the number of mask bits in log2
   unsigned getGNUHashMaskbitslog2(unsigned pNumOfSymbols) const;
 
+  /// getELFHashBucketCount - the bucket count of .hash (--hash-size)
+  unsigned getELFHashBucketCount(unsigned pNumOfSymbols) const;
+
+  /// computeGNUHashes - compute the hashes of the dynamic symbols which are
+  /// put in .gnu.hash
+  void computeGNUHashes(const Module::SymbolTable& pSymtab,
+                        std::vector<uint32_t>& pHashes) const;
+
+  /// getGNUHashBucketCount - choose the bucket count of .gnu.hash for the
+  /// symbol hashes pHashes
+  unsigned getGNUHashBucketCount(const std::vector<uint32_t>& pHashes) const;
+
+  /// printGNUHashStats - print the chain lengths of .gnu.hash. pStart is the
+  /// index of the first symbol of each bucket, followed by the number of
+  /// hashed symbols.
+  void printGNUHashStats(const std::vector<uint32_t>& pStart,
+                         uint32_t pMaskBits) const;
+
   /// emitSymbol32 - emit an ELF32 symbol
   void emitSymbol32(llvm::ELF::Elf32_Sym& pSym32,
                     LDSymbol& pSymbol,
@@ -418,6 +452,18 @@ class GNULDBackend : public TargetLDBackend {
   /// postProcessing - Backend can do any needed modification in the final stage
   void postProcessing(FileOutputBuffer& pOutput);
 
+  /// packRelativeRelocs - move the relative relocations with word-aligned
+  /// places from .rel.dyn/.rela.dyn to .relr.dyn
+  void packRelativeRelocs(Module& pModule);
+
+  /// packAndroidRelocs - pack .rel.dyn/.rela.dyn in the Android APS2 format
+  void packAndroidRelocs(Module& pModule);
+
+  /// updatePackedRelocSizes - encode .relr.dyn and the APS2 packed
+  /// .rel.dyn/.rela.dyn by the current addresses
+  ///   @return true if the size of a packed section is changed
+  bool updatePackedRelocSizes(Module& pModule);
+
   /// dynamic - the dynamic section of the target machine.
   virtual ELFDynamic& dynamic() = 0;
 
@@ -506,6 +552,7 @@ class GNULDBackend : public TargetLDBackend {
 
  protected:
   ELFObjectReader* m_pObjectReader;
+  ELFDynObjReader* m_pDynObjReader;
 
   // -----  file formats  ----- //
   ELFDynObjFileFormat* m_pDynObjFileFormat;
@@ -533,6 +580,15 @@ class GNULDBackend : public TargetLDBackend {
   // attribute section
   ELFAttribute* m_pAttribute;
 
+  // section .relr.dyn
+  RelrSection* m_pRelrDyn;
+
+  // APS2 packed .rel.dyn/.rela.dyn
+  AndroidPackedRelocSection* m_pAndroidRelDyn;
+
+  // bucket count of .gnu.hash chosen by sizeNamePools()
+  unsigned m_GNUHashBucketCount;
+
   // ----- dynamic flags ----- //
   // DF_TEXTREL of DT_FLAGS
   bool m_bHasTextRel;
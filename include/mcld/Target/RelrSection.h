@@ -0,0 +1,94 @@
+//===- RelrSection.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_TARGET_RELRSECTION_H_
+#define MCLD_TARGET_RELRSECTION_H_
+
+#include "mcld/Support/MemoryRegion.h"
+
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcld {
+
+class FileOutputBuffer;
+class LDSection;
+class Relocation;
+
+/** \class RelrSection
+ *  \brief The packed relative relocation section .relr.dyn (SHT_RELR).
+ *
+ *  RelrSection takes over the relative relocations of .rel.dyn or .rela.dyn
+ *  whose places are word-aligned, and encodes only their places. An entry
+ *  with its lowest bit clear is an address; the address word is relocated
+ *  and becomes the base of the following bitmaps. An entry with its lowest
+ *  bit set is a bitmap; bit i (i >= 1) of the bitmap relocates the word at
+ *  base + (i - 1) * word-size, and each bitmap moves the base forward by
+ *  (word-size * 8 - 1) words.
+ */
+class RelrSection {
+ public:
+  /// RelrSection
+  ///   @param pSection the .relr.dyn section
+  ///   @param pRelDyn  the .rel.dyn or .rela.dyn section whose relative
+  ///                   relocations are taken over
+  RelrSection(LDSection& pSection, LDSection& pRelDyn, unsigned int pWordSize);
+
+  ~RelrSection();
+
+  /// add - take over a relative relocation
+  void add(Relocation& pReloc);
+
+  /// giveBackUnaligned - give the relocations whose places are not
+  /// word-aligned in the current layout back to .rel.dyn/.rela.dyn. The
+  /// relocations are taken over before layout, and a later change of the
+  /// fragment offsets can misalign them.
+  ///   @return the number of relocations given back
+  size_t giveBackUnaligned();
+
+  /// finalizeSectionSize - encode the places of the relocations and size the
+  /// section. The section never shrinks, so that layout iterations converge.
+  /// All places must be word-aligned, @see giveBackUnaligned.
+  ///   @return true if the size of the section is changed
+  bool finalizeSectionSize();
+
+  /// emit - emit the encoded entries to pRegion
+  void emit(MemoryRegion& pRegion) const;
+
+  /// applyAddends - write the addends into the relocated places. The
+  /// dynamic linker adds the load base to the words in place, so the addends
+  /// of the relocations taken over from .rela.dyn must be stored there.
+  void applyAddends(FileOutputBuffer& pOutput) const;
+
+  // -----  observers  ----- //
+  bool empty() const { return m_Relocs.empty(); }
+
+  size_t numOfRelocs() const { return m_Relocs.size(); }
+
+  const LDSection& getSection() const { return m_Section; }
+  LDSection& getSection() { return m_Section; }
+
+  const LDSection& getRelDyn() const { return m_RelDyn; }
+  LDSection& getRelDyn() { return m_RelDyn; }
+
+ private:
+  typedef std::vector<Relocation*> RelocList;
+  typedef std::vector<uint64_t> EntryList;
+
+ private:
+  LDSection& m_Section;
+  LDSection& m_RelDyn;
+  unsigned int m_WordSize;
+  RelocList m_Relocs;
+  EntryList m_Entries;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_TARGET_RELRSECTION_H_
@@ -38,6 +38,7 @@ GeneralOptions::GeneralOptions()
       m_bRelro(false),
       m_bNow(false),
       m_bOrigin(false),
+      m_bPackRelativeRelocs(false),
       m_bTrace(false),
       m_Bsymbolic(false),
       m_Bgroup(false),
@@ -59,11 +60,19 @@ GeneralOptions::GeneralOptions()
       m_bPrintGCSections(false),
       m_bGenUnwindInfo(true),
       m_bPrintICFSections(false),
+      m_bPrintStats(false),
+      m_bPrintHashStats(false),
+      m_bPrintMemoryUsage(false),
+      m_bLazySharedSymbols(false),
+      m_bIncremental(false),
       m_ICF(ICF_None),
       m_ICFIterations(0),
+      m_CompressDebug(CompressDebug_None),
       m_GPSize(8),
       m_StripSymbols(KeepAllSymbols),
-      m_HashStyle(SystemV) {
+      m_HashStyle(SystemV),
+      m_HashSize(0),
+      m_PackDynRelocs(PackDynRelocs_None) {
 }
 
 GeneralOptions::~GeneralOptions() {
@@ -136,6 +145,12 @@ void GeneralOptions::addZOption(const ZOption& pOption) {
     case ZOption::Origin:
       m_bOrigin = true;
       break;
+    case ZOption::PackRelativeRelocs:
+      m_bPackRelativeRelocs = true;
+      break;
+    case ZOption::NoPackRelativeRelocs:
+      m_bPackRelativeRelocs = false;
+      break;
     case ZOption::CommPageSize:
       m_CommPageSize = pOption.pageSize();
       break;
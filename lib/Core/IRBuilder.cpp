@@ -11,6 +11,7 @@
 #include "mcld/Fragment/FragmentRef.h"
 #include "mcld/LinkerScript.h"
 #include "mcld/LD/DebugString.h"
+#include "mcld/LD/DynObjReader.h"
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/ELFReader.h"
 #include "mcld/LD/LDContext.h"
@@ -59,6 +60,9 @@ LDFileFormat::Kind GetELFSectionKind(uint32_t pType,
     return LDFileFormat::StackNote;
   if (name.startswith(".gnu.linkonce"))
     return LDFileFormat::LinkOnce;
+  // .llvm_addrsig is only read by identical code folding
+  if (name.startswith(".llvm_addrsig"))
+    return LDFileFormat::Ignore;
 
   // type rules
   switch (pType) {
@@ -109,7 +113,23 @@ LDFileFormat::Kind GetELFSectionKind(uint32_t pType,
 // IRBuilder
 //===----------------------------------------------------------------------===//
 IRBuilder::IRBuilder(Module& pModule, const LinkerConfig& pConfig)
-    : m_Module(pModule), m_Config(pConfig), m_InputBuilder(pConfig) {
+    : m_Module(pModule),
+      m_Config(pConfig),
+      m_InputBuilder(pConfig),
+      m_pDynObjReader(NULL) {
+  m_InputBuilder.setCurrentTree(m_Module.getInputTree());
+
+  // FIXME: where to set up Relocation?
+  Relocation::SetUp(m_Config);
+}
+
+IRBuilder::IRBuilder(Module& pModule,
+                     const LinkerConfig& pConfig,
+                     MemoryAreaFactory& pMemoryFactory)
+    : m_Module(pModule),
+      m_Config(pConfig),
+      m_InputBuilder(pConfig, pMemoryFactory),
+      m_pDynObjReader(NULL) {
   m_InputBuilder.setCurrentTree(m_Module.getInputTree());
 
   // FIXME: where to set up Relocation?
@@ -583,6 +603,13 @@ LDSymbol* IRBuilder::addSymbolFromDynObj(Input& pInput,
   return input_sym;
 }
 
+/// resolveLazySymbol - read the entries named pName of the lazily read
+/// dynamic objects, as if all their symbols were read
+void IRBuilder::resolveLazySymbol(const llvm::StringRef& pName) {
+  if (m_pDynObjReader != NULL)
+    m_pDynObjReader->resolveSymbol(pName);
+}
+
 /// AddRelocation - add a relocation entry
 ///
 /// All symbols should be read and resolved before calling this function.
@@ -612,6 +639,7 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::Force, IRBuilder::Unresolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  resolveLazySymbol(pName);
   ResolveInfo* info = m_Module.getNamePool().findInfo(pName);
   LDSymbol* output_sym = NULL;
   if (info == NULL) {
@@ -682,6 +710,7 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::AsReferred, IRBuilder::Unresolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  resolveLazySymbol(pName);
   ResolveInfo* info = m_Module.getNamePool().findInfo(pName);
 
   if (info == NULL || !(info->isUndef() || info->isDyn())) {
@@ -729,6 +758,7 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::Force, IRBuilder::Resolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  resolveLazySymbol(pName);
   // Result is <info, existent, override>
   Resolver::Result result;
   ResolveInfo old_info;
@@ -779,6 +809,7 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::AsReferred, IRBuilder::Resolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  resolveLazySymbol(pName);
   ResolveInfo* info = m_Module.getNamePool().findInfo(pName);
 
   if (info == NULL || !(info->isUndef() || info->isDyn())) {
@@ -13,12 +13,14 @@
 #include "mcld/Module.h"
 #include "mcld/Fragment/FragmentRef.h"
 #include "mcld/Fragment/Relocation.h"
+#include "mcld/Fragment/TargetFragment.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/ObjectWriter.h"
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/SectionData.h"
 #include "mcld/MC/InputBuilder.h"
+#include "mcld/Object/IncrementalLink.h"
 #include "mcld/Object/ObjectLinker.h"
 #include "mcld/Support/FileHandle.h"
 #include "mcld/Support/FileOutputBuffer.h"
@@ -36,7 +38,8 @@ Linker::Linker()
       m_pIRBuilder(NULL),
       m_pTarget(NULL),
       m_pBackend(NULL),
-      m_pObjLinker(NULL) {
+      m_pObjLinker(NULL),
+      m_pIncremental(NULL) {
 }
 
 Linker::~Linker() {
@@ -64,6 +67,14 @@ bool Linker::emulate(LinkerScript& pScript, LinkerConfig& pConfig) {
 }
 
 bool Linker::link(Module& pModule, IRBuilder& pBuilder) {
+  // patch the output of the previous link if only section contents changed
+  if (m_pConfig->options().incremental() &&
+      LinkerConfig::Binary != m_pConfig->codeGenType()) {
+    m_pIncremental = new IncrementalLink(*m_pConfig, pModule);
+    if (m_pIncremental->relink())
+      return true;
+  }
+
   if (!normalize(pModule, pBuilder))
     return false;
 
@@ -183,6 +194,8 @@ bool Linker::resolve(Module& pModule) {
   //   Maintain them as fragments in the section.
   //
   //   To merge nodes of the reference graph.
+  if (m_pIncremental != NULL)
+    m_pIncremental->collectRegions();
   if (!m_pObjLinker->mergeSections())
     return false;
 
@@ -234,6 +247,9 @@ bool Linker::layout() {
   // 14. - apply relocations
   m_pObjLinker->relocation();
 
+  // 14.b - compress debug sections (--compress-debug-sections)
+  m_pObjLinker->compressDebugSections();
+
   if (!Diagnose())
     return false;
   return true;
@@ -246,6 +262,16 @@ bool Linker::emit(FileOutputBuffer& pOutput) {
   // 16. - post processing
   m_pObjLinker->postProcessing(pOutput);
 
+  // 16.b - write the link map (-M, -Map)
+  m_pObjLinker->writeMapFile();
+
+  // 16.c - record the state of the link (--incremental)
+  if (m_pIncremental != NULL)
+    m_pIncremental->record(pOutput);
+
+  // 17. - report per-phase statistics (--print-stats, --time-trace)
+  m_pObjLinker->reportStatistics();
+
   if (!Diagnose())
     return false;
 
@@ -253,6 +279,10 @@ bool Linker::emit(FileOutputBuffer& pOutput) {
 }
 
 bool Linker::emit(const Module& pModule, const std::string& pPath) {
+  // the output was patched by the incremental link
+  if (m_pIncremental != NULL && m_pIncremental->isRelinked())
+    return true;
+
   FileHandle file;
   FileHandle::OpenMode open_mode(
       FileHandle::ReadWrite | FileHandle::Truncate | FileHandle::Create);
@@ -282,7 +312,11 @@ bool Linker::emit(const Module& pModule, const std::string& pPath) {
       file, m_pObjLinker->getWriter()->getOutputSize(pModule), output);
 
   result = emit(*output);
+  output.reset();
   file.close();
+
+  if (result && m_pIncremental != NULL)
+    m_pIncremental->write(pPath);
   return result;
 }
 
@@ -314,10 +348,14 @@ bool Linker::reset() {
   delete m_pObjLinker;
   m_pObjLinker = NULL;
 
+  delete m_pIncremental;
+  m_pIncremental = NULL;
+
   LDSection::Clear();
   LDSymbol::Clear();
   FragmentRef::Clear();
   Relocation::Clear();
+  TargetFragment::Clear();
   return true;
 }
 
@@ -0,0 +1,56 @@
+//===- LinkerService.cpp --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LinkerService.h"
+
+#include "mcld/Environment.h"
+#include "mcld/IRBuilder.h"
+#include "mcld/Linker.h"
+#include "mcld/LinkerConfig.h"
+#include "mcld/Module.h"
+#include "mcld/Config/Config.h"
+#include "mcld/Support/MemoryAreaFactory.h"
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// LinkerService
+//===----------------------------------------------------------------------===//
+LinkerService::LinkerService()
+    : m_pMemFactory(new MemoryAreaFactory(MCLD_NUM_OF_INPUTS)),
+      m_NumOfLinks(0) {
+  // targets, emulations and diagnostics are registered once per process
+  mcld::Initialize();
+}
+
+LinkerService::~LinkerService() {
+  delete m_pMemFactory;
+}
+
+bool LinkerService::link(LinkerScript& pScript,
+                         LinkerConfig& pConfig,
+                         Module& pModule,
+                         Job& pJob,
+                         const std::string& pOutput) {
+  ++m_NumOfLinks;
+
+  IRBuilder builder(pModule, pConfig, *m_pMemFactory);
+  Linker linker;
+  if (!linker.emulate(pScript, pConfig))
+    return false;
+
+  if (!pJob.addInputs(builder))
+    return false;
+
+  if (!linker.link(pModule, builder))
+    return false;
+
+  return linker.emit(pModule, pOutput);
+}
+
+}  // namespace mcld
@@ -34,23 +34,29 @@ Module::Module(const std::string& pName, LinkerScript& pScript)
 Module::~Module() {
 }
 
-// Following two functions will be obsolette when we have new section merger.
+void Module::addSection(LDSection& pSection) {
+  m_SectionTable.push_back(&pSection);
+  // keep the first section if there are sections with the same name
+  m_SectionIndex.insert(std::make_pair(pSection.name(), &pSection));
+}
+
+void Module::clearSections() {
+  m_SectionTable.clear();
+  m_SectionIndex.clear();
+}
+
 LDSection* Module::getSection(const std::string& pName) {
-  iterator sect, sectEnd = end();
-  for (sect = begin(); sect != sectEnd; ++sect) {
-    if ((*sect)->name() == pName)
-      return *sect;
-  }
-  return NULL;
+  llvm::StringMap<LDSection*>::iterator it = m_SectionIndex.find(pName);
+  if (it == m_SectionIndex.end())
+    return NULL;
+  return it->getValue();
 }
 
 const LDSection* Module::getSection(const std::string& pName) const {
-  const_iterator sect, sectEnd = end();
-  for (sect = begin(); sect != sectEnd; ++sect) {
-    if ((*sect)->name() == pName)
-      return *sect;
-  }
-  return NULL;
+  llvm::StringMap<LDSection*>::const_iterator it = m_SectionIndex.find(pName);
+  if (it == m_SectionIndex.end())
+    return NULL;
+  return it->getValue();
 }
 
 void Module::CreateAliasList(const ResolveInfo& pSym) {
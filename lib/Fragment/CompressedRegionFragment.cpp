@@ -0,0 +1,63 @@
+//===- CompressedRegionFragment.cpp ---------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Fragment/CompressedRegionFragment.h"
+
+#include "mcld/LD/LDSection.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Support/Compression.h"
+#include "mcld/Support/MsgHandling.h"
+
+#include <llvm/ADT/SmallVector.h>
+
+#include <cstring>
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// CompressedRegionFragment
+//===----------------------------------------------------------------------===//
+CompressedRegionFragment::CompressedRegionFragment(
+    uint32_t pType,
+    llvm::StringRef pCompressed,
+    size_t pSize,
+    llvm::BumpPtrAllocator& pAllocator,
+    const Input& pInput,
+    const LDSection& pSection,
+    SectionData* pSD)
+    : RegionFragment(pSize, pSD),
+      m_Type(pType),
+      m_Compressed(pCompressed),
+      m_Allocator(pAllocator),
+      m_Input(pInput),
+      m_Section(pSection) {
+}
+
+CompressedRegionFragment::~CompressedRegionFragment() {
+}
+
+void CompressedRegionFragment::materialize() const {
+  if (size() == 0) {
+    setRegion(llvm::StringRef());
+    return;
+  }
+
+  char* memory = static_cast<char*>(m_Allocator.Allocate(size(), 1));
+  llvm::SmallVector<char, 0> buffer;
+  if (compression::uncompress(m_Type, m_Compressed, buffer, size())) {
+    memcpy(memory, buffer.data(), size());
+  } else {
+    // keep the size, so that the layout stays valid after the error
+    error(diag::err_cannot_decompress_section) << m_Section.name()
+                                               << m_Input.path();
+    memset(memory, 0x0, size());
+  }
+  setRegion(llvm::StringRef(memory, size()));
+}
+
+}  // namespace mcld
@@ -15,6 +15,7 @@
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/SectionData.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/ThreadArenas.h"
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
@@ -26,7 +27,9 @@ namespace mcld {
 
 typedef GCFactory<FragmentRef, MCLD_SECTIONS_PER_INPUT> FragRefFactory;
 
-static llvm::ManagedStatic<FragRefFactory> g_FragRefFactory;
+/// the readers create the references of their symbols and relocations in
+/// their own arenas
+static llvm::ManagedStatic<ThreadArenas<FragRefFactory> > g_FragRefArenas;
 
 FragmentRef FragmentRef::g_NullFragmentRef;
 
@@ -67,7 +70,7 @@ FragmentRef* FragmentRef::Create(Fragment& pFrag, uint64_t pOffset) {
   if (frag == NULL)
     return Null();
 
-  FragmentRef* result = g_FragRefFactory->allocate();
+  FragmentRef* result = g_FragRefArenas->local().allocate();
   new (result) FragmentRef(*frag, offset);
 
   return result;
@@ -96,7 +99,7 @@ FragmentRef* FragmentRef::Create(LDSection& pSection, uint64_t pOffset) {
 }
 
 void FragmentRef::Clear() {
-  g_FragRefFactory->clear();
+  g_FragRefArenas->clear();
 }
 
 FragmentRef* FragmentRef::Null() {
@@ -8,20 +8,39 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Fragment/RegionFragment.h"
 
+#include <cassert>
+
 namespace mcld {
 
 //===----------------------------------------------------------------------===//
 // RegionFragment
 //===----------------------------------------------------------------------===//
 RegionFragment::RegionFragment(llvm::StringRef pRegion, SectionData* pSD)
-    : Fragment(Fragment::Region, pSD), m_Region(pRegion) {
+    : Fragment(Fragment::Region, pSD),
+      m_Region(pRegion),
+      m_Size(pRegion.size()),
+      m_bPending(false) {
+}
+
+RegionFragment::RegionFragment(size_t pSize, SectionData* pSD)
+    : Fragment(Fragment::Region, pSD), m_Size(pSize), m_bPending(true) {
 }
 
 RegionFragment::~RegionFragment() {
 }
 
 size_t RegionFragment::size() const {
-  return m_Region.size();
+  return m_Size;
+}
+
+void RegionFragment::setRegion(llvm::StringRef pRegion) const {
+  assert(pRegion.size() == m_Size && "materialized region changes the size");
+  m_Region = pRegion;
+  m_bPending = false;
+}
+
+void RegionFragment::materialize() const {
+  m_bPending = false;
 }
 
 }  // namespace mcld
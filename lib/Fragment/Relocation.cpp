@@ -14,30 +14,45 @@
 #include "mcld/LD/Relocator.h"
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/LD/SectionData.h"
-#include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/ThreadArenas.h"
 
 #include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-static llvm::ManagedStatic<RelocationFactory> g_RelocationFactory;
+static llvm::ManagedStatic<ThreadArenas<RelocationFactory> > g_RelocArenas;
+
+static const LinkerConfig* g_pRelocConfig = NULL;
+
+/// getFactory - the relocation factory of the calling thread. A factory
+/// created after SetUp() takes the config at its first use.
+static RelocationFactory& getFactory() {
+  RelocationFactory& factory = g_RelocArenas->local();
+  if (!factory.hasConfig() && g_pRelocConfig != NULL)
+    factory.setConfig(*g_pRelocConfig);
+  return factory;
+}
 
 //===----------------------------------------------------------------------===//
 // Relocation Factory Methods
 //===----------------------------------------------------------------------===//
 /// Initialize - set up the relocation factory
 void Relocation::SetUp(const LinkerConfig& pConfig) {
-  g_RelocationFactory->setConfig(pConfig);
+  g_pRelocConfig = &pConfig;
+  ThreadArenas<RelocationFactory>::iterator factory,
+      factoryEnd = g_RelocArenas->end();
+  for (factory = g_RelocArenas->begin(); factory != factoryEnd; ++factory)
+    (*factory)->setConfig(pConfig);
 }
 
 /// Clear - Clean up the relocation factory
 void Relocation::Clear() {
-  g_RelocationFactory->clear();
+  g_RelocArenas->clear();
 }
 
 /// Create - produce an empty relocation entry
 Relocation* Relocation::Create() {
-  return g_RelocationFactory->produceEmptyEntry();
+  return getFactory().produceEmptyEntry();
 }
 
 /// Create - produce a relocation entry
@@ -47,12 +62,12 @@ Relocation* Relocation::Create() {
 Relocation* Relocation::Create(Type pType,
                                FragmentRef& pFragRef,
                                Address pAddend) {
-  return g_RelocationFactory->produce(pType, pFragRef, pAddend);
+  return getFactory().produce(pType, pFragRef, pAddend);
 }
 
 /// Destroy - destroy a relocation entry
 void Relocation::Destroy(Relocation*& pRelocation) {
-  g_RelocationFactory->destroy(pRelocation);
+  getFactory().destroy(pRelocation);
   pRelocation = NULL;
 }
 
@@ -94,33 +109,7 @@ Relocation::Address Relocation::symValue() const {
 }
 
 void Relocation::apply(Relocator& pRelocator) {
-  Relocator::Result result = pRelocator.applyRelocation(*this);
-
-  switch (result) {
-    case Relocator::OK: {
-      // do nothing
-      return;
-    }
-    case Relocator::Overflow: {
-      error(diag::result_overflow) << pRelocator.getName(type())
-                                   << symInfo()->name();
-      return;
-    }
-    case Relocator::BadReloc: {
-      error(diag::result_badreloc) << pRelocator.getName(type())
-                                   << symInfo()->name();
-      return;
-    }
-    case Relocator::Unsupported: {
-      fatal(diag::unsupported_relocation) << type()
-                                          << "mclinker@googlegroups.com";
-      return;
-    }
-    case Relocator::Unknown: {
-      fatal(diag::unknown_relocation) << type() << symInfo()->name();
-      return;
-    }
-  }  // end of switch
+  pRelocator.checkResult(pRelocator.applyRelocation(*this), *this);
 }
 
 void Relocation::setType(Type pType) {
@@ -0,0 +1,30 @@
+//===- TargetFragment.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Fragment/TargetFragment.h"
+
+#include <llvm/Support/Allocator.h>
+#include <llvm/Support/ManagedStatic.h>
+
+namespace mcld {
+
+/// the slabs of all TargetFragments of the link
+static llvm::ManagedStatic<llvm::BumpPtrAllocator> g_TargetFragmentSlabs;
+
+//===----------------------------------------------------------------------===//
+// TargetFragment
+//===----------------------------------------------------------------------===//
+void* TargetFragment::operator new(size_t pSize) {
+  return g_TargetFragmentSlabs->Allocate(pSize, alignof(TargetFragment));
+}
+
+void TargetFragment::Clear() {
+  g_TargetFragmentSlabs->Reset();
+}
+
+}  // namespace mcld
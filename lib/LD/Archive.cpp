@@ -166,20 +166,28 @@ size_t Archive::numOfSymbols() const {
 /// addSymbol - add a symtab entry to symtab
 /// @param pName - symbol name
 /// @param pFileOffset - file offset in symtab represents a object file
-void Archive::addSymbol(const char* pName,
+/// @param pHash - the hash value of pName in the NamePool
+void Archive::addSymbol(const llvm::StringRef& pName,
                         uint32_t pFileOffset,
+                        unsigned int pHash,
                         enum Archive::Symbol::Status pStatus) {
   Symbol* entry = m_SymbolFactory.allocate();
-  new (entry) Symbol(pName, pFileOffset, pStatus);
+  new (entry) Symbol(pName, pFileOffset, pHash, pStatus);
   m_SymTab.push_back(entry);
 }
 
 /// getSymbolName - get the symbol name with the given index
-const std::string& Archive::getSymbolName(size_t pSymIdx) const {
+llvm::StringRef Archive::getSymbolName(size_t pSymIdx) const {
   assert(pSymIdx < numOfSymbols());
   return m_SymTab[pSymIdx]->name;
 }
 
+/// getSymbolHash - get the NamePool hash value of the symbol name
+unsigned int Archive::getSymbolHash(size_t pSymIdx) const {
+  assert(pSymIdx < numOfSymbols());
+  return m_SymTab[pSymIdx]->hash;
+}
+
 /// getObjFileOffset - get the file offset that represent a object file
 uint32_t Archive::getObjFileOffset(size_t pSymIdx) const {
   assert(pSymIdx < numOfSymbols());
@@ -0,0 +1,239 @@
+//===- ArchiveIndexCache.cpp ----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/ArchiveIndexCache.h"
+
+#include "mcld/ADT/StringHash.h"
+#include "mcld/LD/Archive.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Support/FileSystem.h"
+#include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/SystemUtils.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/ErrorOr.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+
+namespace mcld {
+
+namespace {
+
+/// The layout of an index file, in host byte order:
+///   IndexHeader
+///   the absolute path of the archive, padded to 4 bytes
+///   IndexEntry[numOfSymbols]
+///   the symbol names (namesSize bytes)
+///   the extended name table (strTabSize bytes)
+/// Bump the version in the magic when the layout or NamePool::hash() changes.
+const char IndexMagic[8] = {'M', 'C', 'L', 'D', 'A', 'I', 'X', '2'};
+
+struct IndexHeader {
+  char magic[8];
+  uint64_t size;
+  uint64_t modTime;
+  uint64_t inode;
+  uint32_t pathSize;
+  uint32_t numOfSymbols;
+  uint32_t namesSize;
+  uint32_t symTabSize;
+  uint32_t strTabSize;
+  uint32_t modTimeNSec;
+};
+
+struct IndexEntry {
+  uint32_t nameOffset;
+  uint32_t nameSize;
+  uint32_t fileOffset;
+  uint32_t hash;
+};
+
+size_t AlignPath(size_t pSize) {
+  return (pSize + 3) & ~static_cast<size_t>(3);
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// ArchiveIndexCache
+//===----------------------------------------------------------------------===//
+ArchiveIndexCache::ArchiveIndexCache(const std::string& pDir) : m_Dir(pDir) {
+}
+
+ArchiveIndexCache::~ArchiveIndexCache() {
+  IndexList::iterator index, indexEnd = m_Indexes.end();
+  for (index = m_Indexes.begin(); index != indexEnd; ++index)
+    delete *index;
+}
+
+bool ArchiveIndexCache::getKey(const Archive& pArchive,
+                               std::string& pPath,
+                               sys::fs::FileStatus& pStatus) const {
+  const Input& file = pArchive.getARFile();
+  // a nested archive is a member of the archive that holds it
+  if (file.fileOffset() != 0)
+    return false;
+
+  sys::fs::detail::status(file.path(), pStatus);
+  if (sys::fs::RegularFile != pStatus.type())
+    return false;
+
+  llvm::SmallString<256> path(file.path().native());
+  if (llvm::sys::fs::make_absolute(path))
+    return false;
+  pPath.assign(path.data(), path.size());
+  return true;
+}
+
+std::string ArchiveIndexCache::getIndexPath(const std::string& pPath) const {
+  // two 32-bit hashes make collisions unlikely; the path in the index tells
+  // a collision from a hit.
+  char name[32];
+  snprintf(name,
+           sizeof(name),
+           "%08x%08x.idx",
+           hash::StringHash<hash::DJB>()(pPath),
+           hash::StringHash<hash::FNV>()(pPath));
+  return m_Dir + "/" + name;
+}
+
+/// read - read the symtab and the strtab of pArchive from its index
+bool ArchiveIndexCache::read(Archive& pArchive) {
+  std::string path;
+  sys::fs::FileStatus status;
+  if (!getKey(pArchive, path, status))
+    return false;
+
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > buffer_or_error =
+      llvm::MemoryBuffer::getFile(getIndexPath(path),
+                                  /*FileSize*/ -1,
+                                  /*RequiresNullTerminator*/ false);
+  if (!buffer_or_error)
+    return false;
+  std::unique_ptr<llvm::MemoryBuffer> buffer =
+      std::move(buffer_or_error.get());
+
+  // check the key
+  const char* data = buffer->getBufferStart();
+  size_t size = buffer->getBufferSize();
+  if (size < sizeof(IndexHeader))
+    return false;
+  const IndexHeader* header = reinterpret_cast<const IndexHeader*>(data);
+  if (memcmp(header->magic, IndexMagic, sizeof(IndexMagic)) != 0 ||
+      header->size != status.size() || header->modTime != status.modTime() ||
+      header->modTimeNSec != status.modTimeNSec() ||
+      header->inode != status.inode() || header->pathSize != path.size())
+    return false;
+
+  uint64_t entries = sizeof(IndexHeader) + AlignPath(header->pathSize);
+  uint64_t names =
+      entries + uint64_t(header->numOfSymbols) * sizeof(IndexEntry);
+  uint64_t strtab = names + header->namesSize;
+  if (strtab + header->strTabSize != size ||
+      memcmp(data + sizeof(IndexHeader), path.data(), path.size()) != 0)
+    return false;
+
+  const IndexEntry* entry = reinterpret_cast<const IndexEntry*>(data + entries);
+  for (uint32_t i = 0; i < header->numOfSymbols; ++i) {
+    if (uint64_t(entry[i].nameOffset) + entry[i].nameSize > header->namesSize)
+      return false;
+  }
+
+  // the index is valid; the names of the symbols refer into it
+  for (uint32_t i = 0; i < header->numOfSymbols; ++i) {
+    pArchive.addSymbol(
+        llvm::StringRef(data + names + entry[i].nameOffset, entry[i].nameSize),
+        entry[i].fileOffset,
+        entry[i].hash);
+  }
+  pArchive.setSymTabSize(header->symTabSize);
+  pArchive.getStrTable().assign(data + strtab, header->strTabSize);
+
+  m_Indexes.push_back(buffer.release());
+  return true;
+}
+
+/// write - write the index of pArchive
+bool ArchiveIndexCache::write(const Archive& pArchive) const {
+  std::string path;
+  sys::fs::FileStatus status;
+  if (!getKey(pArchive, path, status))
+    return false;
+
+  // The archive may change again within the granularity of its modification
+  // time, and keep the key of this index. Leave it to a later link.
+  if (sys::fs::is_racy(status))
+    return false;
+
+  IndexHeader header;
+  memcpy(header.magic, IndexMagic, sizeof(IndexMagic));
+  header.size = status.size();
+  header.modTime = status.modTime();
+  header.modTimeNSec = status.modTimeNSec();
+  header.inode = status.inode();
+  header.pathSize = path.size();
+  header.numOfSymbols = pArchive.numOfSymbols();
+  header.namesSize = 0;
+  header.symTabSize = pArchive.getSymTabSize();
+  header.strTabSize = pArchive.getStrTable().size();
+
+  std::vector<IndexEntry> entries(pArchive.numOfSymbols());
+  for (size_t i = 0; i < pArchive.numOfSymbols(); ++i) {
+    entries[i].nameOffset = header.namesSize;
+    entries[i].nameSize = pArchive.getSymbolName(i).size();
+    entries[i].fileOffset = pArchive.getObjFileOffset(i);
+    entries[i].hash = pArchive.getSymbolHash(i);
+    header.namesSize += entries[i].nameSize;
+  }
+
+  // write to a temporary file, and then rename it to the index
+  std::string index = getIndexPath(path);
+  char suffix[32];
+  snprintf(suffix,
+           sizeof(suffix),
+           ".%lx.tmp",
+           static_cast<unsigned long>(sys::GetRandomNum()));
+  std::string temp = index + suffix;
+
+  std::error_code error = llvm::sys::fs::create_directories(m_Dir);
+  if (!error) {
+    llvm::raw_fd_ostream os(temp.c_str(), error, llvm::sys::fs::F_None);
+    if (!error) {
+      os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      os << path;
+      os.write("\0\0\0", AlignPath(path.size()) - path.size());
+      if (!entries.empty())
+        os.write(reinterpret_cast<const char*>(&entries[0]),
+                 entries.size() * sizeof(IndexEntry));
+      for (size_t i = 0; i < pArchive.numOfSymbols(); ++i)
+        os << pArchive.getSymbolName(i);
+      os << pArchive.getStrTable();
+      os.close();
+      if (os.has_error()) {
+        os.clear_error();
+        error = std::make_error_code(std::errc::io_error);
+      } else {
+        error = llvm::sys::fs::rename(temp, index);
+      }
+    }
+  }
+
+  if (error) {
+    llvm::sys::fs::remove(temp);
+    warning(diag::warn_cannot_write_archive_index) << index << error.message();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace mcld
@@ -13,8 +13,22 @@
 #include "mcld/LD/SectionData.h"
 #include "mcld/Module.h"
 
+#include <algorithm>
+#include <cassert>
+
 namespace mcld {
 
+namespace {
+
+/// IslandOffsetCompare - compare a fragment offset with the islands
+struct IslandOffsetCompare {
+  bool operator()(uint64_t pOffset, const BranchIsland* pIsland) const {
+    return pOffset < pIsland->offset();
+  }
+};
+
+}  // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // BranchIslandFactory
 //===----------------------------------------------------------------------===//
@@ -67,6 +81,9 @@ BranchIsland* BranchIslandFactory::produce(Fragment& pFragment) {
   new (island) BranchIsland(pFragment,        // entry fragment to the island
                             m_MaxIslandSize,  // the max size of the island
                             size() - 1u);     // index in the island factory
+  assert((m_Islands.empty() || m_Islands.back()->offset() <= island->offset()) &&
+         "islands must be produced in the address order");
+  m_Islands.push_back(island);
   return island;
 }
 
@@ -76,23 +93,34 @@ std::pair<BranchIsland*, BranchIsland*> BranchIslandFactory::getIslands(
     const Fragment& pFragment) {
   BranchIsland* fwd = NULL;
   BranchIsland* bwd = NULL;
-  for (iterator it = begin(), ie = end(), prev = ie; it != ie;
-       prev = it, ++it) {
-    if ((pFragment.getOffset() < (*it).offset()) &&
-        ((pFragment.getOffset() + m_MaxFwdBranchRange) >= (*it).offset())) {
-      fwd = &*it;
-
-      if (prev != ie) {
-        int64_t bwd_off = (int64_t)pFragment.getOffset() + m_MaxBwdBranchRange;
-        if ((pFragment.getOffset() > (*prev).offset()) &&
-            (bwd_off <= (int64_t)(*prev).offset())) {
-          bwd = &*prev;
-        }
-      }
-      break;
+
+  // the islands keep the address order while stubs are added, so the first
+  // island behind the fragment is found by a binary search. The islands after
+  // it are even farther away.
+  uint64_t offset = pFragment.getOffset();
+  IslandListType::iterator it = std::upper_bound(
+      m_Islands.begin(), m_Islands.end(), offset, IslandOffsetCompare());
+  if (it != m_Islands.end() &&
+      (offset + m_MaxFwdBranchRange) >= (*it)->offset()) {
+    fwd = *it;
+
+    if (it != m_Islands.begin()) {
+      BranchIsland* prev = *(it - 1);
+      int64_t bwd_off = (int64_t)offset + m_MaxBwdBranchRange;
+      if ((offset > prev->offset()) && (bwd_off <= (int64_t)prev->offset()))
+        bwd = prev;
     }
   }
   return std::make_pair(fwd, bwd);
 }
 
+/// islandSize - the total size of all islands
+size_t BranchIslandFactory::islandSize() const {
+  size_t size = 0;
+  IslandListType::const_iterator it, ie = m_Islands.end();
+  for (it = m_Islands.begin(); it != ie; ++it)
+    size += (*it)->size();
+  return size;
+}
+
 }  // namespace mcld
@@ -9,6 +9,7 @@
 #include "mcld/LD/ELFDynObjFileFormat.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/Object/ObjectBuilder.h"
+#include "mcld/Support/ELF.h"
 
 #include <llvm/Support/ELF.h>
 
@@ -57,6 +58,11 @@ void ELFDynObjFileFormat::initObjectFormat(ObjectBuilder& pBuilder,
                                      llvm::ELF::SHT_REL,
                                      llvm::ELF::SHF_ALLOC,
                                      pBitClass / 8);
+  f_pRelrDyn = pBuilder.CreateSection(".relr.dyn",
+                                      LDFileFormat::Relocation,
+                                      ELF::SHT_RELR,
+                                      llvm::ELF::SHF_ALLOC,
+                                      pBitClass / 8);
   f_pRelPlt = pBuilder.CreateSection(".rel.plt",
                                      LDFileFormat::Relocation,
                                      llvm::ELF::SHT_REL,
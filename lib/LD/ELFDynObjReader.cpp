@@ -10,34 +10,115 @@
 
 #include "mcld/IRBuilder.h"
 #include "mcld/LinkerConfig.h"
+#include "mcld/Module.h"
+#include "mcld/ADT/SizeTraits.h"
+#include "mcld/ADT/StringHash.h"
 #include "mcld/LD/ELFReader.h"
 #include "mcld/LD/LDContext.h"
+#include "mcld/LD/NamePool.h"
 #include "mcld/MC/Input.h"
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/Target/GNULDBackend.h"
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/ADT/Twine.h>
+#include <llvm/Support/ELF.h>
 #include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/Host.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <string>
 
 namespace mcld {
 
+//===----------------------------------------------------------------------===//
+// Helper functions
+//===----------------------------------------------------------------------===//
+static uint16_t ReadHalf(const char* pBuf) {
+  uint16_t half;
+  memcpy(&half, pBuf, sizeof(half));
+  if (!llvm::sys::IsLittleEndianHost)
+    half = mcld::bswap16(half);
+  return half;
+}
+
+static uint32_t ReadWord(const char* pBuf) {
+  uint32_t word;
+  memcpy(&word, pBuf, sizeof(word));
+  if (!llvm::sys::IsLittleEndianHost)
+    word = mcld::bswap32(word);
+  return word;
+}
+
+static uint64_t ReadXWord(const char* pBuf) {
+  uint64_t word;
+  memcpy(&word, pBuf, sizeof(word));
+  if (!llvm::sys::IsLittleEndianHost)
+    word = mcld::bswap64(word);
+  return word;
+}
+
+/// SymEntry - the fields of a .dynsym entry that lazy reading looks at
+struct SymEntry {
+  uint8_t info;
+  uint16_t shndx;
+  uint64_t value;
+};
+
+static SymEntry GetSymEntry(llvm::StringRef pSymTab,
+                            uint32_t pIdx,
+                            size_t pSymSize) {
+  SymEntry entry;
+  const char* sym = pSymTab.begin() + pIdx * pSymSize;
+  if (pSymSize == sizeof(llvm::ELF::Elf32_Sym)) {
+    entry.info = sym[offsetof(llvm::ELF::Elf32_Sym, st_info)];
+    entry.value = ReadWord(sym + offsetof(llvm::ELF::Elf32_Sym, st_value));
+    entry.shndx = ReadHalf(sym + offsetof(llvm::ELF::Elf32_Sym, st_shndx));
+  } else {
+    entry.info = sym[offsetof(llvm::ELF::Elf64_Sym, st_info)];
+    entry.value = ReadXWord(sym + offsetof(llvm::ELF::Elf64_Sym, st_value));
+    entry.shndx = ReadHalf(sym + offsetof(llvm::ELF::Elf64_Sym, st_shndx));
+  }
+  return entry;
+}
+
+/// IsDataObject - a defined global or weak data object, which may have weak
+/// aliases
+static bool IsDataObject(const SymEntry& pEntry) {
+  uint8_t binding = pEntry.info >> 4;
+  return (pEntry.shndx != llvm::ELF::SHN_UNDEF) &&
+         ((pEntry.info & 0xf) == llvm::ELF::STT_OBJECT) &&
+         ((binding == llvm::ELF::STB_GLOBAL) ||
+          (binding == llvm::ELF::STB_WEAK));
+}
+
 //===----------------------------------------------------------------------===//
 // ELFDynObjReader
 //===----------------------------------------------------------------------===//
 ELFDynObjReader::ELFDynObjReader(GNULDBackend& pBackend,
                                  IRBuilder& pBuilder,
                                  const LinkerConfig& pConfig)
-    : DynObjReader(), m_pELFReader(0), m_Builder(pBuilder) {
-  if (pConfig.targets().is32Bits() && pConfig.targets().isLittleEndian())
+    : DynObjReader(),
+      m_Config(pConfig),
+      m_pELFReader(0),
+      m_Builder(pBuilder),
+      m_SymSize(0) {
+  if (pConfig.targets().is32Bits() && pConfig.targets().isLittleEndian()) {
     m_pELFReader = new ELFReader<32, true>(pBackend);
-  else if (pConfig.targets().is64Bits() && pConfig.targets().isLittleEndian())
+    m_SymSize = sizeof(llvm::ELF::Elf32_Sym);
+  } else if (pConfig.targets().is64Bits() &&
+             pConfig.targets().isLittleEndian()) {
     m_pELFReader = new ELFReader<64, true>(pBackend);
+    m_SymSize = sizeof(llvm::ELF::Elf64_Sym);
+  }
 }
 
 ELFDynObjReader::~ELFDynObjReader() {
+  LazyDynObjList::iterator dyn, dynEnd = m_LazyDynObjs.end();
+  for (dyn = m_LazyDynObjs.begin(); dyn != dynEnd; ++dyn)
+    delete *dyn;
   delete m_pELFReader;
 }
 
@@ -112,10 +193,259 @@ bool ELFDynObjReader::readSymbols(Input& pInput) {
 
   llvm::StringRef strtab_region = pInput.memArea()->request(
       pInput.fileOffset() + strtab_shdr->offset(), strtab_shdr->size());
+
+  if (m_Config.options().lazySharedSymbols() &&
+      readLazily(pInput, symtab_region, strtab_region))
+    return true;
+
   const char* strtab = strtab_region.begin();
   bool result =
       m_pELFReader->readSymbols(pInput, m_Builder, symtab_region, strtab);
   return result;
 }
 
+/// readLazily - keep the tables of pInput and read its undefined entries
+bool ELFDynObjReader::readLazily(Input& pInput,
+                                 llvm::StringRef pSymTab,
+                                 llvm::StringRef pStrTab) {
+  LazyDynObj dyn;
+  dyn.input = &pInput;
+  dyn.symtab = pSymTab;
+  dyn.strtab = pStrTab;
+  dyn.hasObjects = false;
+
+  size_t num_syms = pSymTab.size() / m_SymSize;
+  size_t word_size = (m_SymSize == sizeof(llvm::ELF::Elf32_Sym)) ? 4 : 8;
+
+  // .gnu.hash - nbucket, symndx, maskwords, shift2, bloom[maskwords],
+  // buckets[nbucket] and a chain for each of the hashed entries
+  LDSection* gnu_hash = pInput.context()->getSection(".gnu.hash");
+  if (gnu_hash != NULL && gnu_hash->size() >= 16) {
+    llvm::StringRef table = pInput.memArea()->request(
+        pInput.fileOffset() + gnu_hash->offset(), gnu_hash->size());
+    uint32_t nbucket = ReadWord(table.begin());
+    uint32_t symndx = ReadWord(table.begin() + 4);
+    uint32_t maskwords = ReadWord(table.begin() + 8);
+    uint64_t size = 16 + uint64_t(maskwords) * word_size +
+                    uint64_t(nbucket) * 4 +
+                    uint64_t(num_syms > symndx ? num_syms - symndx : 0) * 4;
+    if (nbucket != 0 && maskwords != 0 && symndx != 0 && symndx <= num_syms &&
+        size <= table.size())
+      dyn.gnuHash = table;
+  }
+
+  // .hash - nbucket, nchain, buckets[nbucket] and chains[nchain]
+  LDSection* hash = pInput.context()->getSection(".hash");
+  if (dyn.gnuHash.empty() && hash != NULL && hash->size() >= 8) {
+    llvm::StringRef table = pInput.memArea()->request(
+        pInput.fileOffset() + hash->offset(), hash->size());
+    uint32_t nbucket = ReadWord(table.begin());
+    uint32_t nchain = ReadWord(table.begin() + 4);
+    uint64_t size = 8 + (uint64_t(nbucket) + nchain) * 4;
+    if (nbucket != 0 && nchain <= num_syms && size <= table.size())
+      dyn.hash = table;
+  }
+
+  if (dyn.gnuHash.empty() && dyn.hash.empty())
+    return false;
+
+  LazyDynObj* lazy = new LazyDynObj(dyn);
+  m_LazyDynObjs.push_back(lazy);
+
+  // The entries that are not hashed cannot be looked up by name. They are
+  // the undefined ones, which the output may have to export.
+  std::vector<uint32_t> entries;
+  if (!lazy->gnuHash.empty()) {
+    uint32_t symndx = ReadWord(lazy->gnuHash.begin() + 4);
+    for (uint32_t idx = 1; idx < symndx; ++idx)
+      entries.push_back(idx);
+  } else {
+    for (uint32_t idx = 1; idx < num_syms; ++idx) {
+      if (GetSymEntry(pSymTab, idx, m_SymSize).shndx == llvm::ELF::SHN_UNDEF)
+        entries.push_back(idx);
+    }
+  }
+  readEntries(*lazy, entries);
+  return true;
+}
+
+/// getSymName - the name of the entry pIdx of pDynObj
+llvm::StringRef ELFDynObjReader::getSymName(const LazyDynObj& pDynObj,
+                                            uint32_t pIdx) const {
+  // st_name is the first word of both Elf32_Sym and Elf64_Sym
+  uint32_t st_name = ReadWord(pDynObj.symtab.begin() + pIdx * m_SymSize);
+  if (st_name >= pDynObj.strtab.size())
+    return llvm::StringRef();
+  return llvm::StringRef(pDynObj.strtab.begin() + st_name);
+}
+
+/// findSymbol - collect the entries named pName of pDynObj
+void ELFDynObjReader::findSymbol(const LazyDynObj& pDynObj,
+                                 const llvm::StringRef& pName,
+                                 std::vector<uint32_t>& pEntries) const {
+  size_t num_syms = pDynObj.symtab.size() / m_SymSize;
+
+  if (!pDynObj.gnuHash.empty()) {
+    const char* table = pDynObj.gnuHash.begin();
+    uint32_t nbucket = ReadWord(table);
+    uint32_t symndx = ReadWord(table + 4);
+    uint32_t maskwords = ReadWord(table + 8);
+    uint32_t shift2 = ReadWord(table + 12);
+    size_t word_size = (m_SymSize == sizeof(llvm::ELF::Elf32_Sym)) ? 4 : 8;
+    uint32_t word_bits = word_size * 8;
+    const char* bloom = table + 16;
+    const char* buckets = bloom + maskwords * word_size;
+    const char* chains = buckets + nbucket * 4;
+
+    hash::StringHash<hash::DJB> hasher;
+    uint32_t hash = hasher(pName);
+
+    // reject most of the missing names by the bloom filter
+    const char* word_addr = bloom + ((hash / word_bits) % maskwords) * word_size;
+    uint64_t word =
+        (word_size == 4) ? ReadWord(word_addr) : ReadXWord(word_addr);
+    uint64_t mask = (UINT64_C(1) << (hash % word_bits)) |
+                    (UINT64_C(1) << ((hash >> shift2) % word_bits));
+    if ((word & mask) != mask)
+      return;
+
+    uint32_t idx = ReadWord(buckets + (hash % nbucket) * 4);
+    if (idx < symndx)
+      return;
+    for (; idx < num_syms; ++idx) {
+      uint32_t chain_hash = ReadWord(chains + (idx - symndx) * 4);
+      if ((hash | 1) == (chain_hash | 1) && getSymName(pDynObj, idx) == pName)
+        pEntries.push_back(idx);
+      if ((chain_hash & 1) != 0)
+        break;
+    }
+    return;
+  }
+
+  const char* table = pDynObj.hash.begin();
+  uint32_t nbucket = ReadWord(table);
+  uint32_t nchain = ReadWord(table + 4);
+  const char* buckets = table + 8;
+  const char* chains = buckets + nbucket * 4;
+
+  hash::StringHash<hash::ELF> hasher;
+  uint32_t idx = ReadWord(buckets + (hasher(pName) % nbucket) * 4);
+  // a broken table may have a cycle, so follow at most nchain links
+  for (uint32_t links = 0; idx != 0 && idx < nchain && links < nchain;
+       ++links) {
+    if (getSymName(pDynObj, idx) == pName)
+      pEntries.push_back(idx);
+    idx = ReadWord(chains + idx * 4);
+  }
+}
+
+/// findAliases - collect the data objects at the address of pEntry
+void ELFDynObjReader::findAliases(LazyDynObj& pDynObj,
+                                  uint32_t pEntry,
+                                  std::vector<uint32_t>& pEntries) const {
+  SymEntry entry = GetSymEntry(pDynObj.symtab, pEntry, m_SymSize);
+  if (!IsDataObject(entry))
+    return;
+
+  // The data objects are sorted once, on the first request.
+  if (!pDynObj.hasObjects) {
+    size_t num_syms = pDynObj.symtab.size() / m_SymSize;
+    for (uint32_t idx = 1; idx < num_syms; ++idx) {
+      SymEntry sym = GetSymEntry(pDynObj.symtab, idx, m_SymSize);
+      if (IsDataObject(sym))
+        pDynObj.objects.push_back(std::make_pair(sym.value, idx));
+    }
+    std::sort(pDynObj.objects.begin(), pDynObj.objects.end());
+    pDynObj.hasObjects = true;
+  }
+
+  LazyDynObj::ObjectList::const_iterator object = std::lower_bound(
+      pDynObj.objects.begin(),
+      pDynObj.objects.end(),
+      std::make_pair(entry.value, uint32_t(0)));
+  for (; object != pDynObj.objects.end() && object->first == entry.value;
+       ++object) {
+    if (object->second != pEntry)
+      pEntries.push_back(object->second);
+  }
+}
+
+/// readEntries - read the entries of pDynObj that are not read yet
+bool ELFDynObjReader::readEntries(LazyDynObj& pDynObj,
+                                  std::vector<uint32_t>& pEntries) {
+  // A data object is read together with its aliases, so that the weak alias
+  // analysis of ELFReader sees all of them.
+  size_t num_found = pEntries.size();
+  for (size_t i = 0; i < num_found; ++i)
+    findAliases(pDynObj, pEntries[i], pEntries);
+
+  std::sort(pEntries.begin(), pEntries.end());
+  pEntries.erase(std::unique(pEntries.begin(), pEntries.end()),
+                 pEntries.end());
+
+  // Copy the new entries after a null entry, in the layout of .dynsym.
+  std::vector<uint64_t> buffer(m_SymSize / sizeof(uint64_t));
+  std::vector<uint32_t>::iterator idx, idxEnd = pEntries.end();
+  for (idx = pEntries.begin(); idx != idxEnd; ++idx) {
+    if (!pDynObj.readEntries.insert(*idx).second)
+      continue;
+    const char* sym = pDynObj.symtab.begin() + (*idx) * m_SymSize;
+    buffer.insert(buffer.end(),
+                  reinterpret_cast<const uint64_t*>(sym),
+                  reinterpret_cast<const uint64_t*>(sym + m_SymSize));
+  }
+  if (buffer.size() * sizeof(uint64_t) == m_SymSize)
+    return false;
+
+  llvm::StringRef region(reinterpret_cast<const char*>(buffer.data()),
+                         buffer.size() * sizeof(uint64_t));
+  return m_pELFReader->readSymbols(
+      *pDynObj.input, m_Builder, region, pDynObj.strtab.begin());
+}
+
+/// resolveSymbol - read the entries named pName of the lazily read dynamic
+/// objects
+bool ELFDynObjReader::resolveSymbol(const llvm::StringRef& pName) {
+  if (m_LazyDynObjs.empty())
+    return false;
+
+  bool result = false;
+  size_t& looked_up = m_Lookups[pName];
+  for (; looked_up < m_LazyDynObjs.size(); ++looked_up) {
+    LazyDynObj& dyn = *m_LazyDynObjs[looked_up];
+    std::vector<uint32_t> entries;
+    findSymbol(dyn, pName, entries);
+    if (!entries.empty() && readEntries(dyn, entries))
+      result = true;
+  }
+  return result;
+}
+
+/// resolveSymbols - look up the names the output leaves unresolved in the
+/// lazily read dynamic objects
+void ELFDynObjReader::resolveSymbols() {
+  if (m_LazyDynObjs.empty())
+    return;
+
+  // A definition or a common symbol in an object is not changed by a dynamic
+  // object. Only the garbage collection asks whether it is also seen in a
+  // dynamic object.
+  bool all = m_Config.options().GCSections();
+
+  // Reading entries inserts names into the pool, so collect the names first.
+  std::vector<llvm::StringRef> names;
+  NamePool& pool = m_Builder.getModule().getNamePool();
+  NamePool::syminfo_iterator info, infoEnd = pool.syminfo_end();
+  for (info = pool.syminfo_begin(); info != infoEnd; ++info) {
+    ResolveInfo* entry = info.getEntry();
+    if (!all && !entry->isUndef())
+      continue;
+    names.push_back(llvm::StringRef(entry->name(), entry->nameSize()));
+  }
+
+  std::vector<llvm::StringRef>::iterator name, nameEnd = names.end();
+  for (name = names.begin(); name != nameEnd; ++name)
+    resolveSymbol(*name);
+}
+
 }  // namespace mcld
@@ -9,6 +9,7 @@
 #include "mcld/LD/ELFExecFileFormat.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/Object/ObjectBuilder.h"
+#include "mcld/Support/ELF.h"
 
 #include <llvm/Support/ELF.h>
 
@@ -58,6 +59,11 @@ void ELFExecFileFormat::initObjectFormat(ObjectBuilder& pBuilder,
                                      llvm::ELF::SHT_REL,
                                      llvm::ELF::SHF_ALLOC,
                                      pBitClass / 8);
+  f_pRelrDyn = pBuilder.CreateSection(".relr.dyn",
+                                      LDFileFormat::Relocation,
+                                      ELF::SHT_RELR,
+                                      llvm::ELF::SHF_ALLOC,
+                                      pBitClass / 8);
   f_pRelPlt = pBuilder.CreateSection(".rel.plt",
                                      LDFileFormat::Relocation,
                                      llvm::ELF::SHT_REL,
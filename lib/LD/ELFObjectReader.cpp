@@ -163,7 +163,7 @@ bool ELFObjectReader::readSections(Input& pInput) {
               (*section)->setKind(LDFileFormat::Ignore);
             else {
               SectionData* sd = IRBuilder::CreateSectionData(**section);
-              if (!m_pELFReader->readRegularSection(pInput, *sd))
+              if (!m_pELFReader->readRegularSection(pInput, *sd, m_Builder))
                 fatal(diag::err_cannot_read_section) << (*section)->name();
             }
           } else {
@@ -172,7 +172,7 @@ bool ELFObjectReader::readSections(Input& pInput) {
             else
               (*section)->setKind(LDFileFormat::DATA);
             SectionData* sd = IRBuilder::CreateSectionData(**section);
-            if (!m_pELFReader->readRegularSection(pInput, *sd))
+            if (!m_pELFReader->readRegularSection(pInput, *sd, m_Builder))
               fatal(diag::err_cannot_read_section) << (*section)->name();
           }
         } else {
@@ -204,7 +204,7 @@ bool ELFObjectReader::readSections(Input& pInput) {
       case LDFileFormat::Note:
       case LDFileFormat::MetaData: {
         SectionData* sd = IRBuilder::CreateSectionData(**section);
-        if (!m_pELFReader->readRegularSection(pInput, *sd))
+        if (!m_pELFReader->readRegularSection(pInput, *sd, m_Builder))
           fatal(diag::err_cannot_read_section) << (*section)->name();
         break;
       }
@@ -214,7 +214,7 @@ bool ELFObjectReader::readSections(Input& pInput) {
           (*section)->setKind(LDFileFormat::Ignore);
         } else {
           SectionData* sd = IRBuilder::CreateSectionData(**section);
-          if (!m_pELFReader->readRegularSection(pInput, *sd)) {
+          if (!m_pELFReader->readRegularSection(pInput, *sd, m_Builder)) {
             fatal(diag::err_cannot_read_section) << (*section)->name();
           }
         }
@@ -233,7 +233,8 @@ bool ELFObjectReader::readSections(Input& pInput) {
           }
         } else {
           if (!m_pELFReader->readRegularSection(pInput,
-                                                *eh_frame->getSectionData())) {
+                                                *eh_frame->getSectionData(),
+                                                m_Builder)) {
             fatal(diag::err_cannot_read_section) << (*section)->name();
           }
         }
@@ -26,6 +26,7 @@
 #include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/Support/ELF.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Target/GNUInfo.h"
 #include "mcld/Target/GNULDBackend.h"
@@ -448,6 +449,19 @@ void ELFObjectWriter::emitEhFrame(Module& pModule,
 void ELFObjectWriter::emitRelocation(const LinkerConfig& pConfig,
                                      const LDSection& pSection,
                                      MemoryRegion& pRegion) const {
+  // .relr.dyn is encoded by the backend
+  if (pSection.type() == ELF::SHT_RELR) {
+    target().emitRelrDyn(pRegion);
+    return;
+  }
+
+  // so is the APS2 packed .rel.dyn/.rela.dyn
+  if (pSection.type() == ELF::SHT_ANDROID_REL ||
+      pSection.type() == ELF::SHT_ANDROID_RELA) {
+    target().emitAndroidRelDyn(pRegion);
+    return;
+  }
+
   const RelocData* sect_data = pSection.getRelocData();
   assert(sect_data != NULL && "SectionData is NULL in emitRelocation!");
 
@@ -487,6 +501,14 @@ void ELFObjectWriter::emitRel(const LinkerConfig& pConfig,
   const Relocation* relocation = 0;
   const FragmentRef* frag_ref = 0;
 
+  bool use_addr = (LinkerConfig::DynObj == pConfig.codeGenType() ||
+                   LinkerConfig::Exec == pConfig.codeGenType());
+
+  // consecutive relocations often refer to the same symbol, especially to
+  // the section symbols of a partial link, so keep the last index
+  const LDSymbol* last_sym = NULL;
+  ElfXX_Word last_sym_idx = 0;
+
   for (RelocData::const_iterator it = pRelocData.begin(), ie = pRelocData.end();
        it != ie;
        ++it, ++rel) {
@@ -496,8 +518,7 @@ void ELFObjectWriter::emitRel(const LinkerConfig& pConfig,
     relocation = &(llvm::cast<Relocation>(*it));
     frag_ref = &(relocation->targetRef());
 
-    if (LinkerConfig::DynObj == pConfig.codeGenType() ||
-        LinkerConfig::Exec == pConfig.codeGenType()) {
+    if (use_addr) {
       r_offset = static_cast<ElfXX_Addr>(
           frag_ref->frag()->getParent()->getSection().addr() +
           frag_ref->getOutputOffset());
@@ -505,11 +526,14 @@ void ELFObjectWriter::emitRel(const LinkerConfig& pConfig,
       r_offset = static_cast<ElfXX_Addr>(frag_ref->getOutputOffset());
     }
 
-    if (relocation->symInfo() == NULL)
-      r_sym = 0;
-    else
-      r_sym = static_cast<ElfXX_Word>(
-          target().getSymbolIdx(relocation->symInfo()->outSymbol()));
+    if (relocation->symInfo() != NULL) {
+      const LDSymbol* sym = relocation->symInfo()->outSymbol();
+      if (sym != last_sym) {
+        last_sym = sym;
+        last_sym_idx = static_cast<ElfXX_Word>(target().getSymbolIdx(sym));
+      }
+      r_sym = last_sym_idx;
+    }
 
     target().emitRelocation(*rel, relocation->type(), r_sym, r_offset);
   }
@@ -529,6 +553,13 @@ void ELFObjectWriter::emitRela(const LinkerConfig& pConfig,
   const Relocation* relocation = 0;
   const FragmentRef* frag_ref = 0;
 
+  bool use_addr = (LinkerConfig::DynObj == pConfig.codeGenType() ||
+                   LinkerConfig::Exec == pConfig.codeGenType());
+
+  // the index of the last symbol, as in emitRel
+  const LDSymbol* last_sym = NULL;
+  ElfXX_Word last_sym_idx = 0;
+
   for (RelocData::const_iterator it = pRelocData.begin(), ie = pRelocData.end();
        it != ie;
        ++it, ++rel) {
@@ -538,8 +569,7 @@ void ELFObjectWriter::emitRela(const LinkerConfig& pConfig,
     relocation = &(llvm::cast<Relocation>(*it));
     frag_ref = &(relocation->targetRef());
 
-    if (LinkerConfig::DynObj == pConfig.codeGenType() ||
-        LinkerConfig::Exec == pConfig.codeGenType()) {
+    if (use_addr) {
       r_offset = static_cast<ElfXX_Addr>(
           frag_ref->frag()->getParent()->getSection().addr() +
           frag_ref->getOutputOffset());
@@ -547,11 +577,14 @@ void ELFObjectWriter::emitRela(const LinkerConfig& pConfig,
       r_offset = static_cast<ElfXX_Addr>(frag_ref->getOutputOffset());
     }
 
-    if (relocation->symInfo() == NULL)
-      r_sym = 0;
-    else
-      r_sym = static_cast<ElfXX_Word>(
-          target().getSymbolIdx(relocation->symInfo()->outSymbol()));
+    if (relocation->symInfo() != NULL) {
+      const LDSymbol* sym = relocation->symInfo()->outSymbol();
+      if (sym != last_sym) {
+        last_sym = sym;
+        last_sym_idx = static_cast<ElfXX_Word>(target().getSymbolIdx(sym));
+      }
+      r_sym = last_sym_idx;
+    }
 
     target().emitRelocation(
         *rel, relocation->type(), r_sym, r_offset, relocation->addend());
@@ -562,6 +595,7 @@ void ELFObjectWriter::emitRela(const LinkerConfig& pConfig,
 template <size_t SIZE>
 uint64_t ELFObjectWriter::getSectEntrySize(const LDSection& pSection) const {
   typedef typename ELFSizeTraits<SIZE>::Word ElfXX_Word;
+  typedef typename ELFSizeTraits<SIZE>::Addr ElfXX_Addr;
   typedef typename ELFSizeTraits<SIZE>::Sym ElfXX_Sym;
   typedef typename ELFSizeTraits<SIZE>::Rel ElfXX_Rel;
   typedef typename ELFSizeTraits<SIZE>::Rela ElfXX_Rela;
@@ -574,6 +608,11 @@ uint64_t ELFObjectWriter::getSectEntrySize(const LDSection& pSection) const {
     return sizeof(ElfXX_Rel);
   if (llvm::ELF::SHT_RELA == pSection.type())
     return sizeof(ElfXX_Rela);
+  if (ELF::SHT_RELR == pSection.type())
+    return sizeof(ElfXX_Addr);
+  if (ELF::SHT_ANDROID_REL == pSection.type() ||
+      ELF::SHT_ANDROID_RELA == pSection.type())
+    return 0x1;
   if (llvm::ELF::SHT_HASH == pSection.type() ||
       llvm::ELF::SHT_GNU_HASH == pSection.type())
     return sizeof(ElfXX_Word);
@@ -600,6 +639,9 @@ uint64_t ELFObjectWriter::getSectLink(const LDSection& pSection,
   if (llvm::ELF::SHT_HASH == pSection.type() ||
       llvm::ELF::SHT_GNU_HASH == pSection.type())
     return target().getOutputFormat()->getDynSymTab().index();
+  if (ELF::SHT_ANDROID_REL == pSection.type() ||
+      ELF::SHT_ANDROID_RELA == pSection.type())
+    return target().getOutputFormat()->getDynSymTab().index();
   if (llvm::ELF::SHT_REL == pSection.type() ||
       llvm::ELF::SHT_RELA == pSection.type()) {
     if (LinkerConfig::Object == pConfig.codeGenType())
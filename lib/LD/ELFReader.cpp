@@ -9,11 +9,16 @@
 #include "mcld/LD/ELFReader.h"
 
 #include "mcld/IRBuilder.h"
+#include "mcld/Module.h"
+#include "mcld/Fragment/CompressedRegionFragment.h"
 #include "mcld/Fragment/FillFragment.h"
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDContext.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/MC/Input.h"
 #include "mcld/Object/ObjectBuilder.h"
+#include "mcld/Support/Compression.h"
+#include "mcld/Support/ELF.h"
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Target/GNUInfo.h"
@@ -26,10 +31,75 @@
 
 #include <iostream>
 
+#include <cstdlib>
 #include <cstring>
 
 namespace mcld {
 
+//===----------------------------------------------------------------------===//
+// Helper functions
+//===----------------------------------------------------------------------===//
+/// GetSectionName - get the name of an input section. GNU compressed
+/// .zdebug_* sections are renamed to .debug_* and marked SHF_COMPRESSED.
+static std::string GetSectionName(const char* pName, uint64_t& pFlags) {
+  llvm::StringRef name(pName);
+  if (!name.startswith(".zdebug"))
+    return name.str();
+  pFlags |= ELF::SHF_COMPRESSED;
+  return ".debug" + name.drop_front(7).str();
+}
+
+/// ReadCompressedSection - append the compressed pRegion of pSize bytes to
+/// pSD. The content is uncompressed into the memory of the link at the first
+/// use. The section is no longer SHF_COMPRESSED afterward.
+static bool ReadCompressedSection(Input& pInput,
+                                  SectionData& pSD,
+                                  IRBuilder& pBuilder,
+                                  uint32_t pType,
+                                  llvm::StringRef pRegion,
+                                  uint64_t pSize,
+                                  uint64_t pAlign) {
+  LDSection& section = pSD.getSection();
+  if (!compression::isAvailable(pType)) {
+    error(diag::err_cannot_decompress_section) << section.name()
+                                               << pInput.path();
+    return false;
+  }
+
+  section.setFlag(section.flag() & ~ELF::SHF_COMPRESSED);
+  section.setSize(pSize);
+  section.setAlign(pAlign);
+  Fragment* frag = new CompressedRegionFragment(
+      pType, pRegion, pSize, pBuilder.getModule().getAllocator(), pInput,
+      section);
+  ObjectBuilder::AppendFragment(*frag, pSD);
+  return true;
+}
+
+/// ReadGNUCompressedSection - read a .zdebug_* section. Its content is "ZLIB"
+/// followed by the big-endian 64-bit uncompressed size and a zlib stream.
+static bool ReadGNUCompressedSection(Input& pInput,
+                                     SectionData& pSD,
+                                     IRBuilder& pBuilder,
+                                     llvm::StringRef pRegion) {
+  if (pRegion.size() < 12) {
+    error(diag::err_cannot_decompress_section) << pSD.getSection().name()
+                                               << pInput.path();
+    return false;
+  }
+
+  uint64_t size = 0x0;
+  for (size_t i = 4; i < 12; ++i)
+    size = (size << 8) | static_cast<uint8_t>(pRegion[i]);
+  return ReadCompressedSection(pInput,
+                               pSD,
+                               pBuilder,
+                               ELF::ELFCOMPRESS_ZLIB,
+                               pRegion.drop_front(12),
+                               size,
+                               pSD.getSection().align());
+}
+
 //===----------------------------------------------------------------------===//
 // ELFReader<32, true>
 //===----------------------------------------------------------------------===//
@@ -52,10 +122,40 @@ bool ELFReader<32, true>::isELF(const void* pELFHeader) const {
 
 /// readRegularSection - read a regular section and create fragments.
 bool ELFReader<32, true>::readRegularSection(Input& pInput,
-                                             SectionData& pSD) const {
+                                             SectionData& pSD,
+                                             IRBuilder& pBuilder) const {
   uint32_t offset = pInput.fileOffset() + pSD.getSection().offset();
   uint32_t size = pSD.getSection().size();
 
+  if ((pSD.getSection().flag() & ELF::SHF_COMPRESSED) != 0) {
+    llvm::StringRef region = pInput.memArea()->request(offset, size);
+    if (region.startswith("ZLIB"))
+      return ReadGNUCompressedSection(pInput, pSD, pBuilder, region);
+
+    if (region.size() < sizeof(ELF::Elf32_Chdr)) {
+      error(diag::err_cannot_decompress_section) << pSD.getSection().name()
+                                                 << pInput.path();
+      return false;
+    }
+    const ELF::Elf32_Chdr* chdr =
+        reinterpret_cast<const ELF::Elf32_Chdr*>(region.begin());
+    uint32_t ch_type = chdr->ch_type;
+    uint32_t ch_size = chdr->ch_size;
+    uint32_t ch_addralign = chdr->ch_addralign;
+    if (!llvm::sys::IsLittleEndianHost) {
+      ch_type = mcld::bswap32(ch_type);
+      ch_size = mcld::bswap32(ch_size);
+      ch_addralign = mcld::bswap32(ch_addralign);
+    }
+    return ReadCompressedSection(pInput,
+                                 pSD,
+                                 pBuilder,
+                                 ch_type,
+                                 region.drop_front(sizeof(ELF::Elf32_Chdr)),
+                                 ch_size,
+                                 ch_addralign);
+  }
+
   Fragment* frag = IRBuilder::CreateRegion(pInput, offset, size);
   ObjectBuilder::AppendFragment(*frag, pSD);
   return true;
@@ -78,8 +178,10 @@ bool ELFReader<32, true>::readSymbols(Input& pInput,
   uint8_t st_other = 0x0;
   uint16_t st_shndx = 0x0;
 
-  // skip the first NULL symbol
-  pInput.context()->addSymbol(LDSymbol::Null());
+  // skip the first NULL symbol. A lazily read dynamic object is read in
+  // parts, and each part starts with a NULL entry.
+  if (pInput.context()->numOfSymbols() == 0)
+    pInput.context()->addSymbol(LDSymbol::Null());
 
   /// recording symbols added from DynObj to analyze weak alias
   std::vector<AliasInfo> potential_aliases;
@@ -402,8 +504,10 @@ bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
       sh_addralign = mcld::bswap32(shdrTab[idx].sh_addralign);
     }
 
+    uint64_t flags = sh_flags;
+    std::string name = GetSectionName(sect_name + sh_name, flags);
     LDSection* section = IRBuilder::CreateELFHeader(
-        pInput, sect_name + sh_name, sh_type, sh_flags, sh_addralign);
+        pInput, name, sh_type, flags, sh_addralign);
     section->setSize(sh_size);
     section->setOffset(sh_offset);
     section->setInfo(sh_info);
@@ -552,10 +656,40 @@ bool ELFReader<64, true>::isELF(const void* pELFHeader) const {
 
 /// readRegularSection - read a regular section and create fragments.
 bool ELFReader<64, true>::readRegularSection(Input& pInput,
-                                             SectionData& pSD) const {
+                                             SectionData& pSD,
+                                             IRBuilder& pBuilder) const {
   uint64_t offset = pInput.fileOffset() + pSD.getSection().offset();
   uint64_t size = pSD.getSection().size();
 
+  if ((pSD.getSection().flag() & ELF::SHF_COMPRESSED) != 0) {
+    llvm::StringRef region = pInput.memArea()->request(offset, size);
+    if (region.startswith("ZLIB"))
+      return ReadGNUCompressedSection(pInput, pSD, pBuilder, region);
+
+    if (region.size() < sizeof(ELF::Elf64_Chdr)) {
+      error(diag::err_cannot_decompress_section) << pSD.getSection().name()
+                                                 << pInput.path();
+      return false;
+    }
+    const ELF::Elf64_Chdr* chdr =
+        reinterpret_cast<const ELF::Elf64_Chdr*>(region.begin());
+    uint32_t ch_type = chdr->ch_type;
+    uint64_t ch_size = chdr->ch_size;
+    uint64_t ch_addralign = chdr->ch_addralign;
+    if (!llvm::sys::IsLittleEndianHost) {
+      ch_type = mcld::bswap32(ch_type);
+      ch_size = mcld::bswap64(ch_size);
+      ch_addralign = mcld::bswap64(ch_addralign);
+    }
+    return ReadCompressedSection(pInput,
+                                 pSD,
+                                 pBuilder,
+                                 ch_type,
+                                 region.drop_front(sizeof(ELF::Elf64_Chdr)),
+                                 ch_size,
+                                 ch_addralign);
+  }
+
   Fragment* frag = IRBuilder::CreateRegion(pInput, offset, size);
   ObjectBuilder::AppendFragment(*frag, pSD);
   return true;
@@ -578,8 +712,10 @@ bool ELFReader<64, true>::readSymbols(Input& pInput,
   uint8_t st_other = 0x0;
   uint16_t st_shndx = 0x0;
 
-  // skip the first NULL symbol
-  pInput.context()->addSymbol(LDSymbol::Null());
+  // skip the first NULL symbol. A lazily read dynamic object is read in
+  // parts, and each part starts with a NULL entry.
+  if (pInput.context()->numOfSymbols() == 0)
+    pInput.context()->addSymbol(LDSymbol::Null());
 
   /// recording symbols added from DynObj to analyze weak alias
   std::vector<AliasInfo> potential_aliases;
@@ -896,8 +1032,9 @@ bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
       sh_addralign = mcld::bswap64(shdrTab[idx].sh_addralign);
     }
 
+    std::string name = GetSectionName(sect_name + sh_name, sh_flags);
     LDSection* section = IRBuilder::CreateELFHeader(
-        pInput, sect_name + sh_name, sh_type, sh_flags, sh_addralign);
+        pInput, name, sh_type, sh_flags, sh_addralign);
     section->setSize(sh_size);
     section->setOffset(sh_offset);
     section->setInfo(sh_info);
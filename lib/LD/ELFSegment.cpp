@@ -11,6 +11,7 @@
 #include "mcld/Config/Config.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/ThreadArenas.h"
 
 #include <llvm/Support/ManagedStatic.h>
 
@@ -19,7 +20,7 @@
 namespace mcld {
 
 typedef GCFactory<ELFSegment, MCLD_SEGMENTS_PER_OUTPUT> ELFSegmentFactory;
-static llvm::ManagedStatic<ELFSegmentFactory> g_ELFSegmentFactory;
+static llvm::ManagedStatic<ThreadArenas<ELFSegmentFactory> > g_ELFSegmentArenas;
 
 //===----------------------------------------------------------------------===//
 // ELFSegment
@@ -82,19 +83,19 @@ void ELFSegment::append(LDSection* pSection) {
 }
 
 ELFSegment* ELFSegment::Create(uint32_t pType, uint32_t pFlag) {
-  ELFSegment* seg = g_ELFSegmentFactory->allocate();
+  ELFSegment* seg = g_ELFSegmentArenas->local().allocate();
   new (seg) ELFSegment(pType, pFlag);
   return seg;
 }
 
 void ELFSegment::Destroy(ELFSegment*& pSegment) {
-  g_ELFSegmentFactory->destroy(pSegment);
-  g_ELFSegmentFactory->deallocate(pSegment);
+  g_ELFSegmentArenas->local().destroy(pSegment);
+  g_ELFSegmentArenas->local().deallocate(pSegment);
   pSegment = NULL;
 }
 
 void ELFSegment::Clear() {
-  g_ELFSegmentFactory->clear();
+  g_ELFSegmentArenas->clear();
 }
 
 }  // namespace mcld
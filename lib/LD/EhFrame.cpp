@@ -18,14 +18,18 @@
 #include "mcld/MC/Input.h"
 #include "mcld/Object/ObjectBuilder.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/ThreadArenas.h"
 
 #include <llvm/Support/ManagedStatic.h>
 
+#include <algorithm>
+
 namespace mcld {
 
 typedef GCFactory<EhFrame, MCLD_SECTIONS_PER_INPUT> EhFrameFactory;
 
-static llvm::ManagedStatic<EhFrameFactory> g_EhFrameFactory;
+/// every thread creates the .eh_frame of its inputs in its own arena
+static llvm::ManagedStatic<ThreadArenas<EhFrameFactory> > g_EhFrameArenas;
 
 //===----------------------------------------------------------------------===//
 // EhFrame::Record
@@ -89,11 +93,12 @@ EhFrame::GeneratedFDE::~GeneratedFDE() {
 //===----------------------------------------------------------------------===//
 // EhFrame
 //===----------------------------------------------------------------------===//
-EhFrame::EhFrame() : m_pSection(NULL), m_pSectionData(NULL) {
+EhFrame::EhFrame()
+    : m_pSection(NULL), m_pSectionData(NULL), m_NumOfIndexedCIEs(0) {
 }
 
 EhFrame::EhFrame(LDSection& pSection)
-    : m_pSection(&pSection), m_pSectionData(NULL) {
+    : m_pSection(&pSection), m_pSectionData(NULL), m_NumOfIndexedCIEs(0) {
   m_pSectionData = SectionData::Create(pSection);
 }
 
@@ -101,19 +106,19 @@ EhFrame::~EhFrame() {
 }
 
 EhFrame* EhFrame::Create(LDSection& pSection) {
-  EhFrame* result = g_EhFrameFactory->allocate();
+  EhFrame* result = g_EhFrameArenas->local().allocate();
   new (result) EhFrame(pSection);
   return result;
 }
 
 void EhFrame::Destroy(EhFrame*& pSection) {
   pSection->~EhFrame();
-  g_EhFrameFactory->deallocate(pSection);
+  g_EhFrameArenas->local().deallocate(pSection);
   pSection = NULL;
 }
 
 void EhFrame::Clear() {
-  g_EhFrameFactory->clear();
+  g_EhFrameArenas->clear();
 }
 
 const LDSection& EhFrame::getSection() const {
@@ -182,24 +187,18 @@ EhFrame& EhFrame::merge(const Input& pInput, EhFrame& pFrame) {
   // Most CIE will be merged, so we don't reserve space first.
   for (cie_iterator i = pFrame.cie_begin(), e = pFrame.cie_end(); i != e; ++i) {
     CIE& input_cie = **i;
-    // CIE number is usually very few, so we just use vector sequential search.
     if (!input_cie.getMergeable()) {
       moveInputFragments(pFrame, input_cie);
       addCIE(input_cie, /*AlsoAddFragment=*/false);
       continue;
     }
 
-    cie_iterator out_i = cie_begin();
-    for (cie_iterator out_e = cie_end(); out_i != out_e; ++out_i) {
-      CIE& output_cie = **out_i;
-      if (output_cie == input_cie) {
-        // This input CIE can be merged
-        moveInputFragments(pFrame, input_cie, &output_cie);
-        removeAndUpdateCIEForFDE(pFrame, input_cie, output_cie, rel_sec);
-        break;
-      }
-    }
-    if (out_i == cie_end()) {
+    CIE* output_cie = lookUpCIE(input_cie);
+    if (output_cie != NULL) {
+      // This input CIE can be merged
+      moveInputFragments(pFrame, input_cie, output_cie);
+      removeAndUpdateCIEForFDE(pFrame, input_cie, *output_cie, rel_sec);
+    } else {
       moveInputFragments(pFrame, input_cie);
       addCIE(input_cie, /*AlsoAddFragment=*/false);
     }
@@ -207,10 +206,48 @@ EhFrame& EhFrame::merge(const Input& pInput, EhFrame& pFrame) {
   return *this;
 }
 
+/// RelocOffsetLess - order the entries of a relocation index by offset
+struct RelocOffsetLess {
+  bool operator()(const std::pair<uint64_t, Relocation*>& pX,
+                  const std::pair<uint64_t, Relocation*>& pY) const {
+    return pX.first < pY.first;
+  }
+  bool operator()(const std::pair<uint64_t, Relocation*>& pX,
+                  uint64_t pOffset) const {
+    return pX.first < pOffset;
+  }
+};
+
+EhFrame::RelocIndex::iterator EhFrame::findReloc(RelocIndex& pIndex,
+                                                 uint64_t pOffset) {
+  RelocIndex::iterator it = std::lower_bound(
+      pIndex.begin(), pIndex.end(), pOffset, RelocOffsetLess());
+  if (it == pIndex.end() || it->first != pOffset || it->second == NULL)
+    return pIndex.end();
+  return it;
+}
+
 void EhFrame::setupAttributes(const LDSection* rel_sec) {
+  // Index the relocations by offset once, so that each CIE and FDE finds its
+  // relocations by binary search instead of scanning all relocations.
+  RelocIndex index;
+  RelocData* reloc_data = NULL;
+  if (rel_sec != NULL && rel_sec->hasRelocData()) {
+    reloc_data = const_cast<RelocData*>(rel_sec->getRelocData());
+    index.reserve(reloc_data->size());
+    for (RelocData::iterator ri = reloc_data->begin(), re = reloc_data->end();
+         ri != re;
+         ++ri) {
+      Relocation& rel = *ri;
+      index.push_back(std::make_pair(rel.targetRef().getOutputOffset(), &rel));
+    }
+    std::stable_sort(index.begin(), index.end(), RelocOffsetLess());
+  }
+
   for (cie_iterator i = cie_begin(), e = cie_end(); i != e; ++i) {
     CIE* cie = *i;
-    removeDiscardedFDE(*cie, rel_sec);
+    if (reloc_data != NULL)
+      removeDiscardedFDE(*cie, index, *reloc_data);
 
     if (cie->getPersonalityName().size() == 0) {
       // There's no personality data encoding inside augmentation string.
@@ -222,19 +259,13 @@ void EhFrame::setupAttributes(const LDSection* rel_sec) {
                "PR name should be a symbol address or offset");
         continue;
       }
-      const RelocData* reloc_data = rel_sec->getRelocData();
-      for (RelocData::const_iterator ri = reloc_data->begin(),
-                                     re = reloc_data->end();
-           ri != re;
-           ++ri) {
-        const Relocation& rel = *ri;
-        if (rel.targetRef().getOutputOffset() ==
-            cie->getOffset() + cie->getPersonalityOffset()) {
-          cie->setMergeable();
-          cie->setPersonalityName(rel.symInfo()->outSymbol()->name());
-          cie->setRelocation(rel);
-          break;
-        }
+      RelocIndex::iterator it =
+          findReloc(index, cie->getOffset() + cie->getPersonalityOffset());
+      if (it != index.end()) {
+        const Relocation& rel = *it->second;
+        cie->setMergeable();
+        cie->setPersonalityName(rel.symInfo()->outSymbol()->name());
+        cie->setRelocation(rel);
       }
 
       assert(cie->getPersonalityName() != "" &&
@@ -243,53 +274,55 @@ void EhFrame::setupAttributes(const LDSection* rel_sec) {
   }
 }
 
-void EhFrame::removeDiscardedFDE(CIE& pCIE, const LDSection* pRelocSect) {
-  if (!pRelocSect)
-    return;
-
-  typedef std::vector<FDE*> FDERemoveList;
-  FDERemoveList to_be_removed_fdes;
-  const RelocData* reloc_data = pRelocSect->getRelocData();
-  for (fde_iterator i = pCIE.begin(), e = pCIE.end(); i != e; ++i) {
+void EhFrame::removeDiscardedFDE(CIE& pCIE,
+                                 RelocIndex& pIndex,
+                                 RelocData& pRelocs) {
+  fde_iterator i = pCIE.begin();
+  while (i != pCIE.end()) {
     FDE& fde = **i;
-    for (RelocData::const_iterator ri = reloc_data->begin(),
-                                   re = reloc_data->end();
-         ri != re;
+    RelocIndex::iterator it =
+        findReloc(pIndex, fde.getOffset() + getDataStartOffset<32>());
+    if (it == pIndex.end() ||
+        it->second->symInfo()->outSymbol()->hasFragRef()) {
+      ++i;
+      continue;
+    }
+
+    // The section was discarded, just ignore this FDE.
+    // This may happen when redundant group section was read.
+    i = pCIE.erase(i);
+
+    // The relocations of this FDE are adjacent in the index.
+    RelocIndex::iterator ri = std::lower_bound(
+        pIndex.begin(), pIndex.end(), fde.getOffset(), RelocOffsetLess());
+    for (; ri != pIndex.end() && ri->first < fde.getOffset() + fde.size();
          ++ri) {
-      const Relocation& rel = *ri;
-      if (rel.targetRef().getOutputOffset() ==
-          fde.getOffset() + getDataStartOffset<32>()) {
-        bool has_section = rel.symInfo()->outSymbol()->hasFragRef();
-        if (!has_section)
-          // The section was discarded, just ignore this FDE.
-          // This may happen when redundant group section was read.
-          to_be_removed_fdes.push_back(&fde);
-        break;
+      if (ri->second != NULL) {
+        pRelocs.remove(*ri->second);
+        ri->second = NULL;
       }
     }
   }
+}
 
-  for (FDERemoveList::iterator i = to_be_removed_fdes.begin(),
-                               e = to_be_removed_fdes.end();
-       i != e;
-       ++i) {
-    FDE& fde = **i;
-    fde.getCIE().remove(fde);
-
-    // FIXME: This traverses relocations from the beginning on each FDE, which
-    // may cause performance degration. Actually relocations will be sequential
-    // order, so we can bookkeep the previously found relocation for next use.
-    // Note: We must ensure FDE order is ordered.
-    for (RelocData::const_iterator ri = reloc_data->begin(),
-                                   re = reloc_data->end();
-         ri != re;) {
-      Relocation& rel = const_cast<Relocation&>(*ri++);
-      if (rel.targetRef().getOutputOffset() >= fde.getOffset() &&
-          rel.targetRef().getOutputOffset() < fde.getOffset() + fde.size()) {
-        const_cast<RelocData*>(reloc_data)->remove(rel);
-      }
-    }
+EhFrame::CIE* EhFrame::lookUpCIE(const CIE& pCIE) {
+  // index the CIEs added since the last lookup. The first CIE wins if there
+  // are duplicates.
+  for (; m_NumOfIndexedCIEs < m_CIEs.size(); ++m_NumOfIndexedCIEs) {
+    CIE* cie = m_CIEs[m_NumOfIndexedCIEs];
+    std::string key = cie->getPersonalityName();
+    key.push_back('\0');
+    key.append(cie->getAugmentationData());
+    m_CIEIndex.insert(std::make_pair(key, cie));
   }
+
+  std::string key = pCIE.getPersonalityName();
+  key.push_back('\0');
+  key.append(pCIE.getAugmentationData());
+  CIEIndex::iterator it = m_CIEIndex.find(key);
+  if (it == m_CIEIndex.end())
+    return NULL;
+  return it->getValue();
 }
 
 void EhFrame::removeAndUpdateCIEForFDE(EhFrame& pInFrame,
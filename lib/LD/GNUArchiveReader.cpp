@@ -14,7 +14,10 @@
 #include "mcld/ADT/SizeTraits.h"
 #include "mcld/MC/Attribute.h"
 #include "mcld/MC/Input.h"
+#include "mcld/LD/ArchiveIndexCache.h"
+#include "mcld/LD/DynObjReader.h"
 #include "mcld/LD/ELFObjectReader.h"
+#include "mcld/LD/NamePool.h"
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/Support/FileHandle.h"
 #include "mcld/Support/FileSystem.h"
@@ -31,11 +34,16 @@
 namespace mcld {
 
 GNUArchiveReader::GNUArchiveReader(Module& pModule,
-                                   ELFObjectReader& pELFObjectReader)
-    : m_Module(pModule), m_ELFObjectReader(pELFObjectReader) {
+                                   ELFObjectReader& pELFObjectReader,
+                                   DynObjReader* pDynObjReader)
+    : m_Module(pModule),
+      m_ELFObjectReader(pELFObjectReader),
+      m_pDynObjReader(pDynObjReader),
+      m_pIndexCache(NULL) {
 }
 
 GNUArchiveReader::~GNUArchiveReader() {
+  delete m_pIndexCache;
 }
 
 /// isMyFormat
@@ -93,11 +101,22 @@ bool GNUArchiveReader::readArchive(const LinkerConfig& pConfig,
 
   // if this is the first time read this archive, setup symtab and strtab
   if (pArchive.getSymbolTable().empty()) {
-    // read the symtab of the archive
-    readSymbolTable(pArchive);
+    const std::string& cache_dir = pConfig.options().archiveIndexCache();
+    if (!cache_dir.empty() && m_pIndexCache == NULL)
+      m_pIndexCache = new ArchiveIndexCache(cache_dir);
 
-    // read the strtab of the archive
-    readStringTable(pArchive);
+    if (m_pIndexCache != NULL && m_pIndexCache->read(pArchive)) {
+      note(diag::archive_index_read) << pArchive.getARFile().path();
+    } else {
+      // read the symtab of the archive
+      readSymbolTable(pArchive);
+
+      // read the strtab of the archive
+      readStringTable(pArchive);
+
+      if (m_pIndexCache != NULL && m_pIndexCache->write(pArchive))
+        note(diag::archive_index_written) << pArchive.getARFile().path();
+    }
 
     // add root archive to ArchiveMemberMap
     pArchive.addArchiveMember(pArchive.getARFile().name(),
@@ -121,8 +140,8 @@ bool GNUArchiveReader::readArchive(const LinkerConfig& pConfig,
       }
 
       // check if we should include this defined symbol
-      Archive::Symbol::Status status =
-          shouldIncludeSymbol(pArchive.getSymbolName(idx));
+      Archive::Symbol::Status status = shouldIncludeSymbol(
+          pArchive.getSymbolName(idx), pArchive.getSymbolHash(idx));
       if (Archive::Symbol::Unknown != status)
         pArchive.setSymbolStatus(idx, status);
 
@@ -245,13 +264,15 @@ static void readSymbolTableEntries(Archive& pArchive,
   ++data;
   const char* name = reinterpret_cast<const char*>(data + number);
 
-  // add the archive symbols
+  // add the archive symbols; the names refer to the mapped armap
   for (Offset i = 0; i < number; ++i) {
+    llvm::StringRef sym_name(name, strlen(name));
     if (llvm::sys::IsLittleEndianHost)
-      pArchive.addSymbol(name, mcld::bswap<SIZE>(*data));
+      pArchive.addSymbol(
+          sym_name, mcld::bswap<SIZE>(*data), NamePool::hash(sym_name));
     else
-      pArchive.addSymbol(name, *data);
-    name += strlen(name) + 1;
+      pArchive.addSymbol(sym_name, *data, NamePool::hash(sym_name));
+    name += sym_name.size() + 1;
     ++data;
   }
 }
@@ -328,9 +349,18 @@ bool GNUArchiveReader::readStringTable(Archive& pArchive) {
 /// shouldIncludeStatus - given a sym name from armap and check if including
 /// the corresponding archive member, and then return the decision
 enum Archive::Symbol::Status GNUArchiveReader::shouldIncludeSymbol(
-    const llvm::StringRef& pSymName) const {
+    const llvm::StringRef& pSymName,
+    unsigned int pHash) const {
   // TODO: handle symbol version issue and user defined symbols
-  const ResolveInfo* info = m_Module.getNamePool().findInfo(pSymName);
+  const NamePool& pool = m_Module.getNamePool();
+  const ResolveInfo* info = pool.findInfo(pSymName, pHash);
+
+  // A dynamic object read before the archive may define the symbol, but its
+  // symbols may not be read yet.
+  if (info != NULL && info->isUndef() && m_pDynObjReader != NULL &&
+      m_pDynObjReader->resolveSymbol(pSymName))
+    info = pool.findInfo(pSymName, pHash);
+
   if (info != NULL) {
     if (!info->isUndef())
       return Archive::Symbol::Exclude;
@@ -20,11 +20,14 @@
 #include "mcld/LinkerConfig.h"
 #include "mcld/MC/Input.h"
 #include "mcld/Support/Demangle.h"
+#include "mcld/Support/LEB128.h"
+#include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Target/GNULDBackend.h"
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
 #include <llvm/Support/Format.h>
 
 #include <cassert>
@@ -45,6 +48,41 @@ static bool isSymCtorOrDtor(const ResolveInfo& pSym) {
   return isCtorOrDtor(pSym.name(), pSym.nameSize());
 }
 
+/// isReadOnlyData - an allocated data section that is neither writable nor
+/// executable
+static bool isReadOnlyData(const LDSection& pSection) {
+  return (pSection.kind() == LDFileFormat::DATA) &&
+         (pSection.type() == llvm::ELF::SHT_PROGBITS) &&
+         ((pSection.flag() & llvm::ELF::SHF_ALLOC) != 0) &&
+         ((pSection.flag() &
+           (llvm::ELF::SHF_WRITE | llvm::ELF::SHF_EXECINSTR)) == 0);
+}
+
+static bool isFoldingCandidate(const LDSection& pSection) {
+  if (pSection.kind() == LDFileFormat::TEXT)
+    return true;
+
+  if (!isReadOnlyData(pSection) || !pSection.hasSectionData() ||
+      (pSection.size() == 0))
+    return false;
+
+  // A section named as a C identifier may be addressed by the __start_ and
+  // __stop_ symbols.
+  llvm::StringRef name(pSection.name());
+  return (name.find_first_not_of(
+              "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_"
+              "0123456789") != llvm::StringRef::npos);
+}
+
+/// getDefiningSection - the input section which defines pSym, or NULL
+static const LDSection* getDefiningSection(const LDSymbol& pSym) {
+  const ResolveInfo* info = pSym.resolveInfo();
+  if ((info == NULL) || (info->outSymbol() == NULL) ||
+      !info->outSymbol()->hasFragRef())
+    return NULL;
+  return &info->outSymbol()->fragRef()->frag()->getParent()->getSection();
+}
+
 IdenticalCodeFolding::IdenticalCodeFolding(const LinkerConfig& pConfig,
                                            const TargetLDBackend& pBackend,
                                            Module& pModule)
@@ -101,7 +139,7 @@ void IdenticalCodeFolding::foldIdenticalCode() {
   for (fobj = folded_objs.begin(); fobj != fobjEnd; ++fobj) {
     LDContext::sym_iterator sym, symEnd = (*fobj)->context()->symTabEnd();
     for (sym = (*fobj)->context()->symTabBegin(); sym != symEnd; ++sym) {
-      if ((*sym)->hasFragRef() && ((*sym)->type() == ResolveInfo::Function)) {
+      if ((*sym)->hasFragRef()) {
         LDSymbol* out_sym = (*sym)->resolveInfo()->outSymbol();
         FragmentRef* frag_ref = out_sym->fragRef();
         LDSection* sect = &(frag_ref->frag()->getParent()->getSection());
@@ -117,6 +155,9 @@ void IdenticalCodeFolding::foldIdenticalCode() {
 }
 
 void IdenticalCodeFolding::findCandidates(FoldingCandidates& pCandidateList) {
+  SectionSet addrsig_set;
+  findAddrsigSections(addrsig_set);
+
   Module::obj_iterator obj, objEnd = m_Module.obj_end();
   for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
     std::set<const LDSection*> funcptr_access_set;
@@ -125,14 +166,17 @@ void IdenticalCodeFolding::findCandidates(FoldingCandidates& pCandidateList) {
     LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
     for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
       switch ((*sect)->kind()) {
-        case LDFileFormat::TEXT: {
-          candidate_map.insert(
-              std::make_pair(*sect, reinterpret_cast<LDSection*>(NULL)));
+        case LDFileFormat::TEXT:
+        case LDFileFormat::DATA: {
+          if (isFoldingCandidate(**sect)) {
+            candidate_map.insert(
+                std::make_pair(*sect, reinterpret_cast<LDSection*>(NULL)));
+          }
           break;
         }
         case LDFileFormat::Relocation: {
           LDSection* target = (*sect)->getLink();
-          if (target->kind() == LDFileFormat::TEXT) {
+          if (isFoldingCandidate(*target)) {
             candidate_map[target] = *sect;
           }
 
@@ -166,8 +210,17 @@ void IdenticalCodeFolding::findCandidates(FoldingCandidates& pCandidateList) {
     CandidateMap::iterator candidate, candidateEnd = candidate_map.end();
     for (candidate = candidate_map.begin(); candidate != candidateEnd;
          ++candidate) {
-      if ((m_Config.options().getICFMode() == GeneralOptions::ICF_All) ||
-          (funcptr_access_set.count(candidate->first) == 0)) {
+      bool foldable = false;
+      if (candidate->first->kind() == LDFileFormat::TEXT) {
+        foldable =
+            (m_Config.options().getICFMode() == GeneralOptions::ICF_All) ||
+            ((funcptr_access_set.count(candidate->first) == 0) &&
+             (addrsig_set.count(candidate->first) == 0));
+      } else {
+        foldable = (addrsig_set.count(candidate->first) == 0);
+      }
+
+      if (foldable) {
         size_t index = m_KeptSections.size();
         m_KeptSections[candidate->first] = ObjectAndId(*obj, index);
         pCandidateList.push_back(
@@ -177,6 +230,49 @@ void IdenticalCodeFolding::findCandidates(FoldingCandidates& pCandidateList) {
   }  // for each obj
 }
 
+void IdenticalCodeFolding::findAddrsigSections(SectionSet& pSectionSet) {
+  bool safe = (m_Config.options().getICFMode() == GeneralOptions::ICF_Safe);
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext* context = (*obj)->context();
+    const LDSection* addrsig = NULL;
+    LDContext::sect_iterator sect, sectEnd = context->sectEnd();
+    for (sect = context->sectBegin(); sect != sectEnd; ++sect) {
+      if ((*sect)->name() == ".llvm_addrsig") {
+        addrsig = *sect;
+        break;
+      }
+    }
+
+    if (addrsig == NULL) {
+      // Without the table, the address of any symbol may be taken.
+      if (!safe)
+        continue;
+      LDContext::sym_iterator sym, symEnd = context->symTabEnd();
+      for (sym = context->symTabBegin(); sym != symEnd; ++sym) {
+        const LDSection* def = getDefiningSection(**sym);
+        if (def != NULL)
+          pSectionSet.insert(def);
+      }
+      continue;
+    }
+
+    // .llvm_addrsig is a list of ULEB128-encoded symbol table indices.
+    llvm::StringRef region = (*obj)->memArea()->request(
+        (*obj)->fileOffset() + addrsig->offset(), addrsig->size());
+    const char* buf = region.begin();
+    while (buf < region.end()) {
+      uint64_t index = leb128::decode<uint64_t>(buf);
+      const LDSymbol* sym = context->getSymbol(index);
+      if (sym == NULL)
+        continue;
+      const LDSection* def = getDefiningSection(*sym);
+      if (def != NULL)
+        pSectionSet.insert(def);
+    }
+  }  // for each obj
+}
+
 bool IdenticalCodeFolding::matchCandidates(FoldingCandidates& pCandidateList) {
   typedef std::multimap<uint32_t, size_t> ChecksumMap;
   ChecksumMap checksum_map;
@@ -215,6 +311,15 @@ void IdenticalCodeFolding::FoldingCandidate::initConstantContent(
     const IdenticalCodeFolding::KeptSections& pKeptSections) {
   // Get the static content from text.
   assert(sect != NULL && sect->hasSectionData());
+  // Code and data never fold into each other, and a data section must not be
+  // folded into one of a weaker alignment.
+  content.push_back(static_cast<char>(sect->kind()));
+  if (sect->kind() != LDFileFormat::TEXT) {
+    llvm::format_object<uint32_t> align_info("%x:", sect->align());
+    char align_str[16];
+    align_info.print(align_str, sizeof(align_str));
+    content.append(align_str);
+  }
   SectionData::const_iterator frag, fragEnd = sect->getSectionData()->end();
   for (frag = sect->getSectionData()->begin(); frag != fragEnd; ++frag) {
     switch (frag->getKind()) {
@@ -246,9 +351,9 @@ void IdenticalCodeFolding::FoldingCandidate::initConstantContent(
       rel_info.print(rel_str, sizeof(rel_str));
       content.append(rel_str);
 
-      // Handle the recursive call.
+      // Handle the recursive call and the self reference.
       LDSymbol* sym = rel->symInfo()->outSymbol();
-      if ((sym->type() == ResolveInfo::Function) && sym->hasFragRef()) {
+      if (sym->hasFragRef()) {
         LDSection* def = &sym->fragRef()->frag()->getParent()->getSection();
         if (def == sect) {
           continue;
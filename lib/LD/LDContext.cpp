@@ -21,6 +21,7 @@ LDContext& LDContext::appendSection(LDSection& pSection) {
   if (LDFileFormat::Relocation == pSection.kind())
     m_RelocSections.push_back(&pSection);
   pSection.setIndex(m_SectionTable.size());
+  m_SectionIndex.insert(std::make_pair(pSection.name(), m_SectionTable.size()));
   m_SectionTable.push_back(&pSection);
   return *this;
 }
@@ -38,30 +39,25 @@ const LDSection* LDContext::getSection(unsigned int pIdx) const {
 }
 
 LDSection* LDContext::getSection(const std::string& pName) {
-  sect_iterator sect_iter, sect_end = sectEnd();
-  for (sect_iter = sectBegin(); sect_iter != sect_end; ++sect_iter) {
-    if (*sect_iter != NULL && (*sect_iter)->name() == pName)
-      return *sect_iter;
-  }
-  return NULL;
+  llvm::StringMap<size_t>::const_iterator it = m_SectionIndex.find(pName);
+  if (it == m_SectionIndex.end())
+    return NULL;
+  return m_SectionTable[it->getValue()];
 }
 
 const LDSection* LDContext::getSection(const std::string& pName) const {
-  const_sect_iterator sect_iter, sect_end = sectEnd();
-  for (sect_iter = sectBegin(); sect_iter != sect_end; ++sect_iter) {
-    if (*sect_iter != NULL && (*sect_iter)->name() == pName)
-      return *sect_iter;
-  }
-  return NULL;
+  llvm::StringMap<size_t>::const_iterator it = m_SectionIndex.find(pName);
+  if (it == m_SectionIndex.end())
+    return NULL;
+  return m_SectionTable[it->getValue()];
 }
 
 size_t LDContext::getSectionIdx(const std::string& pName) const {
-  size_t result = 1;
-  size_t size = m_SectionTable.size();
-  for (; result != size; ++result)
-    if (m_SectionTable[result]->name() == pName)
-      return result;
-  return 0;
+  // index 0 is the null section, which is never looked up by name
+  llvm::StringMap<size_t>::const_iterator it = m_SectionIndex.find(pName);
+  if (it == m_SectionIndex.end())
+    return 0;
+  return it->getValue();
 }
 
 LDSymbol* LDContext::getSymbol(unsigned int pIdx) {
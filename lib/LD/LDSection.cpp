@@ -9,6 +9,7 @@
 #include "mcld/LD/LDSection.h"
 
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/ThreadArenas.h"
 
 #include <llvm/Support/ManagedStatic.h>
 
@@ -16,7 +17,8 @@ namespace mcld {
 
 typedef GCFactory<LDSection, MCLD_SECTIONS_PER_INPUT> SectionFactory;
 
-static llvm::ManagedStatic<SectionFactory> g_SectFactory;
+/// every thread creates the sections of its inputs in its own arena
+static llvm::ManagedStatic<ThreadArenas<SectionFactory> > g_SectArenas;
 
 //===----------------------------------------------------------------------===//
 // LDSection
@@ -69,19 +71,19 @@ LDSection* LDSection::Create(const std::string& pName,
                              uint32_t pFlag,
                              uint64_t pSize,
                              uint64_t pAddr) {
-  LDSection* result = g_SectFactory->allocate();
+  LDSection* result = g_SectArenas->local().allocate();
   new (result) LDSection(pName, pKind, pType, pFlag, pSize, pAddr);
   return result;
 }
 
 void LDSection::Destroy(LDSection*& pSection) {
-  g_SectFactory->destroy(pSection);
-  g_SectFactory->deallocate(pSection);
+  g_SectArenas->local().destroy(pSection);
+  g_SectArenas->local().deallocate(pSection);
   pSection = NULL;
 }
 
 void LDSection::Clear() {
-  g_SectFactory->clear();
+  g_SectArenas->clear();
 }
 
 bool LDSection::hasSectionData() const {
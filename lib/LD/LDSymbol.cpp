@@ -12,6 +12,7 @@
 #include "mcld/Fragment/FragmentRef.h"
 #include "mcld/Fragment/NullFragment.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/ThreadArenas.h"
 
 #include <llvm/Support/ManagedStatic.h>
 
@@ -23,7 +24,8 @@ typedef GCFactory<LDSymbol, MCLD_SYMBOLS_PER_INPUT> LDSymbolFactory;
 
 static llvm::ManagedStatic<LDSymbol> g_NullSymbol;
 static llvm::ManagedStatic<NullFragment> g_NullSymbolFragment;
-static llvm::ManagedStatic<LDSymbolFactory> g_LDSymbolFactory;
+/// every thread creates the symbols of its inputs in its own arena
+static llvm::ManagedStatic<ThreadArenas<LDSymbolFactory> > g_LDSymbolArenas;
 
 //===----------------------------------------------------------------------===//
 // LDSymbol
@@ -48,7 +50,7 @@ LDSymbol& LDSymbol::operator=(const LDSymbol& pCopy) {
 }
 
 LDSymbol* LDSymbol::Create(ResolveInfo& pResolveInfo) {
-  LDSymbol* result = g_LDSymbolFactory->allocate();
+  LDSymbol* result = g_LDSymbolArenas->local().allocate();
   new (result) LDSymbol();
   result->setResolveInfo(pResolveInfo);
   return result;
@@ -56,12 +58,12 @@ LDSymbol* LDSymbol::Create(ResolveInfo& pResolveInfo) {
 
 void LDSymbol::Destroy(LDSymbol*& pSymbol) {
   pSymbol->~LDSymbol();
-  g_LDSymbolFactory->deallocate(pSymbol);
+  g_LDSymbolArenas->local().deallocate(pSymbol);
   pSymbol = NULL;
 }
 
 void LDSymbol::Clear() {
-  g_LDSymbolFactory->clear();
+  g_LDSymbolArenas->clear();
 }
 
 LDSymbol* LDSymbol::Null() {
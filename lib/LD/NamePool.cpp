@@ -138,6 +138,14 @@ const ResolveInfo* NamePool::findInfo(const llvm::StringRef& pName) const {
   return iter.getEntry();
 }
 
+/// findInfo - find the resolved ResolveInfo by a hash value computed in
+/// advance
+const ResolveInfo* NamePool::findInfo(const llvm::StringRef& pName,
+                                      unsigned int pHash) const {
+  Table::const_iterator iter = m_Table.find(pName, pHash);
+  return iter.getEntry();
+}
+
 /// findSymbol - find the resolved output LDSymbol
 LDSymbol* NamePool::findSymbol(const llvm::StringRef& pName) {
   ResolveInfo* info = findInfo(pName);
@@ -9,6 +9,7 @@
 #include "mcld/LD/RelocData.h"
 
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/ThreadArenas.h"
 
 #include <llvm/Support/ManagedStatic.h>
 
@@ -16,7 +17,8 @@ namespace mcld {
 
 typedef GCFactory<RelocData, MCLD_SECTIONS_PER_INPUT> RelocDataFactory;
 
-static llvm::ManagedStatic<RelocDataFactory> g_RelocDataFactory;
+/// a RelocData is allocated in the arena of the thread reading its section
+static llvm::ManagedStatic<ThreadArenas<RelocDataFactory> > g_RelocDataArenas;
 
 //===----------------------------------------------------------------------===//
 // RelocData
@@ -28,19 +30,19 @@ RelocData::RelocData(LDSection& pSection) : m_pSection(&pSection) {
 }
 
 RelocData* RelocData::Create(LDSection& pSection) {
-  RelocData* result = g_RelocDataFactory->allocate();
+  RelocData* result = g_RelocDataArenas->local().allocate();
   new (result) RelocData(pSection);
   return result;
 }
 
 void RelocData::Destroy(RelocData*& pSection) {
   pSection->~RelocData();
-  g_RelocDataFactory->deallocate(pSection);
+  g_RelocDataArenas->local().deallocate(pSection);
   pSection = NULL;
 }
 
 void RelocData::Clear() {
-  g_RelocDataFactory->clear();
+  g_RelocDataArenas->clear();
 }
 
 RelocData& RelocData::append(Relocation& pRelocation) {
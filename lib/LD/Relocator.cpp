@@ -28,6 +28,42 @@ namespace mcld {
 Relocator::~Relocator() {
 }
 
+void Relocator::applyRelocations(RelocList& pRelocs) {
+  RelocList::iterator reloc, rEnd = pRelocs.end();
+  for (reloc = pRelocs.begin(); reloc != rEnd; ++reloc)
+    (*reloc)->apply(*this);
+}
+
+void Relocator::checkResult(Result pResult,
+                            const Relocation& pRelocation) const {
+  switch (pResult) {
+    case OK: {
+      // do nothing
+      return;
+    }
+    case Overflow: {
+      error(diag::result_overflow) << getName(pRelocation.type())
+                                   << pRelocation.symInfo()->name();
+      return;
+    }
+    case BadReloc: {
+      error(diag::result_badreloc) << getName(pRelocation.type())
+                                   << pRelocation.symInfo()->name();
+      return;
+    }
+    case Unsupported: {
+      fatal(diag::unsupported_relocation) << pRelocation.type()
+                                          << "mclinker@googlegroups.com";
+      return;
+    }
+    case Unknown: {
+      fatal(diag::unknown_relocation) << pRelocation.type()
+                                      << pRelocation.symInfo()->name();
+      return;
+    }
+  }  // end of switch
+}
+
 void Relocator::partialScanRelocation(Relocation& pReloc,
                                       Module& pModule) {
   // if we meet a section symbol
@@ -39,15 +75,22 @@ void Relocator::partialScanRelocation(Relocation& pReloc,
     uint64_t offset = input_sym->fragRef()->getOutputOffset();
     pReloc.target() += offset;
 
-    // 2. get output section symbol
-    // get the output LDSection which the symbol defined in
-    const LDSection& out_sect =
-        input_sym->fragRef()->frag()->getParent()->getSection();
-    ResolveInfo* sym_info =
+    // 2. set relocation target symbol to the output section symbol
+    pReloc.setSymInfo(getOutputSectionSymbol(*input_sym, pModule));
+  }
+}
+
+ResolveInfo* Relocator::getOutputSectionSymbol(const LDSymbol& pInputSym,
+                                               Module& pModule) {
+  // get the output LDSection which the symbol defined in
+  const LDSection& out_sect =
+      pInputSym.fragRef()->frag()->getParent()->getSection();
+  if (&out_sect != m_pLastOutSect) {
+    m_pLastOutSect = &out_sect;
+    m_pLastOutSectSym =
         pModule.getSectionSymbolSet().get(out_sect)->resolveInfo();
-    // set relocation target symbol to the output section symbol's resolveInfo
-    pReloc.setSymInfo(sym_info);
   }
+  return m_pLastOutSectSym;
 }
 
 void Relocator::issueUndefRef(Relocation& pReloc,
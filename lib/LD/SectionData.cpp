@@ -10,6 +10,7 @@
 
 #include "mcld/LD/LDSection.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/ThreadArenas.h"
 
 #include <llvm/Support/ManagedStatic.h>
 
@@ -17,7 +18,8 @@ namespace mcld {
 
 typedef GCFactory<SectionData, MCLD_SECTIONS_PER_INPUT> SectDataFactory;
 
-static llvm::ManagedStatic<SectDataFactory> g_SectDataFactory;
+/// every thread builds its section data in its own arena
+static llvm::ManagedStatic<ThreadArenas<SectDataFactory> > g_SectDataArenas;
 
 //===----------------------------------------------------------------------===//
 // SectionData
@@ -29,19 +31,19 @@ SectionData::SectionData(LDSection& pSection) : m_pSection(&pSection) {
 }
 
 SectionData* SectionData::Create(LDSection& pSection) {
-  SectionData* result = g_SectDataFactory->allocate();
+  SectionData* result = g_SectDataArenas->local().allocate();
   new (result) SectionData(pSection);
   return result;
 }
 
 void SectionData::Destroy(SectionData*& pSection) {
   pSection->~SectionData();
-  g_SectDataFactory->deallocate(pSection);
+  g_SectDataArenas->local().deallocate(pSection);
   pSection = NULL;
 }
 
 void SectionData::Clear() {
-  g_SectDataFactory->clear();
+  g_SectDataArenas->clear();
 }
 
 }  // namespace mcld
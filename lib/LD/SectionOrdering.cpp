@@ -0,0 +1,398 @@
+//===- SectionOrdering.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/SectionOrdering.h"
+
+#include "mcld/LinkerConfig.h"
+#include "mcld/Module.h"
+#include "mcld/Fragment/Fragment.h"
+#include "mcld/Fragment/FragmentRef.h"
+#include "mcld/LD/LDContext.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/LDSymbol.h"
+#include "mcld/LD/ResolveInfo.h"
+#include "mcld/LD/SectionData.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Support/MsgHandling.h"
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
+
+#include <algorithm>
+#include <map>
+
+namespace mcld {
+
+namespace {
+
+/// The C3 clustering stops growing a cluster beyond this size, since calls
+/// farther than a page or two apart do not benefit any more.
+const uint64_t kMaxClusterSize = 1024 * 1024;
+
+/// A merge is rejected if it lowers the density of the predecessor cluster
+/// by more than this factor.
+const uint64_t kMaxDensityDegradation = 8;
+
+/** \class Cluster
+ *  \brief a cluster of input sections in the C3 heuristic. The sections of a
+ *  cluster form a circular list through next/prev.
+ */
+struct Cluster {
+  Cluster(int pIndex, uint64_t pSize)
+      : next(pIndex),
+        prev(pIndex),
+        size(pSize),
+        weight(0),
+        initialWeight(0),
+        bestPred(-1),
+        bestPredWeight(0) {}
+
+  double density() const {
+    if (size == 0)
+      return 0.0;
+    return static_cast<double>(weight) / static_cast<double>(size);
+  }
+
+  int next;
+  int prev;
+  uint64_t size;
+  uint64_t weight;
+  uint64_t initialWeight;
+  int bestPred;
+  uint64_t bestPredWeight;
+};
+
+/** \class DensityCompare
+ *  \brief order cluster indices by descending density
+ */
+class DensityCompare {
+ public:
+  explicit DensityCompare(const std::vector<Cluster>& pClusters)
+      : m_Clusters(pClusters) {}
+
+  bool operator()(int pX, int pY) const {
+    return m_Clusters[pX].density() > m_Clusters[pY].density();
+  }
+
+ private:
+  const std::vector<Cluster>& m_Clusters;
+};
+
+int GetLeader(std::vector<int>& pLeaders, int pIndex) {
+  while (pLeaders[pIndex] != pIndex) {
+    pLeaders[pIndex] = pLeaders[pLeaders[pIndex]];
+    pIndex = pLeaders[pIndex];
+  }
+  return pIndex;
+}
+
+/// MergeClusters - append the sections of pFrom to pInto
+void MergeClusters(std::vector<Cluster>& pClusters, int pInto, int pFrom) {
+  Cluster& into = pClusters[pInto];
+  Cluster& from = pClusters[pFrom];
+
+  int tail1 = into.prev;
+  int tail2 = from.prev;
+  into.prev = tail2;
+  pClusters[tail2].next = pInto;
+  from.prev = tail1;
+  pClusters[tail1].next = pFrom;
+
+  into.size += from.size;
+  into.weight += from.weight;
+  from.size = 0;
+  from.weight = 0;
+}
+
+bool IsCandidateKind(const LDSection& pSection) {
+  switch (pSection.kind()) {
+    case LDFileFormat::TEXT:
+    case LDFileFormat::DATA:
+    case LDFileFormat::BSS:
+      return pSection.hasSectionData();
+    default:
+      return false;
+  }
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// SectionOrdering
+//===----------------------------------------------------------------------===//
+SectionOrdering::SectionOrdering(const LinkerConfig& pConfig, Module& pModule)
+    : m_Config(pConfig), m_Module(pModule) {
+}
+
+bool SectionOrdering::run() {
+  const GeneralOptions& options = m_Config.options();
+  if (!options.hasSymbolOrderingFile() && !options.hasCallGraphProfile())
+    return true;
+
+  collectCandidates();
+
+  if (options.hasSymbolOrderingFile())
+    return orderBySymbolFile(options.symbolOrderingFile());
+
+  return orderByCallGraph(options.callGraphProfileFile());
+}
+
+bool SectionOrdering::isOrdered(const LDSection& pSection) const {
+  return m_OrderedIndex.find(&pSection) != m_OrderedIndex.end();
+}
+
+void SectionOrdering::collectCandidates() {
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      if (*sect == NULL || !IsCandidateKind(**sect))
+        continue;
+      m_CandidateIndex[*sect] = m_Candidates.size();
+      m_Candidates.push_back(std::make_pair(*obj, *sect));
+    }
+  }
+}
+
+int SectionOrdering::getSectionIndex(const LDSymbol& pSymbol) const {
+  // use the resolved definition of a global symbol
+  const LDSymbol* sym = &pSymbol;
+  if (pSymbol.resolveInfo() != NULL && !pSymbol.resolveInfo()->isLocal() &&
+      pSymbol.resolveInfo()->outSymbol() != NULL)
+    sym = pSymbol.resolveInfo()->outSymbol();
+
+  if (!sym->hasFragRef() || sym->fragRef()->frag() == NULL)
+    return -1;
+
+  const LDSection& sect = sym->fragRef()->frag()->getParent()->getSection();
+  SectionIndexMap::const_iterator it = m_CandidateIndex.find(&sect);
+  if (it == m_CandidateIndex.end())
+    return -1;
+  return it->second;
+}
+
+bool SectionOrdering::readFile(const std::string& pPath,
+                               std::unique_ptr<llvm::MemoryBuffer>& pBuffer) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > buffer_or_error =
+      llvm::MemoryBuffer::getFile(pPath,
+                                  /*FileSize*/ -1,
+                                  /*RequiresNullTerminator*/ false);
+  if (!buffer_or_error) {
+    error(diag::err_cannot_read_ordering_file) << pPath
+        << buffer_or_error.getError().message();
+    return false;
+  }
+  pBuffer = std::move(buffer_or_error.get());
+  return true;
+}
+
+bool SectionOrdering::orderBySymbolFile(const std::string& pPath) {
+  std::unique_ptr<llvm::MemoryBuffer> buffer;
+  if (!readFile(pPath, buffer))
+    return false;
+
+  // the priority of a symbol is its first line number in the file
+  llvm::StringMap<size_t> priorities;
+  llvm::SmallVector<llvm::StringRef, 0> lines;
+  buffer->getBuffer().split(lines, "\n", /*MaxSplit*/ -1, /*KeepEmpty*/ false);
+  for (size_t i = 0; i < lines.size(); ++i) {
+    llvm::StringRef name = lines[i].trim();
+    if (name.empty() || name.startswith("#"))
+      continue;
+    if (priorities.find(name) == priorities.end())
+      priorities[name] = i;
+  }
+
+  // the priority of a section is the highest priority of the symbols defined
+  // in it.
+  std::vector<size_t> sect_priority(m_Candidates.size(), lines.size());
+  llvm::StringMap<bool> found;
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sym_iterator sym, symEnd = (*obj)->context()->symTabEnd();
+    for (sym = (*obj)->context()->symTabBegin(); sym != symEnd; ++sym) {
+      if (*sym == NULL)
+        continue;
+      llvm::StringMap<size_t>::iterator prio = priorities.find((*sym)->name());
+      if (prio == priorities.end())
+        continue;
+      int index = getSectionIndex(**sym);
+      if (index < 0)
+        continue;
+      found[prio->getKey()] = true;
+      if (prio->getValue() < sect_priority[index])
+        sect_priority[index] = prio->getValue();
+    }
+  }
+
+  // report the missing symbols in the order of the file, so that the
+  // diagnostics do not depend on the hashing of the StringMap.
+  for (size_t i = 0; i < lines.size(); ++i) {
+    llvm::StringRef name = lines[i].trim();
+    if (name.empty() || name.startswith("#"))
+      continue;
+    llvm::StringMap<size_t>::iterator prio = priorities.find(name);
+    if (prio->getValue() != i)
+      continue;  // a duplicate line
+    if (found.find(name) == found.end())
+      warning(diag::warn_ordering_symbol_not_found) << pPath << name;
+  }
+
+  // sort the ranked sections by priority. Sections with the same priority
+  // keep the input order.
+  std::multimap<size_t, size_t> ranked;
+  for (size_t i = 0; i < sect_priority.size(); ++i) {
+    if (sect_priority[i] < lines.size())
+      ranked.insert(std::make_pair(sect_priority[i], i));
+  }
+
+  std::multimap<size_t, size_t>::iterator it, itEnd = ranked.end();
+  for (it = ranked.begin(); it != itEnd; ++it) {
+    m_OrderedIndex[m_Candidates[it->second].second] = m_Ordered.size();
+    m_Ordered.push_back(m_Candidates[it->second]);
+  }
+  return true;
+}
+
+bool SectionOrdering::orderByCallGraph(const std::string& pPath) {
+  std::unique_ptr<llvm::MemoryBuffer> buffer;
+  if (!readFile(pPath, buffer))
+    return false;
+
+  // map symbol names to the sections defining them
+  llvm::StringMap<int> symbols;
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sym_iterator sym, symEnd = (*obj)->context()->symTabEnd();
+    for (sym = (*obj)->context()->symTabBegin(); sym != symEnd; ++sym) {
+      if (*sym == NULL || (*sym)->resolveInfo() == NULL ||
+          (*sym)->resolveInfo()->type() != ResolveInfo::Function)
+        continue;
+      int index = getSectionIndex(**sym);
+      if (index >= 0 && symbols.find((*sym)->name()) == symbols.end())
+        symbols[(*sym)->name()] = index;
+    }
+  }
+
+  // build the clusters, one section per cluster at the beginning. Only the
+  // sections that appear in the call graph get a cluster.
+  std::vector<Cluster> clusters;
+  std::vector<int> cluster_of(m_Candidates.size(), -1);
+  std::vector<size_t> section_of;
+
+  llvm::SmallVector<llvm::StringRef, 0> lines;
+  buffer->getBuffer().split(lines, "\n", /*MaxSplit*/ -1, /*KeepEmpty*/ false);
+  for (size_t i = 0; i < lines.size(); ++i) {
+    llvm::StringRef line = lines[i].trim();
+    if (line.empty() || line.startswith("#"))
+      continue;
+
+    llvm::SmallVector<llvm::StringRef, 3> fields;
+    line.split(fields, " ", /*MaxSplit*/ -1, /*KeepEmpty*/ false);
+    uint64_t weight = 0;
+    if (fields.size() != 3 || fields[2].getAsInteger(10, weight)) {
+      error(diag::err_invalid_call_graph_entry) << pPath << (i + 1) << line;
+      return false;
+    }
+
+    llvm::StringMap<int>::iterator caller = symbols.find(fields[0]);
+    llvm::StringMap<int>::iterator callee = symbols.find(fields[1]);
+    if (caller == symbols.end() || callee == symbols.end())
+      continue;
+
+    // the edge is useless if the two sections go to different outputs. We
+    // approximate it by comparing the kind of the sections.
+    const LDSection* from_sect = m_Candidates[caller->getValue()].second;
+    const LDSection* to_sect = m_Candidates[callee->getValue()].second;
+    if (from_sect->kind() != to_sect->kind())
+      continue;
+
+    int ends[2] = { caller->getValue(), callee->getValue() };
+    for (int e = 0; e < 2; ++e) {
+      if (cluster_of[ends[e]] < 0) {
+        cluster_of[ends[e]] = clusters.size();
+        section_of.push_back(ends[e]);
+        clusters.push_back(
+            Cluster(clusters.size(), m_Candidates[ends[e]].second->size()));
+      }
+    }
+
+    int from = cluster_of[ends[0]];
+    int to = cluster_of[ends[1]];
+    clusters[to].weight += weight;
+    if (from == to)
+      continue;
+
+    // remember the heaviest incoming edge
+    if (clusters[to].bestPred < 0 || clusters[to].bestPredWeight < weight) {
+      clusters[to].bestPred = from;
+      clusters[to].bestPredWeight = weight;
+    }
+  }
+
+  for (size_t i = 0; i < clusters.size(); ++i)
+    clusters[i].initialWeight = clusters[i].weight;
+
+  // C3: visit the sections in the order of density, and append each one to
+  // the cluster of its most likely caller.
+  std::vector<int> sorted(clusters.size());
+  std::vector<int> leaders(clusters.size());
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    sorted[i] = i;
+    leaders[i] = i;
+  }
+  std::stable_sort(sorted.begin(), sorted.end(), DensityCompare(clusters));
+
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    int leader = sorted[i];
+    Cluster& cluster = clusters[leader];
+
+    // ignore the unlikely edges
+    if (cluster.bestPred < 0 ||
+        cluster.bestPredWeight * 10 <= cluster.initialWeight)
+      continue;
+
+    int pred_leader = GetLeader(leaders, cluster.bestPred);
+    if (pred_leader == leader)
+      continue;
+
+    Cluster& pred = clusters[pred_leader];
+    if (cluster.size + pred.size > kMaxClusterSize)
+      continue;
+
+    // do not merge if the density of the predecessor drops too much
+    double new_density = static_cast<double>(pred.weight + cluster.weight) /
+                         static_cast<double>(pred.size + cluster.size + 1);
+    if (new_density < pred.density() / kMaxDensityDegradation)
+      continue;
+
+    leaders[leader] = pred_leader;
+    MergeClusters(clusters, pred_leader, leader);
+  }
+
+  // emit the remaining clusters in the order of density
+  sorted.clear();
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    if (GetLeader(leaders, i) == static_cast<int>(i))
+      sorted.push_back(i);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(), DensityCompare(clusters));
+
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    int index = sorted[i];
+    do {
+      const Entry& entry = m_Candidates[section_of[index]];
+      m_OrderedIndex[entry.second] = m_Ordered.size();
+      m_Ordered.push_back(entry);
+      index = clusters[index].next;
+    } while (index != sorted[i]);
+  }
+  return true;
+}
+
+}  // namespace mcld
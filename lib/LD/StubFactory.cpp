@@ -23,6 +23,9 @@ namespace mcld {
 //===----------------------------------------------------------------------===//
 // StubFactory
 //===----------------------------------------------------------------------===//
+StubFactory::StubFactory() : m_NumOfCreatedStubs(0), m_NumOfReusedStubs(0) {
+}
+
 StubFactory::~StubFactory() {
   for (StubPoolType::iterator it = m_StubPool.begin(), ie = m_StubPool.end();
        it != ie;
@@ -61,12 +64,14 @@ Stub* StubFactory::create(Relocation& pReloc,
     if (stub != NULL) {
       // reset the branch target to the stub instead!
       pReloc.setSymInfo(stub->symInfo());
+      ++m_NumOfReusedStubs;
     } else {
       // find if there is such a stub in the forward island.
       stub = islands.first->findStub(prototype, pReloc);
       if (stub != NULL) {
         // reset the branch target to the stub instead!
         pReloc.setSymInfo(stub->symInfo());
+        ++m_NumOfReusedStubs;
       } else {
         // create a stub from the prototype
         stub = prototype->clone();
@@ -111,6 +116,7 @@ Stub* StubFactory::create(Relocation& pReloc,
 
         // reset the branch target of the input reloc to this stub instead!
         pReloc.setSymInfo(stub->symInfo());
+        ++m_NumOfCreatedStubs;
       }
     }
   }
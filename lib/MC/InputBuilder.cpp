@@ -22,12 +22,26 @@ InputBuilder::InputBuilder(const LinkerConfig& pConfig)
       m_pCurrentTree(NULL),
       m_pMove(NULL),
       m_Root(),
-      m_bOwnFactory(true) {
+      m_bOwnFactory(true),
+      m_bOwnMemFactory(true) {
   m_pInputFactory = new InputFactory(MCLD_NUM_OF_INPUTS, pConfig);
   m_pContextFactory = new ContextFactory(MCLD_NUM_OF_INPUTS);
   m_pMemFactory = new MemoryAreaFactory(MCLD_NUM_OF_INPUTS);
 }
 
+InputBuilder::InputBuilder(const LinkerConfig& pConfig,
+                           MemoryAreaFactory& pMemoryFactory)
+    : m_Config(pConfig),
+      m_pMemFactory(&pMemoryFactory),
+      m_pCurrentTree(NULL),
+      m_pMove(NULL),
+      m_Root(),
+      m_bOwnFactory(true),
+      m_bOwnMemFactory(false) {
+  m_pInputFactory = new InputFactory(MCLD_NUM_OF_INPUTS, pConfig);
+  m_pContextFactory = new ContextFactory(MCLD_NUM_OF_INPUTS);
+}
+
 InputBuilder::InputBuilder(const LinkerConfig& pConfig,
                            InputFactory& pInputFactory,
                            ContextFactory& pContextFactory,
@@ -40,15 +54,17 @@ InputBuilder::InputBuilder(const LinkerConfig& pConfig,
       m_pCurrentTree(NULL),
       m_pMove(NULL),
       m_Root(),
-      m_bOwnFactory(pDelegate) {
+      m_bOwnFactory(pDelegate),
+      m_bOwnMemFactory(pDelegate) {
 }
 
 InputBuilder::~InputBuilder() {
   if (m_bOwnFactory) {
     delete m_pInputFactory;
     delete m_pContextFactory;
-    delete m_pMemFactory;
   }
+  if (m_bOwnMemFactory)
+    delete m_pMemFactory;
 }
 
 Input* InputBuilder::createInput(const std::string& pName,
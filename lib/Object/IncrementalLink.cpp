@@ -0,0 +1,849 @@
+//===- IncrementalLink.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Object/IncrementalLink.h"
+
+#include "mcld/InputTree.h"
+#include "mcld/LinkerConfig.h"
+#include "mcld/Module.h"
+#include "mcld/Fragment/RegionFragment.h"
+#include "mcld/LD/LDContext.h"
+#include "mcld/LD/LDFileFormat.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/SectionData.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Support/ELF.h"
+#include "mcld/Support/FileHandle.h"
+#include "mcld/Support/FileOutputBuffer.h"
+#include "mcld/Support/FileSystem.h"
+#include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/SystemUtils.h"
+
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
+#include <llvm/Support/ErrorOr.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <set>
+#include <system_error>
+
+namespace mcld {
+
+namespace {
+
+/// The layout of a state file, in host byte order:
+///   StateHeader
+///   the command line (keySize bytes), padded to 8 bytes
+///   numOfFiles times
+///     FileHeader
+///     the path of the file, padded to 8 bytes
+///     SectionRecord[numOfSections]
+/// Bump the version in the magic when the layout or Hash() changes.
+const char StateMagic[8] = {'M', 'C', 'L', 'D', 'I', 'N', 'C', '2'};
+
+}  // anonymous namespace
+
+struct IncrementalLink::StateHeader {
+  char magic[8];
+  uint64_t inputs;  // the hash of the paths of the inputs on the command line
+  uint64_t outSize;
+  uint64_t outModTime;
+  uint64_t outInode;
+  uint32_t keySize;
+  uint32_t numOfFiles;
+};
+
+namespace {
+
+struct FileHeader {
+  uint64_t size;
+  uint64_t modTime;
+  uint64_t inode;
+  uint64_t hash;
+  uint32_t pathSize;
+  uint32_t numOfSections;
+  uint32_t flags;
+  uint32_t padding;
+};
+
+/// The bytes around a relocation site which the linker may rewrite: the
+/// relocated field and the opcode in front of it, which decides relaxations.
+const uint64_t WindowBefore = 4;
+const uint64_t WindowAfter = 8;
+
+/// An input that changed less than this many seconds before it was recorded
+/// may change again within the same modification time; it is always hashed.
+const uint64_t RacyInterval = 2;
+
+size_t Align8(size_t pSize) {
+  return (pSize + 7) & ~static_cast<size_t>(7);
+}
+
+/// Hash - a fast non-cryptographic hash of file contents
+uint64_t Hash(const char* pData, size_t pSize, uint64_t pSeed = 0) {
+  const uint64_t mul = 0x9e3779b97f4a7c15ULL;
+  uint64_t hash = (pSeed ^ pSize) * mul;
+  size_t i = 0;
+  for (; i + 8 <= pSize; i += 8) {
+    uint64_t word;
+    memcpy(&word, pData + i, sizeof(word));
+    hash = (hash ^ word) * mul;
+    hash ^= hash >> 29;
+  }
+  for (; i < pSize; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(pData[i])) * mul;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+
+uint64_t Hash(llvm::StringRef pData, uint64_t pSeed = 0) {
+  return Hash(pData.data(), pData.size(), pSeed);
+}
+
+/// StoredModTime - the modification time to record for a file
+uint64_t StoredModTime(const sys::fs::FileStatus& pStatus) {
+  uint64_t now = static_cast<uint64_t>(time(NULL));
+  if (pStatus.modTime() + RacyInterval > now)
+    return 0;
+  return pStatus.modTime();
+}
+
+bool IsUnchanged(const sys::fs::FileStatus& pStatus,
+                 uint64_t pSize,
+                 uint64_t pModTime,
+                 uint64_t pInode) {
+  return pStatus.size() == pSize && pStatus.modTime() == pModTime &&
+         pStatus.inode() == pInode;
+}
+
+/** \class ELFImage
+ *  \brief ELFImage reads the section headers of a relocatable ELF object
+ *  from its raw bytes, of any class and byte order.
+ */
+class ELFImage {
+ public:
+  struct Section {
+    uint64_t header;  // the hash of the section header except sh_offset
+    uint32_t type;
+    uint32_t info;
+    uint64_t flags;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t entsize;
+  };
+
+ public:
+  ELFImage() : m_b64(false), m_bLittle(true), m_HeaderHash(0) {}
+
+  /// parse - read pFile
+  /// @return false if pFile is not a relocatable ELF object
+  bool parse(llvm::StringRef pFile);
+
+  uint64_t headerHash() const { return m_HeaderHash; }
+
+  size_t numOfSections() const { return m_Sections.size(); }
+
+  const Section& getSection(size_t pIdx) const { return m_Sections[pIdx]; }
+
+  llvm::StringRef getContents(size_t pIdx) const;
+
+  /// getRelocSites - get the sorted offsets of the relocations which apply
+  /// to section pIdx
+  void getRelocSites(size_t pIdx, std::vector<uint64_t>& pSites) const;
+
+ private:
+  uint64_t read(const char* pData, unsigned int pSize) const;
+
+ private:
+  llvm::StringRef m_File;
+  bool m_b64;
+  bool m_bLittle;
+  uint64_t m_HeaderHash;
+  std::vector<Section> m_Sections;
+};
+
+uint64_t ELFImage::read(const char* pData, unsigned int pSize) const {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(pData);
+  uint64_t value = 0;
+  for (unsigned int i = 0; i < pSize; ++i) {
+    unsigned int byte = m_bLittle ? (pSize - 1 - i) : i;
+    value = (value << 8) | data[byte];
+  }
+  return value;
+}
+
+bool ELFImage::parse(llvm::StringRef pFile) {
+  m_File = pFile;
+  m_Sections.clear();
+
+  const char* data = pFile.data();
+  if (pFile.size() < llvm::ELF::EI_NIDENT ||
+      memcmp(data, llvm::ELF::ElfMagic, 4) != 0)
+    return false;
+  m_b64 = (llvm::ELF::ELFCLASS64 == data[llvm::ELF::EI_CLASS]);
+  m_bLittle = (llvm::ELF::ELFDATA2LSB == data[llvm::ELF::EI_DATA]);
+
+  size_t ehsize = m_b64 ? 64 : 52;
+  if (pFile.size() < ehsize || llvm::ELF::ET_REL != read(data + 16, 2))
+    return false;
+
+  uint64_t shoff = m_b64 ? read(data + 0x28, 8) : read(data + 0x20, 4);
+  uint64_t shentsize = m_b64 ? read(data + 0x3A, 2) : read(data + 0x2E, 2);
+  uint64_t shnum = m_b64 ? read(data + 0x3C, 2) : read(data + 0x30, 2);
+  // objects with the extended section numbering are not patched
+  if (shnum == 0 || shentsize < (m_b64 ? 64u : 40u) ||
+      shoff > pFile.size() || shnum * shentsize > pFile.size() - shoff)
+    return false;
+
+  m_HeaderHash = Hash(data, ehsize);
+
+  size_t offsetField = m_b64 ? 24 : 16;
+  size_t offsetSize = m_b64 ? 8 : 4;
+  std::string header;
+  m_Sections.resize(shnum);
+  for (uint64_t idx = 0; idx < shnum; ++idx) {
+    const char* shdr = data + shoff + idx * shentsize;
+    Section& sect = m_Sections[idx];
+    sect.type = read(shdr + 4, 4);
+    if (m_b64) {
+      sect.flags = read(shdr + 8, 8);
+      sect.offset = read(shdr + 24, 8);
+      sect.size = read(shdr + 32, 8);
+      sect.info = read(shdr + 44, 4);
+      sect.entsize = read(shdr + 56, 8);
+    } else {
+      sect.flags = read(shdr + 8, 4);
+      sect.offset = read(shdr + 16, 4);
+      sect.size = read(shdr + 20, 4);
+      sect.info = read(shdr + 28, 4);
+      sect.entsize = read(shdr + 36, 4);
+    }
+    if (llvm::ELF::SHT_NOBITS != sect.type &&
+        (sect.offset > pFile.size() || sect.size > pFile.size() - sect.offset))
+      return false;
+
+    // the offsets of the sections may move while their contents stay
+    header.assign(shdr, shentsize);
+    memset(&header[offsetField], 0, offsetSize);
+    sect.header = Hash(header);
+  }
+  return true;
+}
+
+llvm::StringRef ELFImage::getContents(size_t pIdx) const {
+  const Section& sect = m_Sections[pIdx];
+  if (llvm::ELF::SHT_NOBITS == sect.type)
+    return llvm::StringRef();
+  return m_File.substr(sect.offset, sect.size);
+}
+
+void ELFImage::getRelocSites(size_t pIdx, std::vector<uint64_t>& pSites) const {
+  pSites.clear();
+  std::vector<Section>::const_iterator sect, sectEnd = m_Sections.end();
+  for (sect = m_Sections.begin(); sect != sectEnd; ++sect) {
+    if ((llvm::ELF::SHT_REL != sect->type &&
+         llvm::ELF::SHT_RELA != sect->type) ||
+        sect->info != pIdx)
+      continue;
+
+    bool rela = (llvm::ELF::SHT_RELA == sect->type);
+    uint64_t entsize = sect->entsize;
+    if (entsize == 0)
+      entsize = m_b64 ? (rela ? 24 : 16) : (rela ? 12 : 8);
+    unsigned int offsetSize = m_b64 ? 8 : 4;
+    if (entsize < offsetSize)
+      continue;
+
+    const char* data = m_File.data() + sect->offset;
+    for (uint64_t off = 0; off + entsize <= sect->size; off += entsize)
+      pSites.push_back(read(data + off, offsetSize));
+  }
+  std::sort(pSites.begin(), pSites.end());
+}
+
+/// HashWindows - hash the bytes around every relocation site in pContents
+uint64_t HashWindows(llvm::StringRef pContents,
+                     const std::vector<uint64_t>& pSites) {
+  uint64_t hash = pSites.size();
+  std::vector<uint64_t>::const_iterator site, siteEnd = pSites.end();
+  for (site = pSites.begin(); site != siteEnd; ++site) {
+    uint64_t begin = (*site < WindowBefore) ? 0 : *site - WindowBefore;
+    uint64_t end = std::min<uint64_t>(*site + WindowAfter, pContents.size());
+    if (begin < end)
+      hash = Hash(pContents.data() + begin, end - begin, hash ^ *site);
+    else
+      hash = Hash(NULL, 0, hash ^ *site);
+  }
+  return hash;
+}
+
+/// IsCopied - the bytes of pOutput are the same as pContents, except for the
+/// bytes around the relocation sites
+bool IsCopied(llvm::StringRef pContents,
+              const uint8_t* pOutput,
+              const std::vector<uint64_t>& pSites) {
+  const char* output = reinterpret_cast<const char*>(pOutput);
+  uint64_t pos = 0;
+  std::vector<uint64_t>::const_iterator site, siteEnd = pSites.end();
+  for (site = pSites.begin(); site != siteEnd; ++site) {
+    uint64_t begin = (*site < WindowBefore) ? 0 : *site - WindowBefore;
+    uint64_t end = std::min<uint64_t>(*site + WindowAfter, pContents.size());
+    if (begin > pos && begin <= pContents.size() &&
+        memcmp(pContents.data() + pos, output + pos, begin - pos) != 0)
+      return false;
+    pos = std::max(pos, end);
+  }
+  return pos >= pContents.size() ||
+         memcmp(pContents.data() + pos, output + pos,
+                pContents.size() - pos) == 0;
+}
+
+std::unique_ptr<llvm::MemoryBuffer> ReadFile(const std::string& pPath) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > buffer_or_error =
+      llvm::MemoryBuffer::getFile(pPath,
+                                  /*FileSize*/ -1,
+                                  /*RequiresNullTerminator*/ false);
+  if (!buffer_or_error)
+    return std::unique_ptr<llvm::MemoryBuffer>();
+  return std::move(buffer_or_error.get());
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// IncrementalLink::Patch
+//===----------------------------------------------------------------------===//
+struct IncrementalLink::Patch {
+  uint64_t outOffset;
+  llvm::StringRef contents;
+  std::vector<uint64_t> sites;
+};
+
+//===----------------------------------------------------------------------===//
+// IncrementalLink
+//===----------------------------------------------------------------------===//
+IncrementalLink::IncrementalLink(const LinkerConfig& pConfig,
+                                 const Module& pModule)
+    : m_Config(pConfig), m_Module(pModule), m_Inputs(0), m_bRelinked(false) {
+}
+
+IncrementalLink::~IncrementalLink() {
+}
+
+std::string IncrementalLink::getStatePath(const std::string& pOutput) {
+  return pOutput + ".mcld-state";
+}
+
+void IncrementalLink::collectExtraFiles(
+    std::vector<std::string>& pFiles) const {
+  // the files named by the options instead of the input tree
+  if (m_Config.options().hasSymbolOrderingFile())
+    pFiles.push_back(m_Config.options().symbolOrderingFile());
+  if (m_Config.options().hasCallGraphProfile())
+    pFiles.push_back(m_Config.options().callGraphProfileFile());
+
+  // the response files in the command line
+  const std::string& key = m_Config.options().incrementalKey();
+  size_t pos = 0;
+  while (pos < key.size()) {
+    size_t end = key.find('\0', pos);
+    if (end == std::string::npos)
+      end = key.size();
+    if (key[pos] == '@')
+      pFiles.push_back(key.substr(pos + 1, end - pos - 1));
+    pos = end + 1;
+  }
+}
+
+/// relink - patch the output of the previous link
+bool IncrementalLink::relink() {
+  // the inputs on the command line, before any script or archive adds more
+  m_Inputs = 0;
+  InputTree::const_dfs_iterator input,
+      inEnd = m_Module.getInputTree().dfs_end();
+  for (input = m_Module.getInputTree().dfs_begin(); input != inEnd; ++input)
+    m_Inputs = Hash((*input)->path().native(), m_Inputs);
+
+  std::string reason;
+  if (!tryRelink(reason)) {
+    note(diag::incremental_full_link) << m_Module.name() << reason;
+    return false;
+  }
+  m_bRelinked = true;
+  return true;
+}
+
+bool IncrementalLink::tryRelink(std::string& pReason) {
+  const std::string& output = m_Module.name();
+  std::unique_ptr<llvm::MemoryBuffer> state = ReadFile(getStatePath(output));
+  if (!state) {
+    pReason = "no state of a previous link";
+    return false;
+  }
+
+  FileList files;
+  StateHeader header;
+  if (!readState(state->getBuffer(), header, files)) {
+    pReason = "the state of the previous link is corrupt";
+    return false;
+  }
+
+  const std::string& key = m_Config.options().incrementalKey();
+  if (header.keySize != key.size() ||
+      memcmp(state->getBufferStart() + sizeof(StateHeader),
+             key.data(),
+             key.size()) != 0) {
+    pReason = "the command line changed";
+    return false;
+  }
+
+  if (header.inputs != m_Inputs) {
+    pReason = "the input files changed";
+    return false;
+  }
+
+  sys::fs::FileStatus status;
+  sys::fs::detail::status(sys::fs::Path(output), status);
+  if (sys::fs::RegularFile != status.type() ||
+      !IsUnchanged(status, header.outSize, header.outModTime, header.outInode)) {
+    pReason = "the output was modified";
+    return false;
+  }
+
+  // find out the changes of the inputs
+  std::vector<std::unique_ptr<llvm::MemoryBuffer> > buffers;
+  std::vector<Patch> patches;
+  size_t numOfPatchedFiles = 0;
+  bool touched = false;
+  FileList::iterator file, fileEnd = files.end();
+  for (file = files.begin(); file != fileEnd; ++file) {
+    sys::fs::detail::status(sys::fs::Path(file->path), status);
+    if (sys::fs::RegularFile != status.type()) {
+      pReason = "`" + file->path + "' is missing";
+      return false;
+    }
+    if (IsUnchanged(status, file->size, file->modTime, file->inode))
+      continue;
+
+    std::unique_ptr<llvm::MemoryBuffer> buffer = ReadFile(file->path);
+    if (!buffer) {
+      pReason = "cannot read `" + file->path + "'";
+      return false;
+    }
+
+    size_t numOfPatches = patches.size();
+    if ((file->flags & ELFObject) != 0x0) {
+      if (!diffObject(*file, buffer->getBuffer(), patches, pReason))
+        return false;
+    } else if (Hash(buffer->getBuffer()) != file->hash) {
+      pReason = "`" + file->path + "' changed";
+      return false;
+    }
+
+    if (patches.size() != numOfPatches)
+      ++numOfPatchedFiles;
+    file->size = status.size();
+    file->modTime = StoredModTime(status);
+    file->inode = status.inode();
+    buffers.push_back(std::move(buffer));
+    touched = true;
+  }
+
+  m_Files.swap(files);
+  if (patches.empty()) {
+    // refresh the fingerprints of the inputs which were touched only
+    if (touched)
+      write(output);
+    return true;
+  }
+
+  // the output is rewritten in place; the state is invalid until the new one
+  // is written
+  FileHandle handle;
+  if (!handle.open(sys::fs::Path(output),
+                   FileHandle::OpenMode(FileHandle::ReadWrite),
+                   FileHandle::Permission(FileHandle::System))) {
+    pReason = "cannot open the output";
+    return false;
+  }
+  llvm::sys::fs::remove(getStatePath(output));
+
+  std::string bytes;
+  std::vector<Patch>::const_iterator patch, patchEnd = patches.end();
+  for (patch = patches.begin(); patch != patchEnd; ++patch) {
+    bytes.assign(patch->contents.data(), patch->contents.size());
+    // keep the relocated bytes of the previous output
+    bool success = true;
+    std::vector<uint64_t>::const_iterator site, siteEnd = patch->sites.end();
+    for (site = patch->sites.begin(); site != siteEnd && success; ++site) {
+      uint64_t begin = (*site < WindowBefore) ? 0 : *site - WindowBefore;
+      uint64_t end = std::min<uint64_t>(*site + WindowAfter, bytes.size());
+      if (begin < end)
+        success = handle.read(
+            &bytes[begin], patch->outOffset + begin, end - begin);
+    }
+    if (!success ||
+        !handle.write(bytes.data(), patch->outOffset, bytes.size())) {
+      handle.close();
+      pReason = "cannot write the output";
+      return false;
+    }
+  }
+  handle.close();
+
+  note(diag::incremental_patched) << patches.size() << numOfPatchedFiles
+                                  << output;
+  write(output);
+  return true;
+}
+
+/// diffObject - compare the object pFile to its record
+bool IncrementalLink::diffObject(FileRecord& pRecord,
+                                 llvm::StringRef pFile,
+                                 std::vector<Patch>& pPatches,
+                                 std::string& pReason) const {
+  ELFImage image;
+  if (!image.parse(pFile) || image.headerHash() != pRecord.hash ||
+      image.numOfSections() != pRecord.sections.size()) {
+    pReason = "the sections of `" + pRecord.path + "' changed";
+    return false;
+  }
+
+  std::vector<uint64_t> sites;
+  for (size_t idx = 0; idx < image.numOfSections(); ++idx) {
+    const ELFImage::Section& sect = image.getSection(idx);
+    SectionRecord& record = pRecord.sections[idx];
+    if (sect.size != record.size) {
+      pReason = "the size of a section of `" + pRecord.path +
+                "' changed, and only same-size changes are patched";
+      return false;
+    }
+    if (sect.header != record.header) {
+      pReason = "the sections of `" + pRecord.path + "' changed";
+      return false;
+    }
+
+    llvm::StringRef contents = image.getContents(idx);
+    uint64_t hash = Hash(contents);
+    if (hash == record.content)
+      continue;
+
+    switch (record.state) {
+      case Dropped:
+        break;
+      case Patchable:
+        image.getRelocSites(idx, sites);
+        if (HashWindows(contents, sites) != record.windows) {
+          pReason = "the relocated bytes of `" + pRecord.path + "' changed";
+          return false;
+        }
+        pPatches.push_back(Patch());
+        pPatches.back().outOffset = record.outOffset;
+        pPatches.back().contents = contents;
+        pPatches.back().sites.swap(sites);
+        break;
+      default:
+        pReason = "the symbols, relocations or layout of `" + pRecord.path +
+                  "' changed";
+        return false;
+    }
+    record.content = hash;
+  }
+  return true;
+}
+
+/// collectRegions - record the region fragment of every input section
+void IncrementalLink::collectRegions() {
+  Module::const_obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    const LDContext* context = (*obj)->context();
+    if (context == NULL || (*obj)->fileOffset() != 0)
+      continue;
+    LDContext::const_sect_iterator sect, sectEnd = context->sectEnd();
+    for (sect = context->sectBegin(); sect != sectEnd; ++sect) {
+      if (*sect == NULL || !(*sect)->hasSectionData() ||
+          (*sect)->getSectionData()->size() != 1)
+        continue;
+      const RegionFragment* region =
+          llvm::dyn_cast<RegionFragment>(&(*sect)->getSectionData()->front());
+      if (region != NULL)
+        m_Regions[*sect] = region;
+    }
+  }
+}
+
+/// getOutputOffset - get the output offset of the input section pSection
+/// if the section is copied to the output as it is
+bool IncrementalLink::getOutputOffset(const LDSection& pSection,
+                                      uint64_t pSize,
+                                      const FileOutputBuffer& pOutput,
+                                      uint64_t& pOffset) const {
+  if (GeneralOptions::ICF_None != m_Config.options().getICFMode())
+    return false;
+
+  switch (pSection.kind()) {
+    case LDFileFormat::TEXT:
+    case LDFileFormat::DATA:
+    case LDFileFormat::Debug:
+    case LDFileFormat::GCCExceptTable:
+      break;
+    default:
+      return false;
+  }
+  if (llvm::ELF::SHT_PROGBITS != pSection.type() ||
+      (pSection.flag() & (llvm::ELF::SHF_MERGE | ELF::SHF_COMPRESSED)) != 0)
+    return false;
+
+  RegionMap::const_iterator entry = m_Regions.find(&pSection);
+  if (entry == m_Regions.end())
+    return false;
+  const RegionFragment* region = entry->second;
+  if (region->getRegion().size() != pSize || region->getParent() == NULL)
+    return false;
+
+  const LDSection& output = region->getParent()->getSection();
+  if (llvm::ELF::SHT_NOBITS == output.type() ||
+      (output.flag() & ELF::SHF_COMPRESSED) != 0)
+    return false;
+
+  pOffset = output.offset() + region->getOffset();
+  return pOffset + pSize <= pOutput.getBufferSize();
+}
+
+/// record - record the state of the link emitted to pOutput
+void IncrementalLink::record(FileOutputBuffer& pOutput) {
+  m_Files.clear();
+
+  std::map<std::string, const Input*> objects;
+  Module::const_obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    if ((*obj)->context() != NULL && (*obj)->fileOffset() == 0)
+      objects[(*obj)->path().native()] = *obj;
+  }
+
+  // every file read by the link: the inputs on the command line, and those
+  // added by scripts and groups. The members of an archive are in the file
+  // of the archive.
+  std::vector<std::string> paths;
+  InputTree::const_dfs_iterator input,
+      inEnd = m_Module.getInputTree().dfs_end();
+  for (input = m_Module.getInputTree().dfs_begin(); input != inEnd; ++input) {
+    if ((*input)->fileOffset() == 0)
+      paths.push_back((*input)->path().native());
+  }
+  collectExtraFiles(paths);
+
+  std::set<std::string> recorded;
+  std::vector<std::string>::const_iterator path, pathEnd = paths.end();
+  for (path = paths.begin(); path != pathEnd; ++path) {
+    if (!recorded.insert(*path).second)
+      continue;
+    std::map<std::string, const Input*>::const_iterator object =
+        objects.find(*path);
+    recordFile(*path,
+               (object == objects.end()) ? NULL : object->second,
+               pOutput);
+  }
+}
+
+/// recordFile - fingerprint the input pPath, which is read as pObject if
+/// it is a relocatable object
+void IncrementalLink::recordFile(const std::string& pPath,
+                                 const Input* pObject,
+                                 FileOutputBuffer& pOutput) {
+  sys::fs::FileStatus status;
+  sys::fs::detail::status(sys::fs::Path(pPath), status);
+  std::unique_ptr<llvm::MemoryBuffer> buffer;
+  if (sys::fs::RegularFile == status.type())
+    buffer = ReadFile(pPath);
+  // a file that cannot be fingerprinted never matches its record
+  if (!buffer) {
+    status.setSize(0);
+    status.setModTime(0);
+  }
+
+  m_Files.push_back(FileRecord());
+  FileRecord& file = m_Files.back();
+  file.path = pPath;
+  file.size = status.size();
+  file.modTime = StoredModTime(status);
+  file.inode = status.inode();
+  file.hash = 0;
+  file.flags = 0x0;
+  if (!buffer)
+    return;
+
+  ELFImage image;
+  if (pObject == NULL || !image.parse(buffer->getBuffer())) {
+    file.hash = Hash(buffer->getBuffer());
+    return;
+  }
+
+  file.flags |= ELFObject;
+  file.hash = image.headerHash();
+  file.sections.resize(image.numOfSections());
+  const LDContext* context = pObject->context();
+  std::vector<uint64_t> sites;
+  for (size_t idx = 0; idx < image.numOfSections(); ++idx) {
+    const ELFImage::Section& sect = image.getSection(idx);
+    llvm::StringRef contents = image.getContents(idx);
+    SectionRecord& record = file.sections[idx];
+    record.header = sect.header;
+    record.content = Hash(contents);
+    record.windows = 0;
+    record.outOffset = 0;
+    record.size = sect.size;
+    record.state = Fixed;
+    record.padding = 0;
+
+    const LDSection* section =
+        (idx < context->numOfSections()) ? context->getSection(idx) : NULL;
+    if (section == NULL)
+      continue;
+
+    if (LDFileFormat::Ignore == section->kind()) {
+      record.state = Dropped;
+      continue;
+    }
+
+    uint64_t offset = 0;
+    if (!getOutputOffset(*section, contents.size(), pOutput, offset))
+      continue;
+
+    // the linker must not have rewritten anything but the relocation sites
+    image.getRelocSites(idx, sites);
+    if (!IsCopied(contents, pOutput.getBufferStart() + offset, sites))
+      continue;
+
+    record.state = Patchable;
+    record.outOffset = offset;
+    record.windows = HashWindows(contents, sites);
+  }
+}
+
+bool IncrementalLink::readState(llvm::StringRef pState,
+                                StateHeader& pHeader,
+                                FileList& pFiles) const {
+  const char* data = pState.data();
+  size_t size = pState.size();
+  if (size < sizeof(StateHeader))
+    return false;
+  memcpy(&pHeader, data, sizeof(StateHeader));
+  if (memcmp(pHeader.magic, StateMagic, sizeof(StateMagic)) != 0)
+    return false;
+
+  uint64_t pos = sizeof(StateHeader) + Align8(pHeader.keySize);
+  for (uint32_t i = 0; i < pHeader.numOfFiles; ++i) {
+    if (pos + sizeof(FileHeader) > size)
+      return false;
+    FileHeader header;
+    memcpy(&header, data + pos, sizeof(FileHeader));
+    pos += sizeof(FileHeader);
+
+    uint64_t sections = pos + Align8(header.pathSize);
+    uint64_t end =
+        sections + uint64_t(header.numOfSections) * sizeof(SectionRecord);
+    if (end > size)
+      return false;
+
+    pFiles.push_back(FileRecord());
+    FileRecord& file = pFiles.back();
+    file.path.assign(data + pos, header.pathSize);
+    file.size = header.size;
+    file.modTime = header.modTime;
+    file.inode = header.inode;
+    file.hash = header.hash;
+    file.flags = header.flags;
+    file.sections.resize(header.numOfSections);
+    if (header.numOfSections != 0)
+      memcpy(&file.sections[0], data + sections, end - sections);
+    pos = end;
+  }
+  return pos == size;
+}
+
+/// write - write the recorded state for the output file pPath
+bool IncrementalLink::write(const std::string& pPath) const {
+  sys::fs::FileStatus status;
+  sys::fs::detail::status(sys::fs::Path(pPath), status);
+  if (sys::fs::RegularFile != status.type())
+    return false;
+
+  const std::string& key = m_Config.options().incrementalKey();
+  StateHeader header;
+  memcpy(header.magic, StateMagic, sizeof(StateMagic));
+  header.inputs = m_Inputs;
+  header.outSize = status.size();
+  header.outModTime = status.modTime();
+  header.outInode = status.inode();
+  header.keySize = key.size();
+  header.numOfFiles = m_Files.size();
+
+  // write to a temporary file, and then rename it to the state
+  std::string state = getStatePath(pPath);
+  char suffix[32];
+  snprintf(suffix,
+           sizeof(suffix),
+           ".%lx.tmp",
+           static_cast<unsigned long>(sys::GetRandomNum()));
+  std::string temp = state + suffix;
+
+  std::error_code error;
+  llvm::raw_fd_ostream os(temp.c_str(), error, llvm::sys::fs::F_None);
+  if (!error) {
+    const char zeros[8] = {0};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os << key;
+    os.write(zeros, Align8(key.size()) - key.size());
+
+    FileList::const_iterator file, fileEnd = m_Files.end();
+    for (file = m_Files.begin(); file != fileEnd; ++file) {
+      FileHeader entry;
+      entry.size = file->size;
+      entry.modTime = file->modTime;
+      entry.inode = file->inode;
+      entry.hash = file->hash;
+      entry.pathSize = file->path.size();
+      entry.numOfSections = file->sections.size();
+      entry.flags = file->flags;
+      entry.padding = 0;
+      os.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+      os << file->path;
+      os.write(zeros, Align8(file->path.size()) - file->path.size());
+      if (!file->sections.empty())
+        os.write(reinterpret_cast<const char*>(&file->sections[0]),
+                 file->sections.size() * sizeof(SectionRecord));
+    }
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      error = std::make_error_code(std::errc::io_error);
+    } else {
+      error = llvm::sys::fs::rename(temp, state);
+    }
+  }
+
+  if (error) {
+    llvm::sys::fs::remove(temp);
+    warning(diag::warn_cannot_write_incremental_state) << state
+                                                       << error.message();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace mcld
@@ -0,0 +1,181 @@
+//===- LinkStatistics.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Object/LinkStatistics.h"
+
+#include "mcld/Module.h"
+#include "mcld/LD/LDContext.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/RelocData.h"
+#include "mcld/LD/SectionData.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/SystemUtils.h"
+#include "mcld/Support/raw_ostream.h"
+
+#include <llvm/Support/Format.h>
+
+#include <cassert>
+#include <system_error>
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// Helper functions
+//===----------------------------------------------------------------------===//
+static void CountSection(const LDSection& pSection,
+                         size_t& pFragments,
+                         size_t& pRelocations) {
+  if (pSection.hasSectionData())
+    pFragments += pSection.getSectionData()->size();
+  else if (pSection.hasRelocData())
+    pRelocations += pSection.getRelocData()->size();
+}
+
+//===----------------------------------------------------------------------===//
+// LinkStatistics::Phase
+//===----------------------------------------------------------------------===//
+LinkStatistics::Phase::Phase(LinkStatistics* pStatistics, const char* pName)
+    : m_pStatistics(pStatistics) {
+  if (m_pStatistics != NULL)
+    m_pStatistics->start(pName);
+}
+
+LinkStatistics::Phase::~Phase() {
+  if (m_pStatistics != NULL)
+    m_pStatistics->stop();
+}
+
+//===----------------------------------------------------------------------===//
+// LinkStatistics
+//===----------------------------------------------------------------------===//
+LinkStatistics::LinkStatistics(const Module& pModule)
+    : m_Module(pModule),
+      m_Origin(sys::GetWallClockTime()) {
+}
+
+void LinkStatistics::start(const char* pName) {
+  Record record;
+  record.name = pName;
+  record.depth = m_Running.size();
+  record.start = sys::GetWallClockTime();
+  record.cpuStart = sys::GetProcessCPUTime();
+  record.wallTime = 0;
+  record.cpuTime = 0;
+  record.peakRSS = 0;
+  record.numInputs = 0;
+  record.numSections = 0;
+  record.numFragments = 0;
+  record.numSymbols = 0;
+  record.numRelocations = 0;
+  m_Running.push_back(m_Records.size());
+  m_Records.push_back(record);
+}
+
+void LinkStatistics::stop() {
+  assert(!m_Running.empty() && "stop() without start()!");
+  Record& record = m_Records[m_Running.back()];
+  m_Running.pop_back();
+  record.wallTime = sys::GetWallClockTime() - record.start;
+  record.cpuTime = sys::GetProcessCPUTime() - record.cpuStart;
+  record.peakRSS = sys::GetPeakMemoryUsage();
+  count(record);
+}
+
+void LinkStatistics::count(Record& pRecord) const {
+  pRecord.numInputs =
+      m_Module.getObjectList().size() + m_Module.getLibraryList().size();
+
+  // Fragments are spliced from input sections into output sections, so every
+  // fragment is counted exactly once by summing both sides.
+  Module::const_obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    const LDContext* context = (*obj)->context();
+    if (context == NULL)
+      continue;
+    pRecord.numSections += context->numOfSections();
+    LDContext::const_sect_iterator sect, sectEnd = context->sectEnd();
+    for (sect = context->sectBegin(); sect != sectEnd; ++sect) {
+      if (*sect != NULL)
+        CountSection(**sect, pRecord.numFragments, pRecord.numRelocations);
+    }
+  }
+
+  pRecord.numSections += m_Module.size();
+  Module::const_iterator out, outEnd = m_Module.end();
+  for (out = m_Module.begin(); out != outEnd; ++out)
+    CountSection(**out, pRecord.numFragments, pRecord.numRelocations);
+
+  pRecord.numSymbols = m_Module.getNamePool().size();
+}
+
+void LinkStatistics::print(llvm::raw_ostream& pOS) const {
+  pOS << "phase                      wall(ms)    cpu(ms)    rss(MB)   inputs"
+         "   sections  fragments    symbols     relocs\n";
+
+  uint64_t total_wall = 0, total_cpu = 0, peak_rss = 0;
+  const_iterator record, recordEnd = end();
+  for (record = begin(); record != recordEnd; ++record) {
+    pOS << llvm::format(
+        "%-24s %10.3f %10.3f %10.1f %8u %10u %10u %10u %10u\n",
+        record->name.c_str(),
+        record->wallTime / 1000.0,
+        record->cpuTime / 1000.0,
+        record->peakRSS / (1024.0 * 1024.0),
+        static_cast<unsigned>(record->numInputs),
+        static_cast<unsigned>(record->numSections),
+        static_cast<unsigned>(record->numFragments),
+        static_cast<unsigned>(record->numSymbols),
+        static_cast<unsigned>(record->numRelocations));
+    if (record->depth == 0) {
+      total_wall += record->wallTime;
+      total_cpu += record->cpuTime;
+    }
+    if (record->peakRSS > peak_rss)
+      peak_rss = record->peakRSS;
+  }
+
+  pOS << llvm::format("total                    %10.3f %10.3f %10.1f\n",
+                      total_wall / 1000.0,
+                      total_cpu / 1000.0,
+                      peak_rss / (1024.0 * 1024.0));
+}
+
+bool LinkStatistics::writeTimeTrace(const std::string& pPath) const {
+  std::error_code error;
+  mcld::raw_fd_ostream os(pPath.c_str(), error, llvm::sys::fs::F_Text);
+  if (error) {
+    warning(diag::warn_cannot_write_time_trace) << pPath << error.message();
+    return false;
+  }
+
+  // Chrome trace-event format, one complete ("X") event per phase. Time
+  // stamps are relative to the creation of this LinkStatistics.
+  os << "{\"traceEvents\":[\n";
+  const_iterator record, recordEnd = end();
+  for (record = begin(); record != recordEnd; ++record) {
+    if (record != begin())
+      os << ",\n";
+    os << "{\"name\":\"" << record->name << "\",\"cat\":\"mcld\""
+       << ",\"ph\":\"X\",\"pid\":1,\"tid\":0"
+       << ",\"ts\":" << (record->start - m_Origin)
+       << ",\"dur\":" << record->wallTime
+       << ",\"args\":{"
+       << "\"cpu_us\":" << record->cpuTime
+       << ",\"peak_rss\":" << record->peakRSS
+       << ",\"inputs\":" << record->numInputs
+       << ",\"sections\":" << record->numSections
+       << ",\"fragments\":" << record->numFragments
+       << ",\"symbols\":" << record->numSymbols
+       << ",\"relocations\":" << record->numRelocations << "}}";
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return true;
+}
+
+}  // namespace mcld
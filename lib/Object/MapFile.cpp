@@ -0,0 +1,209 @@
+//===- MapFile.cpp --------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Object/MapFile.h"
+
+#include "mcld/LinkerConfig.h"
+#include "mcld/LinkerScript.h"
+#include "mcld/Module.h"
+#include "mcld/Fragment/Fragment.h"
+#include "mcld/Fragment/FragmentRef.h"
+#include "mcld/LD/LDContext.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/LDSymbol.h"
+#include "mcld/LD/ResolveInfo.h"
+#include "mcld/LD/SectionData.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Object/SectionMap.h"
+#include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/raw_ostream.h"
+
+#include <llvm/Support/Format.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <system_error>
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// Helper functions
+//===----------------------------------------------------------------------===//
+/// PrintName - print pName in a column of pWidth characters. A longer name is
+/// put on a line of its own, as GNU ld does.
+static void PrintName(const std::string& pName,
+                      size_t pWidth,
+                      llvm::raw_ostream& pOS) {
+  pOS << pName;
+  if (pName.size() < pWidth)
+    pOS.indent(pWidth - pName.size());
+  else
+    pOS << "\n" << std::string(pWidth, ' ');
+}
+
+/// PrintSize - print pSize in hex, right-aligned in 10 characters
+static void PrintSize(uint64_t pSize, llvm::raw_ostream& pOS) {
+  char buf[32];
+  int len = snprintf(buf, sizeof(buf), "0x%llx",
+                     static_cast<unsigned long long>(pSize));
+  if (len < 10)
+    pOS.indent(10 - len);
+  pOS << buf;
+}
+
+/// PrintInput - print the file name of pInput, in the form archive(member)
+/// for a member of an archive.
+static void PrintInput(const Input& pInput, llvm::raw_ostream& pOS) {
+  if (pInput.fileOffset() != 0)
+    pOS << pInput.path().native() << "(" << pInput.name() << ")";
+  else
+    pOS << pInput.path().native();
+}
+
+namespace {
+
+struct SymbolValueCompare {
+  bool operator()(const LDSymbol* pX, const LDSymbol* pY) const {
+    return pX->value() < pY->value();
+  }
+};
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// MapFile
+//===----------------------------------------------------------------------===//
+MapFile::MapFile(const LinkerConfig& pConfig, const Module& pModule)
+    : m_Config(pConfig), m_Module(pModule) {
+}
+
+void MapFile::collectInputs() {
+  Module::const_obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    const LDContext* context = (*obj)->context();
+    if (context == NULL)
+      continue;
+    LDContext::const_sect_iterator sect, sectEnd = context->sectEnd();
+    for (sect = context->sectBegin(); sect != sectEnd; ++sect) {
+      if (*sect == NULL || !(*sect)->hasSectionData() ||
+          (*sect)->getSectionData()->empty())
+        continue;
+      const Fragment* first = &(*sect)->getSectionData()->front();
+      m_Inputs[first] = std::make_pair(*obj, *sect);
+    }
+  }
+}
+
+void MapFile::collectSymbols(SymbolMap& pSymbols) const {
+  Module::const_sym_iterator sym, symEnd = m_Module.sym_end();
+  for (sym = m_Module.sym_begin(); sym != symEnd; ++sym) {
+    const ResolveInfo* info = (*sym)->resolveInfo();
+    if (info == NULL || !(info->isGlobal() || info->isWeak()) ||
+        !info->isDefine() || ResolveInfo::Section == info->type() ||
+        !(*sym)->hasFragRef())
+      continue;
+    pSymbols[(*sym)->fragRef()->frag()].push_back(*sym);
+  }
+
+  SymbolMap::iterator bucket, bucketEnd = pSymbols.end();
+  for (bucket = pSymbols.begin(); bucket != bucketEnd; ++bucket) {
+    std::stable_sort(bucket->second.begin(),
+                     bucket->second.end(),
+                     SymbolValueCompare());
+  }
+}
+
+void MapFile::printAddress(uint64_t pAddr, llvm::raw_ostream& pOS) const {
+  if (m_Config.targets().bitclass() == 32)
+    pOS << llvm::format("0x%08llx", static_cast<unsigned long long>(pAddr));
+  else
+    pOS << llvm::format("0x%016llx", static_cast<unsigned long long>(pAddr));
+}
+
+void MapFile::printSection(const LDSection& pSection,
+                           const SymbolMap& pSymbols,
+                           llvm::raw_ostream& pOS) const {
+  pOS << "\n";
+  PrintName(pSection.name(), 16, pOS);
+  printAddress(pSection.addr(), pOS);
+  pOS << " ";
+  PrintSize(pSection.size(), pOS);
+  pOS << "\n";
+
+  if (!pSection.hasSectionData())
+    return;
+  const SectionData* data = pSection.getSectionData();
+
+  // The size of an input section is the distance to the start of the next
+  // one, so the padding between them is counted in the former.
+  std::vector<uint64_t> starts;
+  SectionData::const_iterator frag, fragEnd = data->end();
+  for (frag = data->begin(); frag != fragEnd; ++frag) {
+    if (m_Inputs.find(&*frag) != m_Inputs.end())
+      starts.push_back(frag->getOffset());
+  }
+  starts.push_back(pSection.size());
+
+  size_t next = 0;
+  for (frag = data->begin(); frag != fragEnd; ++frag) {
+    InputMap::const_iterator input = m_Inputs.find(&*frag);
+    if (input != m_Inputs.end()) {
+      pOS << " ";
+      PrintName(input->second.second->name(), 15, pOS);
+      printAddress(pSection.addr() + starts[next], pOS);
+      pOS << " ";
+      PrintSize(starts[next + 1] - starts[next], pOS);
+      pOS << " ";
+      PrintInput(*input->second.first, pOS);
+      pOS << "\n";
+      ++next;
+    }
+
+    SymbolMap::const_iterator bucket = pSymbols.find(&*frag);
+    if (bucket == pSymbols.end())
+      continue;
+    SymbolList::const_iterator sym, symEnd = bucket->second.end();
+    for (sym = bucket->second.begin(); sym != symEnd; ++sym) {
+      pOS.indent(16);
+      printAddress((*sym)->value(), pOS);
+      pOS.indent(16);
+      pOS << (*sym)->name() << "\n";
+    }
+  }
+}
+
+void MapFile::print(llvm::raw_ostream& pOS) const {
+  SymbolMap symbols;
+  collectSymbols(symbols);
+
+  pOS << "\nLinker script and memory map\n";
+
+  // print the output sections in the order of layout
+  const SectionMap& sectionMap = m_Module.getScript().sectionMap();
+  SectionMap::const_iterator out, outEnd = sectionMap.end();
+  for (out = sectionMap.begin(); out != outEnd; ++out) {
+    const LDSection* sect = (*out)->getSection();
+    if (sect == NULL || LDFileFormat::Null == sect->kind())
+      continue;
+    printSection(*sect, symbols, pOS);
+  }
+  pOS.flush();
+}
+
+bool MapFile::write(const std::string& pPath) const {
+  std::error_code error;
+  mcld::raw_fd_ostream os(pPath.c_str(), error, llvm::sys::fs::F_Text);
+  if (error) {
+    warning(diag::warn_cannot_write_map_file) << pPath << error.message();
+    return false;
+  }
+  print(os);
+  return true;
+}
+
+}  // namespace mcld
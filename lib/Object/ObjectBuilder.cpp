@@ -18,12 +18,103 @@
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/LD/SectionOrdering.h"
+#include "mcld/MC/Input.h"
 #include "mcld/Object/SectionMap.h"
 
+#include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
 
+#include <algorithm>
+
 namespace mcld {
 
+//===----------------------------------------------------------------------===//
+// Helper functions
+//===----------------------------------------------------------------------===//
+/// GetInitPriority - get the priority of .init_array.N, .fini_array.N,
+/// .ctors.N and .dtors.N. Sections without the numeric suffix have the
+/// default priority 65536 and are placed after all prioritized ones.
+static uint64_t GetInitPriority(llvm::StringRef pName) {
+  size_t pos = pName.rfind('.');
+  if (pos == llvm::StringRef::npos || pos == 0)
+    return 65536;
+
+  uint64_t priority = 0;
+  if (pName.substr(pos + 1).getAsInteger(10, priority))
+    return 65536;
+
+  // .ctors and .dtors are executed in the reverse order. Their priorities
+  // are at most 65535; larger ones are clamped instead of wrapping around.
+  if (pName.startswith(".ctors.") || pName.startswith(".dtors."))
+    return 65535 - std::min<uint64_t>(priority, 65535);
+  return priority;
+}
+
+/** \class SortEntryCompare
+ *  \brief the strict weak ordering of SORT_* policies in linker scripts
+ */
+class SortEntryCompare {
+ public:
+  explicit SortEntryCompare(bool pSortFiles) : m_bSortFiles(pSortFiles) {}
+
+  bool operator()(const SectionMap::Input::SortEntry& pX,
+                  const SectionMap::Input::SortEntry& pY) const {
+    if (m_bSortFiles) {
+      int res = pX.file->name().compare(pY.file->name());
+      if (res != 0)
+        return res < 0;
+    }
+
+    // both sections are matched by the same description. The sections of an
+    // earlier pattern go first, and the sections of a pattern are ordered by
+    // the policy of that pattern, so the ordering stays strict weak when the
+    // patterns have different policies.
+    if (pX.pattern != pY.pattern)
+      return pX.pattern < pY.pattern;
+
+    switch (pX.policy) {
+      case WildcardPattern::SORT_BY_NAME:
+        return pX.section->name() < pY.section->name();
+      case WildcardPattern::SORT_BY_ALIGNMENT:
+        return pX.section->align() > pY.section->align();
+      case WildcardPattern::SORT_BY_NAME_ALIGNMENT:
+        if (pX.section->name() != pY.section->name())
+          return pX.section->name() < pY.section->name();
+        return pX.section->align() > pY.section->align();
+      case WildcardPattern::SORT_BY_ALIGNMENT_NAME:
+        if (pX.section->align() != pY.section->align())
+          return pX.section->align() > pY.section->align();
+        return pX.section->name() < pY.section->name();
+      case WildcardPattern::SORT_BY_INIT_PRIORITY:
+        return GetInitPriority(pX.section->name()) <
+               GetInitPriority(pY.section->name());
+      case WildcardPattern::SORT_NONE:
+      default:
+        return false;
+    }
+  }
+
+ private:
+  bool m_bSortFiles;
+};
+
+/** \class IsOrderedEntry
+ *  \brief whether a deferred section is placed by the section ordering
+ */
+class IsOrderedEntry {
+ public:
+  explicit IsOrderedEntry(const SectionOrdering& pOrdering)
+      : m_Ordering(pOrdering) {}
+
+  bool operator()(const SectionMap::Input::SortEntry& pEntry) const {
+    return m_Ordering.isOrdered(*pEntry.section);
+  }
+
+ private:
+  const SectionOrdering& m_Ordering;
+};
+
 //===----------------------------------------------------------------------===//
 // ObjectBuilder
 //===----------------------------------------------------------------------===//
@@ -46,7 +137,7 @@ LDSection* ObjectBuilder::CreateSection(const std::string& pName,
   if (output_sect == NULL) {
     output_sect = LDSection::Create(pName, pKind, pType, pFlag);
     output_sect->setAlign(pAlign);
-    m_Module.getSectionTable().push_back(output_sect);
+    m_Module.addSection(*output_sect);
   }
   return output_sect;
 }
@@ -72,7 +163,7 @@ LDSection* ObjectBuilder::MergeSection(const Input& pInputFile,
                                pInputSection.type(),
                                pInputSection.flag());
     target->setAlign(pInputSection.align());
-    m_Module.getSectionTable().push_back(target);
+    m_Module.addSection(*target);
   }
 
   switch (target->kind()) {
@@ -111,6 +202,19 @@ LDSection* ObjectBuilder::MergeSection(const Input& pInputFile,
         if (pair.first->prolog().hasSubAlign()) {
           pInputSection.setAlign(pair.second->getSection()->align());
         }
+
+        // defer the merge until all matched sections are known, and then
+        // SortSections() moves them in order.
+        if (pair.second->needSort()) {
+          SectionMap::Input::SortEntry entry;
+          entry.file = &pInputFile;
+          entry.section = &pInputSection;
+          entry.policy = m_Module.getScript().sectionMap().sortPolicy(
+              *pair.second, pInputSection.name(), entry.pattern);
+          pair.second->sortList().push_back(entry);
+          UpdateSectionAlign(*target, pInputSection);
+          return target;
+        }
       } else {
         // orphan section
         data = target->getSectionData();
@@ -126,6 +230,30 @@ LDSection* ObjectBuilder::MergeSection(const Input& pInputFile,
   return target;
 }
 
+/// SortSections - sort the deferred input sections of pInput and move them
+void ObjectBuilder::SortSections(SectionMap::Input& pInput,
+                                 const SectionOrdering* pOrdering) {
+  SectionMap::Input::SortList& list = pInput.sortList();
+  if (list.empty())
+    return;
+
+  // MergeSection() is called for the ordered sections first, so they are at
+  // the beginning of the list in the order of pOrdering. Keep them there.
+  SectionMap::Input::SortList::iterator unordered = list.begin();
+  if (pOrdering != NULL)
+    unordered = std::stable_partition(list.begin(), list.end(),
+                                      IsOrderedEntry(*pOrdering));
+
+  std::stable_sort(unordered, list.end(),
+                   SortEntryCompare(pInput.sortFiles()));
+
+  SectionData* data = pInput.getSection()->getSectionData();
+  SectionMap::Input::SortList::iterator entry, entryEnd = list.end();
+  for (entry = list.begin(); entry != entryEnd; ++entry)
+    MoveSectionData(*entry->section->getSectionData(), *data);
+  list.clear();
+}
+
 /// MoveSectionData - move the fragments of pTO section data to pTo
 bool ObjectBuilder::MoveSectionData(SectionData& pFrom, SectionData& pTo) {
   assert(&pFrom != &pTo && "Cannot move section data to itself!");
@@ -31,21 +31,35 @@
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/LD/SectionOrdering.h"
+#include "mcld/LD/StubFactory.h"
+#include "mcld/Object/LinkStatistics.h"
+#include "mcld/Object/MapFile.h"
 #include "mcld/Object/ObjectBuilder.h"
 #include "mcld/Script/Assignment.h"
 #include "mcld/Script/Operand.h"
 #include "mcld/Script/RpnEvaluator.h"
 #include "mcld/Script/ScriptFile.h"
 #include "mcld/Script/ScriptReader.h"
+#include "mcld/Support/Compression.h"
+#include "mcld/Support/ELF.h"
 #include "mcld/Support/FileOutputBuffer.h"
+#include "mcld/Support/MemoryPool.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Support/RealPath.h"
+#include "mcld/Support/raw_ostream.h"
 #include "mcld/Target/TargetLDBackend.h"
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
+#include <llvm/Support/Format.h>
 #include <llvm/Support/Host.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <system_error>
+#include <vector>
 
 namespace mcld {
 
@@ -64,10 +78,14 @@ ObjectLinker::ObjectLinker(const LinkerConfig& pConfig,
       m_pGroupReader(NULL),
       m_pBinaryReader(NULL),
       m_pScriptReader(NULL),
-      m_pWriter(NULL) {
+      m_pWriter(NULL),
+      m_pStatistics(NULL),
+      m_pMapFile(NULL) {
 }
 
 ObjectLinker::~ObjectLinker() {
+  if (m_pBuilder != NULL)
+    m_pBuilder->setDynObjReader(NULL);
   delete m_pObjectReader;
   delete m_pDynObjReader;
   delete m_pArchiveReader;
@@ -75,16 +93,32 @@ ObjectLinker::~ObjectLinker() {
   delete m_pBinaryReader;
   delete m_pScriptReader;
   delete m_pWriter;
+  delete m_pStatistics;
+  delete m_pMapFile;
 }
 
 bool ObjectLinker::initialize(Module& pModule, IRBuilder& pBuilder) {
   m_pModule = &pModule;
   m_pBuilder = &pBuilder;
 
+  // per-phase statistics are only recorded on request
+  if (m_Config.options().printStats() || m_Config.options().hasTimeTrace())
+    m_pStatistics = new LinkStatistics(*m_pModule);
+
+  // the link map is only built on request
+  if (m_Config.options().printMap() || m_Config.options().hasMapFile())
+    m_pMapFile = new MapFile(m_Config, *m_pModule);
+
   // initialize the readers and writers
+  // the archive reader asks the dynamic object reader for the symbols of the
+  // lazily read dynamic objects
   m_pObjectReader = m_LDBackend.createObjectReader(*m_pBuilder);
-  m_pArchiveReader = m_LDBackend.createArchiveReader(*m_pModule);
   m_pDynObjReader = m_LDBackend.createDynObjReader(*m_pBuilder);
+  // the symbols defined by the linker are looked up in the lazily read
+  // dynamic objects as well
+  if (m_Config.options().lazySharedSymbols())
+    m_pBuilder->setDynObjReader(m_pDynObjReader);
+  m_pArchiveReader = m_LDBackend.createArchiveReader(*m_pModule);
   m_pBinaryReader = m_LDBackend.createBinaryReader(*m_pBuilder);
   m_pGroupReader = new GroupReader(*m_pModule,
                                    *m_pObjectReader,
@@ -103,6 +137,8 @@ bool ObjectLinker::initialize(Module& pModule, IRBuilder& pBuilder) {
 
 /// initStdSections - initialize standard sections
 bool ObjectLinker::initStdSections() {
+  LinkStatistics::Phase phase(m_pStatistics, "initStdSections");
+
   ObjectBuilder builder(*m_pModule);
 
   // initialize standard sections
@@ -116,6 +152,8 @@ bool ObjectLinker::initStdSections() {
 }
 
 void ObjectLinker::addUndefinedSymbols() {
+  LinkStatistics::Phase phase(m_pStatistics, "addUndefinedSymbols");
+
   // Add the symbol set by -u as an undefind global symbol into symbol pool
   GeneralOptions::const_undef_sym_iterator usym;
   GeneralOptions::const_undef_sym_iterator usymEnd =
@@ -144,6 +182,8 @@ void ObjectLinker::addUndefinedSymbols() {
 }
 
 void ObjectLinker::normalize() {
+  LinkStatistics::Phase phase(m_pStatistics, "normalize");
+
   // -----  set up inputs  ----- //
   Module::input_iterator input, inEnd = m_pModule->input_end();
   for (input = m_pModule->input_begin(); input != inEnd; ++input) {
@@ -224,6 +264,9 @@ void ObjectLinker::normalize() {
             << (*input)->path() << m_Config.targets().triple().str();
     }
   }  // end of for
+
+  // read the symbols of the lazily read dynamic objects that are needed
+  getDynObjReader()->resolveSymbols();
 }
 
 bool ObjectLinker::linkable() const {
@@ -262,6 +305,8 @@ bool ObjectLinker::linkable() const {
 }
 
 void ObjectLinker::dataStrippingOpt() {
+  LinkStatistics::Phase phase(m_pStatistics, "dataStrippingOpt");
+
   if (m_Config.codeGenType() == LinkerConfig::Object) {
     return;
   }
@@ -284,6 +329,8 @@ void ObjectLinker::dataStrippingOpt() {
 ///
 /// All symbols should be read and resolved before this function.
 bool ObjectLinker::readRelocations() {
+  LinkStatistics::Phase phase(m_pStatistics, "readRelocations");
+
   // Bitcode is read by the other path. This function reads relocation sections
   // in object files.
   mcld::InputTree::bfs_iterator input,
@@ -300,6 +347,12 @@ bool ObjectLinker::readRelocations() {
 
 /// mergeSections - put allinput sections into output sections
 bool ObjectLinker::mergeSections() {
+  LinkStatistics::Phase phase(m_pStatistics, "mergeSections");
+
+  // the input sections lose their fragments once they are merged
+  if (m_pMapFile != NULL)
+    m_pMapFile->collectInputs();
+
   // run the target-dependent hooks before merging sections
   m_LDBackend.preMergeSections(*m_pModule);
 
@@ -336,10 +389,33 @@ bool ObjectLinker::mergeSections() {
   }
 
   ObjectBuilder builder(*m_pModule);
+
+  // place the sections ordered by --symbol-ordering-file or
+  // --call-graph-profile-sort before the others
+  SectionOrdering ordering(m_Config, *m_pModule);
+  if (!ordering.run())
+    return false;
+
+  SectionOrdering::const_iterator entry, entryEnd = ordering.end();
+  for (entry = ordering.begin(); entry != entryEnd; ++entry) {
+    LDSection* out_sect = NULL;
+    if ((out_sect = builder.MergeSection(*entry->first, *entry->second)) !=
+        NULL) {
+      if (!m_LDBackend.updateSectionFlags(*out_sect, *entry->second)) {
+        error(diag::err_cannot_merge_section) << entry->second->name()
+                                              << entry->first->name();
+        return false;
+      }
+    }
+  }
+
   Module::obj_iterator obj, objEnd = m_pModule->obj_end();
   for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
     LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
     for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      if (ordering.isOrdered(**sect))
+        continue;  // already merged
+
       switch ((*sect)->kind()) {
         // Some *INPUT sections should not be merged.
         case LDFileFormat::Folded:
@@ -414,6 +490,10 @@ bool ObjectLinker::mergeSections() {
       inEnd = (*out)->end();
 
       for (in = inBegin; in != inEnd; ++in) {
+        // honor SORT_BY_NAME, SORT_BY_ALIGNMENT and SORT_BY_INIT_PRIORITY
+        // and keep the sections placed by the section ordering in front
+        ObjectBuilder::SortSections(**in, &ordering);
+
         LDSection* in_sect = (*in)->getSection();
         if (builder.MoveSectionData(*in_sect->getSectionData(),
                                     *out_sect->getSectionData())) {
@@ -477,6 +557,8 @@ void ObjectLinker::addSymbolToOutput(ResolveInfo& pInfo, Module& pModule) {
 }
 
 void ObjectLinker::addSymbolsToOutput(Module& pModule) {
+  LinkStatistics::Phase phase(m_pStatistics, "addSymbolsToOutput");
+
   // Traverse all the free ResolveInfo and add the output symobols to output
   NamePool::freeinfo_iterator free_it,
       free_end = pModule.getNamePool().freeinfo_end();
@@ -497,6 +579,8 @@ void ObjectLinker::addSymbolsToOutput(Module& pModule) {
 ///   @return if there are some input symbols with the same name to the
 ///   standard symbols, return false
 bool ObjectLinker::addStandardSymbols() {
+  LinkStatistics::Phase phase(m_pStatistics, "addStandardSymbols");
+
   // create and add section symbols for each output section
   Module::iterator iter, iterEnd = m_pModule->end();
   for (iter = m_pModule->begin(); iter != iterEnd; ++iter) {
@@ -511,6 +595,8 @@ bool ObjectLinker::addStandardSymbols() {
 ///   @return if there are some input symbols with the same name to the
 ///   target symbols, return false
 bool ObjectLinker::addTargetSymbols() {
+  LinkStatistics::Phase phase(m_pStatistics, "addTargetSymbols");
+
   m_LDBackend.initTargetSymbols(*m_pBuilder, *m_pModule);
   return true;
 }
@@ -518,6 +604,8 @@ bool ObjectLinker::addTargetSymbols() {
 /// addScriptSymbols - define symbols from the command line option or linker
 /// scripts.
 bool ObjectLinker::addScriptSymbols() {
+  LinkStatistics::Phase phase(m_pStatistics, "addScriptSymbols");
+
   LinkerScript& script = m_pModule->getScript();
   LinkerScript::Assignments::iterator it, ie = script.assignments().end();
   // go through the entire symbol assignments
@@ -578,11 +666,30 @@ bool ObjectLinker::addScriptSymbols() {
   return true;
 }
 
+/// isDiscardedReloc - whether the target symbol of pReloc is the section
+/// symbol of a discarded input section
+static bool isDiscardedReloc(const Relocation& pReloc) {
+  const ResolveInfo* info = pReloc.symInfo();
+  return !info->outSymbol()->hasFragRef() &&
+         ResolveInfo::Section == info->type() &&
+         ResolveInfo::Undefined == info->desc();
+}
+
 bool ObjectLinker::scanRelocations() {
+  LinkStatistics::Phase phase(m_pStatistics, "scanRelocations");
+
+  // The relocators reserve the GOT, PLT and dynamic relocation entries while
+  // scanning, so the inputs are scanned in order to keep the slots stable.
+  Relocator* relocator = m_LDBackend.getRelocator();
+  bool partial = (LinkerConfig::Object == m_Config.codeGenType());
+  relocator->resetScanCache();
+  if (!partial && relocator->hasSplitScan())
+    return splitScanRelocations();
+
   // apply all relocations of all inputs
   Module::obj_iterator input, inEnd = m_pModule->obj_end();
   for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
-    m_LDBackend.getRelocator()->initializeScan(**input);
+    relocator->initializeScan(**input);
     LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
     for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
       // bypass the reloc section if
@@ -597,29 +704,70 @@ bool ObjectLinker::scanRelocations() {
         Relocation* relocation = llvm::cast<Relocation>(reloc);
 
         // bypass the reloc if the symbol is in the discarded input section
-        ResolveInfo* info = relocation->symInfo();
-        if (!info->outSymbol()->hasFragRef() &&
-            ResolveInfo::Section == info->type() &&
-            ResolveInfo::Undefined == info->desc())
+        if (isDiscardedReloc(*relocation))
           continue;
 
         // scan relocation
-        if (LinkerConfig::Object != m_Config.codeGenType()) {
-          m_LDBackend.getRelocator()->scanRelocation(
+        if (!partial) {
+          relocator->scanRelocation(
               *relocation, *m_pBuilder, *m_pModule, **rs, **input);
         } else {
-          m_LDBackend.getRelocator()->partialScanRelocation(
-              *relocation, *m_pModule);
+          relocator->partialScanRelocation(*relocation, *m_pModule);
         }
       }  // for all relocations
     }    // for all relocation section
-    m_LDBackend.getRelocator()->finalizeScan(**input);
+    relocator->finalizeScan(**input);
   }  // for all inputs
   return true;
 }
 
+/// splitScanRelocations - scan the relocations in a decision pass and a
+/// reservation pass
+bool ObjectLinker::splitScanRelocations() {
+  Relocator* relocator = m_LDBackend.getRelocator();
+  relocator->prepareScan(*m_pModule);
+
+  // The decision pass only reads the IR, and every input has its own list of
+  // intents, so the inputs could be decided by different threads. There is
+  // no thread pool yet, so they are decided here one by one.
+  Module::ObjectList& inputs = m_pModule->getObjectList();
+  size_t numOfInputs = inputs.size();
+  std::vector<Relocator::ScanIntentList> intents(numOfInputs);
+  for (size_t idx = 0; idx < numOfInputs; ++idx) {
+    Input* input = inputs[idx];
+    uint64_t order = static_cast<uint64_t>(idx) << 32;
+    LDContext::sect_iterator rs, rsEnd = input->context()->relocSectEnd();
+    for (rs = input->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        Relocation* relocation = llvm::cast<Relocation>(reloc);
+        if (isDiscardedReloc(*relocation))
+          continue;
+        relocator->decideScan(*relocation, **rs, order++, intents[idx]);
+      }
+    }
+  }
+
+  // The reservation pass creates the entries in the input order, so the
+  // slots are the same as the single pass gives.
+  for (size_t idx = 0; idx < numOfInputs; ++idx) {
+    Input* input = inputs[idx];
+    relocator->initializeScan(*input);
+    Relocator::ScanIntentList::const_iterator intent,
+        intentEnd = intents[idx].end();
+    for (intent = intents[idx].begin(); intent != intentEnd; ++intent)
+      relocator->reserveScan(*intent, *m_pBuilder, *m_pModule, *input);
+    relocator->finalizeScan(*input);
+  }
+  return true;
+}
+
 /// initStubs - initialize stub-related stuff.
 bool ObjectLinker::initStubs() {
+  LinkStatistics::Phase phase(m_pStatistics, "initStubs");
+
   // initialize BranchIslandFactory
   m_LDBackend.initBRIslandFactory();
 
@@ -634,6 +782,8 @@ bool ObjectLinker::initStubs() {
 /// allocateCommonSymobols - allocate fragments for common symbols to the
 /// corresponding sections
 bool ObjectLinker::allocateCommonSymbols() {
+  LinkStatistics::Phase phase(m_pStatistics, "allocateCommonSymbols");
+
   if (LinkerConfig::Object != m_Config.codeGenType() ||
       m_Config.options().isDefineCommon())
     return m_LDBackend.allocateCommonSymbols(*m_pModule);
@@ -642,6 +792,8 @@ bool ObjectLinker::allocateCommonSymbols() {
 
 /// prelayout - help backend to do some modification before layout
 bool ObjectLinker::prelayout() {
+  LinkStatistics::Phase phase(m_pStatistics, "prelayout");
+
   // finalize the section symbols, set their fragment reference and push them
   // into output symbol table
   Module::iterator sect, sEnd = m_pModule->end();
@@ -696,12 +848,16 @@ bool ObjectLinker::prelayout() {
 ///   if there is a branch can not jump to its target, we return false
 ///   directly
 bool ObjectLinker::layout() {
+  LinkStatistics::Phase phase(m_pStatistics, "layout");
+
   m_LDBackend.layout(*m_pModule);
   return true;
 }
 
 /// prelayout - help backend to do some modification after layout
 bool ObjectLinker::postlayout() {
+  LinkStatistics::Phase phase(m_pStatistics, "postlayout");
+
   m_LDBackend.postLayout(*m_pModule, *m_pBuilder);
   return true;
 }
@@ -711,6 +867,8 @@ bool ObjectLinker::postlayout() {
 ///   all
 ///   symbol.
 bool ObjectLinker::finalizeSymbolValue() {
+  LinkStatistics::Phase phase(m_pStatistics, "finalizeSymbolValue");
+
   Module::sym_iterator symbol, symEnd = m_pModule->sym_end();
   for (symbol = m_pModule->sym_begin(); symbol != symEnd; ++symbol) {
     if ((*symbol)->resolveInfo()->isAbsolute() ||
@@ -777,16 +935,21 @@ bool ObjectLinker::finalizeSymbolValue() {
 /// read the relocation information into RelocationEntry
 /// and push_back into the relocation section
 bool ObjectLinker::relocation() {
+  LinkStatistics::Phase phase(m_pStatistics, "relocation");
+
   // when producing relocatables, no need to apply relocation
   if (LinkerConfig::Object == m_Config.codeGenType())
     return true;
 
   LDSection* debug_str_sect = m_pModule->getSection(".debug_str");
 
-  // apply all relocations of all inputs
+  // apply all relocations of all inputs. The relocations of an input are
+  // collected first so that the relocator can apply them in batches.
+  Relocator::RelocList relocs;
   Module::obj_iterator input, inEnd = m_pModule->obj_end();
   for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
     m_LDBackend.getRelocator()->initializeApply(**input);
+    relocs.clear();
     LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
     for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
       // bypass the reloc section if
@@ -820,9 +983,10 @@ bool ObjectLinker::relocation() {
           continue;
         }
 
-        relocation->apply(*m_LDBackend.getRelocator());
+        relocs.push_back(relocation);
       }  // for all relocations
     }    // for all relocation section
+    m_LDBackend.getRelocator()->applyRelocations(relocs);
     m_LDBackend.getRelocator()->finalizeApply(**input);
   }  // for all inputs
 
@@ -846,13 +1010,155 @@ bool ObjectLinker::relocation() {
   return true;
 }
 
+/// compressDebugSections - compress the non-allocated debug sections
+bool ObjectLinker::compressDebugSections() {
+  LinkStatistics::Phase phase(m_pStatistics, "compressDebugSections");
+
+  uint32_t type = 0x0;
+  switch (m_Config.options().getCompressDebugSections()) {
+    case GeneralOptions::CompressDebug_Zlib:
+      type = ELF::ELFCOMPRESS_ZLIB;
+      break;
+    case GeneralOptions::CompressDebug_Zstd:
+      type = ELF::ELFCOMPRESS_ZSTD;
+      break;
+    default:
+      return true;
+  }
+
+  // relocatable outputs keep the relocations against the debug sections, so
+  // their contents cannot be finalized here.
+  if (LinkerConfig::Object == m_Config.codeGenType())
+    return true;
+
+  if (!compression::isAvailable(type)) {
+    warning(diag::warn_unsupported_debug_compression)
+        << compression::getName(type);
+    return true;
+  }
+
+  // render the uncompressed contents
+  typedef llvm::DenseMap<const LDSection*, size_t> ContentIndex;
+  std::vector<LDSection*> sections;
+  std::vector<std::vector<uint8_t> > contents;
+  ContentIndex index;
+  Module::iterator sect, sectEnd = m_pModule->end();
+  for (sect = m_pModule->begin(); sect != sectEnd; ++sect) {
+    if (LDFileFormat::Debug != (*sect)->kind() ||
+        ((*sect)->flag() & llvm::ELF::SHF_ALLOC) != 0 ||
+        !(*sect)->hasSectionData() || (*sect)->size() == 0)
+      continue;
+    index[*sect] = sections.size();
+    sections.push_back(*sect);
+    contents.push_back(std::vector<uint8_t>((*sect)->size(), 0x0));
+    MemoryRegion region(contents.back().data(), (*sect)->size());
+    getWriter()->emitSectionData(**sect, region);
+  }
+
+  if (sections.empty())
+    return true;
+
+  // write the relocation results into the contents. Branch islands and
+  // backend-created relocations never target debug sections.
+  Module::obj_iterator input, inEnd = m_pModule->obj_end();
+  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
+    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
+    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        Relocation* relocation = llvm::cast<Relocation>(reloc);
+        ResolveInfo* info = relocation->symInfo();
+        if (!info->outSymbol()->hasFragRef() &&
+            ResolveInfo::Section == info->type() &&
+            ResolveInfo::Undefined == info->desc())
+          continue;
+        if (relocation->type() == 0x0)
+          continue;
+
+        const LDSection& target =
+            relocation->targetRef().frag()->getParent()->getSection();
+        ContentIndex::iterator entry = index.find(&target);
+        if (entry == index.end())
+          continue;
+        uint8_t* content = contents[entry->second].data();
+        writeRelocationTarget(
+            *relocation, content + relocation->targetRef().getOutputOffset());
+      }  // for all relocations
+    }    // for all relocation section
+  }      // for all inputs
+
+  // compress and replace the section data. A section whose compressed form
+  // is not smaller is left as it is.
+  bool is_32 = (32 == m_Config.targets().bitclass());
+  size_t chdr_size = is_32 ? sizeof(ELF::Elf32_Chdr) : sizeof(ELF::Elf64_Chdr);
+  bool compressed_any = false;
+  for (size_t i = 0; i < sections.size(); ++i) {
+    LDSection* section = sections[i];
+    llvm::StringRef content(reinterpret_cast<const char*>(contents[i].data()),
+                            contents[i].size());
+    llvm::SmallVector<char, 0> compressed;
+    if (!compression::compress(type, content, compressed)) {
+      warning(diag::warn_cannot_compress_section) << section->name();
+      continue;
+    }
+    if (chdr_size + compressed.size() >= section->size())
+      continue;
+
+    uint64_t size = chdr_size + compressed.size();
+    uint8_t* data = static_cast<uint8_t*>(
+        m_pModule->getAllocator().Allocate(size, 1));
+    writeCompressionHeader(type, *section, data);
+    memcpy(data + chdr_size, compressed.data(), compressed.size());
+
+    // The old fragments stay alive for the symbols and relocations which
+    // refer to them; only the emitted content changes.
+    SectionData* sect_data = SectionData::Create(*section);
+    section->setSectionData(sect_data);
+    ObjectBuilder::AppendFragment(*IRBuilder::CreateRegion(data, size),
+                                  *sect_data);
+    section->setSize(size);
+    section->setFlag(section->flag() | ELF::SHF_COMPRESSED);
+    m_CompressedSections.insert(section);
+    section->setAlign(is_32 ? 4 : 8);
+    compressed_any = true;
+  }
+
+  if (!compressed_any)
+    return true;
+
+  // The non-allocated sections are placed after all allocated ones, so they
+  // can be moved forward without touching the segments.
+  bool moved = false;
+  LDSection* prev = NULL;
+  for (sect = m_pModule->begin(); sect != sectEnd; prev = *sect, ++sect) {
+    if (!moved) {
+      moved = ((*sect)->flag() & ELF::SHF_COMPRESSED) != 0;
+      continue;
+    }
+    if (((*sect)->flag() & llvm::ELF::SHF_ALLOC) != 0)
+      continue;
+    uint64_t offset = prev->offset();
+    if (LDFileFormat::BSS != prev->kind())
+      offset += prev->size();
+    alignAddress(offset, (*sect)->align());
+    (*sect)->setOffset(offset);
+  }
+  return true;
+}
+
 /// emitOutput - emit the output file.
 bool ObjectLinker::emitOutput(FileOutputBuffer& pOutput) {
+  LinkStatistics::Phase phase(m_pStatistics, "emitOutput");
+
   return std::error_code() == getWriter()->writeObject(*m_pModule, pOutput);
 }
 
 /// postProcessing - do modification after all processes
 bool ObjectLinker::postProcessing(FileOutputBuffer& pOutput) {
+  LinkStatistics::Phase phase(m_pStatistics, "postProcessing");
+
   if (LinkerConfig::Object != m_Config.codeGenType())
     normalSyncRelocationResult(pOutput);
   else
@@ -865,8 +1171,49 @@ bool ObjectLinker::postProcessing(FileOutputBuffer& pOutput) {
   return true;
 }
 
+/// reportStatistics - print and write out the per-phase statistics
+void ObjectLinker::reportStatistics() const {
+  if (m_Config.options().printMemoryUsage())
+    MemoryPool::PrintUsage(mcld::outs());
+
+  if (m_pStatistics == NULL)
+    return;
+
+  if (m_Config.options().printStats()) {
+    m_pStatistics->print(mcld::outs());
+
+    // the stubs and the islands of the relaxation
+    StubFactory* stubs = m_LDBackend.getStubFactory();
+    BranchIslandFactory* islands = m_LDBackend.getBRIslandFactory();
+    if (stubs != NULL && islands != NULL && islands->size() != 0) {
+      mcld::outs() << llvm::format(
+          "relaxation: %u stubs created, %u reused, %u bytes in %u islands\n",
+          static_cast<unsigned>(stubs->numOfCreatedStubs()),
+          static_cast<unsigned>(stubs->numOfReusedStubs()),
+          static_cast<unsigned>(islands->islandSize()),
+          static_cast<unsigned>(islands->size()));
+    }
+  }
+
+  if (m_Config.options().hasTimeTrace())
+    m_pStatistics->writeTimeTrace(m_Config.options().timeTraceFile());
+}
+
+/// writeMapFile - print and write out the link map
+void ObjectLinker::writeMapFile() const {
+  if (m_pMapFile == NULL)
+    return;
+
+  if (m_Config.options().printMap())
+    m_pMapFile->print(mcld::outs());
+
+  if (m_Config.options().hasMapFile())
+    m_pMapFile->write(m_Config.options().mapFile());
+}
+
 void ObjectLinker::normalSyncRelocationResult(FileOutputBuffer& pOutput) {
   uint8_t* data = pOutput.getBufferStart();
+  llvm::DenseSet<const LDSection*> unrelocatable;
 
   // sync all relocations of all inputs
   Module::obj_iterator input, inEnd = m_pModule->obj_end();
@@ -899,6 +1246,21 @@ void ObjectLinker::normalSyncRelocationResult(FileOutputBuffer& pOutput) {
         // the same place
         if (relocation->type() == 0x0)
           continue;
+
+        // the results of relocations against the sections compressed by
+        // compressDebugSections() are already in the compressed contents. A
+        // section that is still compressed otherwise was never decompressed,
+        // and its relocations cannot be applied.
+        const LDSection& target =
+            relocation->targetRef().frag()->getParent()->getSection();
+        if ((target.flag() & ELF::SHF_COMPRESSED) != 0) {
+          if (m_CompressedSections.count(&target) == 0 &&
+              unrelocatable.insert(&target).second) {
+            error(diag::err_relocate_compressed_section) << target.name()
+                                                         << (*input)->path();
+          }
+          continue;
+        }
         writeRelocationResult(*relocation, data);
       }  // for all relocations
     }    // for all relocation section
@@ -957,39 +1319,75 @@ void ObjectLinker::writeRelocationResult(Relocation& pReloc, uint8_t* pOutput) {
       pReloc.targetRef().frag()->getParent()->getSection().offset() +
       pReloc.targetRef().getOutputOffset();
 
-  uint8_t* target_addr = pOutput + out_offset;
+  writeRelocationTarget(pReloc, pOutput + out_offset);
+}
+
+void ObjectLinker::writeRelocationTarget(Relocation& pReloc,
+                                         uint8_t* pTarget) {
   // byte swapping if target and host has different endian, and then write back
   if (llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian()) {
     uint64_t tmp_data = 0;
 
     switch (pReloc.size(*m_LDBackend.getRelocator())) {
       case 8u:
-        std::memcpy(target_addr, &pReloc.target(), 1);
+        std::memcpy(pTarget, &pReloc.target(), 1);
         break;
 
       case 16u:
         tmp_data = mcld::bswap16(pReloc.target());
-        std::memcpy(target_addr, &tmp_data, 2);
+        std::memcpy(pTarget, &tmp_data, 2);
         break;
 
       case 32u:
         tmp_data = mcld::bswap32(pReloc.target());
-        std::memcpy(target_addr, &tmp_data, 4);
+        std::memcpy(pTarget, &tmp_data, 4);
         break;
 
       case 64u:
         tmp_data = mcld::bswap64(pReloc.target());
-        std::memcpy(target_addr, &tmp_data, 8);
+        std::memcpy(pTarget, &tmp_data, 8);
         break;
 
       default:
         break;
     }
   } else {
-    std::memcpy(target_addr,
+    std::memcpy(pTarget,
                 &pReloc.target(),
                 pReloc.size(*m_LDBackend.getRelocator()) / 8);
   }
 }
 
+void ObjectLinker::writeCompressionHeader(uint32_t pType,
+                                          const LDSection& pSection,
+                                          uint8_t* pOutput) const {
+  bool swap =
+      llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian();
+  if (32 == m_Config.targets().bitclass()) {
+    ELF::Elf32_Chdr chdr;
+    chdr.ch_type = pType;
+    chdr.ch_size = pSection.size();
+    chdr.ch_addralign = pSection.align();
+    if (swap) {
+      chdr.ch_type = mcld::bswap32(chdr.ch_type);
+      chdr.ch_size = mcld::bswap32(chdr.ch_size);
+      chdr.ch_addralign = mcld::bswap32(chdr.ch_addralign);
+    }
+    std::memcpy(pOutput, &chdr, sizeof(chdr));
+    return;
+  }
+
+  ELF::Elf64_Chdr chdr;
+  chdr.ch_type = pType;
+  chdr.ch_reserved = 0x0;
+  chdr.ch_size = pSection.size();
+  chdr.ch_addralign = pSection.align();
+  if (swap) {
+    chdr.ch_type = mcld::bswap32(chdr.ch_type);
+    chdr.ch_size = mcld::bswap64(chdr.ch_size);
+    chdr.ch_addralign = mcld::bswap64(chdr.ch_addralign);
+  }
+  std::memcpy(pOutput, &chdr, sizeof(chdr));
+}
+
 }  // namespace mcld
@@ -54,6 +54,8 @@ SectionMap::Input::Input(const std::string& pName,
   m_pSection->setSectionData(sd);
   new NullFragment(sd);
   new NullFragment(sd);
+
+  initSortPolicy();
 }
 
 SectionMap::Input::Input(const InputSectDesc& pInputDesc)
@@ -66,6 +68,28 @@ SectionMap::Input::Input(const InputSectDesc& pInputDesc)
   m_pSection->setSectionData(sd);
   new NullFragment(sd);
   new NullFragment(sd);
+
+  initSortPolicy();
+}
+
+bool SectionMap::Input::sortFiles() const {
+  return m_Spec.hasFile() &&
+         m_Spec.file().sortPolicy() != WildcardPattern::SORT_NONE;
+}
+
+void SectionMap::Input::initSortPolicy() {
+  m_bNeedSort = sortFiles();
+  if (m_bNeedSort || !m_Spec.hasSections())
+    return;
+
+  StringList::const_iterator sect, sectEnd = m_Spec.sections().end();
+  for (sect = m_Spec.sections().begin(); sect != sectEnd; ++sect) {
+    if (llvm::cast<WildcardPattern>(**sect).sortPolicy() !=
+        WildcardPattern::SORT_NONE) {
+      m_bNeedSort = true;
+      return;
+    }
+  }
 }
 
 //===----------------------------------------------------------------------===//
@@ -293,6 +317,24 @@ SectionMap::iterator SectionMap::insert(iterator pPosition,
   return m_OutputDescList.insert(pPosition, output);
 }
 
+WildcardPattern::SortPolicy SectionMap::sortPolicy(
+    const Input& pInput,
+    const std::string& pInputSection,
+    size_t& pPattern) const {
+  pPattern = 0;
+  if (!pInput.spec().hasSections())
+    return WildcardPattern::SORT_NONE;
+
+  StringList::const_iterator sect, sectEnd = pInput.spec().sections().end();
+  for (sect = pInput.spec().sections().begin(); sect != sectEnd;
+       ++sect, ++pPattern) {
+    const WildcardPattern& pattern = llvm::cast<WildcardPattern>(**sect);
+    if (matched(pattern, pInputSection))
+      return pattern.sortPolicy();
+  }
+  return WildcardPattern::SORT_NONE;
+}
+
 bool SectionMap::matched(const SectionMap::Input& pInput,
                          const std::string& pInputFile,
                          const std::string& pInputSection) const {
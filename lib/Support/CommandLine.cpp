@@ -130,6 +130,10 @@ bool parser<mcld::ZOption>::parse(llvm::cl::Option& O,
     Val.setKind(mcld::ZOption::Now);
   else if (Arg.equals("origin"))
     Val.setKind(mcld::ZOption::Origin);
+  else if (Arg.equals("pack-relative-relocs"))
+    Val.setKind(mcld::ZOption::PackRelativeRelocs);
+  else if (Arg.equals("nopack-relative-relocs"))
+    Val.setKind(mcld::ZOption::NoPackRelativeRelocs);
   else if (Arg.startswith("common-page-size=")) {
     Val.setKind(mcld::ZOption::CommPageSize);
     long long unsigned size = 0;
@@ -0,0 +1,60 @@
+//===- Compression.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/Compression.h"
+
+#include "mcld/Support/ELF.h"
+
+#include <llvm/Support/Compression.h>
+
+namespace mcld {
+namespace compression {
+
+// Only zlib is provided by LLVM. ELFCOMPRESS_ZSTD is recognized so that the
+// callers can report it, but it is never available.
+bool isAvailable(uint32_t pType) {
+  if (pType == ELF::ELFCOMPRESS_ZLIB)
+    return llvm::zlib::isAvailable();
+  return false;
+}
+
+const char* getName(uint32_t pType) {
+  switch (pType) {
+    case ELF::ELFCOMPRESS_ZLIB:
+      return "zlib";
+    case ELF::ELFCOMPRESS_ZSTD:
+      return "zstd";
+    default:
+      return "unknown";
+  }
+}
+
+bool compress(uint32_t pType,
+              llvm::StringRef pInput,
+              llvm::SmallVectorImpl<char>& pOutput) {
+  if (!isAvailable(pType))
+    return false;
+  // the best speed level is much faster than the default one, and the
+  // debug sections compress nearly as well.
+  return llvm::zlib::StatusOK ==
+         llvm::zlib::compress(pInput, pOutput, llvm::zlib::BestSpeedCompression);
+}
+
+bool uncompress(uint32_t pType,
+                llvm::StringRef pInput,
+                llvm::SmallVectorImpl<char>& pOutput,
+                size_t pSize) {
+  if (!isAvailable(pType))
+    return false;
+  if (llvm::zlib::StatusOK != llvm::zlib::uncompress(pInput, pOutput, pSize))
+    return false;
+  return pOutput.size() == pSize;
+}
+
+}  // namespace compression
+}  // namespace mcld
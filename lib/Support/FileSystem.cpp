@@ -10,6 +10,8 @@
 #include "mcld/Support/FileSystem.h"
 #include "mcld/Support/Path.h"
 
+#include <ctime>
+
 //===----------------------------------------------------------------------===//
 // non-member functions
 //===----------------------------------------------------------------------===//
@@ -26,6 +28,14 @@ bool mcld::sys::fs::is_directory(const Path& pPath) {
   return (file_status.type() == mcld::sys::fs::DirectoryFile);
 }
 
+bool mcld::sys::fs::is_racy(const FileStatus& pStatus) {
+  // the modification time of some file systems has a granularity of one or
+  // two seconds.
+  static const uint64_t RacyInterval = 2;
+  uint64_t now = static_cast<uint64_t>(time(NULL));
+  return pStatus.modTime() + RacyInterval > now;
+}
+
 // Include the truly platform-specific parts.
 #if defined(MCLD_ON_UNIX)
 #include "Unix/FileSystem.inc"
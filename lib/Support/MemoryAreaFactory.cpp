@@ -7,6 +7,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "mcld/Support/MemoryAreaFactory.h"
+#include "mcld/Support/FileSystem.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Support/SystemUtils.h"
 
@@ -22,44 +23,67 @@ MemoryAreaFactory::MemoryAreaFactory(size_t pNum)
 MemoryAreaFactory::~MemoryAreaFactory() {
 }
 
+void MemoryAreaFactory::AreaEntry::setStatus(
+    const sys::fs::FileStatus& pStatus) {
+  size = pStatus.size();
+  modTime = pStatus.modTime();
+  modTimeNSec = pStatus.modTimeNSec();
+  inode = pStatus.inode();
+  racy = sys::fs::is_racy(pStatus);
+}
+
+bool MemoryAreaFactory::AreaEntry::isUnchanged(
+    const sys::fs::FileStatus& pStatus) const {
+  // a file modified in the same clock tick as it was mapped may change again
+  // without changing its status. Never reuse the MemoryArea of such file.
+  if (racy)
+    return false;
+  return size == pStatus.size() && modTime == pStatus.modTime() &&
+         modTimeNSec == pStatus.modTimeNSec() && inode == pStatus.inode();
+}
+
 MemoryArea* MemoryAreaFactory::produce(const sys::fs::Path& pPath,
                                        FileHandle::OpenMode pMode) {
   llvm::StringRef name(pPath.native());
-  if (m_AreaMap.find(name) == m_AreaMap.end()) {
+  sys::fs::FileStatus status;
+  sys::fs::detail::status(pPath, status);
+
+  AreaMap::iterator entry = m_AreaMap.find(name);
+  if (entry != m_AreaMap.end()) {
+    AreaEntry& cached = entry->getValue();
+    if (cached.isUnchanged(status))
+      return cached.area;
+
+    // The file may have changed since it was mapped. Map it again into a new
+    // MemoryArea. The inputs of this link may still refer into the old one,
+    // so it lives until the factory is cleared.
     MemoryArea* result = allocate();
     new (result) MemoryArea(name);
-    m_AreaMap[name] = result;
+    cached.area = result;
+    cached.setStatus(status);
     return result;
   }
 
-  return m_AreaMap[name];
+  MemoryArea* result = allocate();
+  new (result) MemoryArea(name);
+  AreaEntry& cached = m_AreaMap[name];
+  cached.area = result;
+  cached.setStatus(status);
+  return result;
 }
 
 MemoryArea* MemoryAreaFactory::produce(const sys::fs::Path& pPath,
                                        FileHandle::OpenMode pMode,
                                        FileHandle::Permission pPerm) {
-  llvm::StringRef name(pPath.native());
-  if (m_AreaMap.find(name) == m_AreaMap.end()) {
-    MemoryArea* result = allocate();
-    new (result) MemoryArea(name);
-    m_AreaMap[name] = result;
-    return result;
-  }
-
-  return m_AreaMap[name];
+  return produce(pPath, pMode);
 }
 
 MemoryArea* MemoryAreaFactory::produce(void* pMemBuffer, size_t pSize) {
-  const char* base = reinterpret_cast<const char*>(pMemBuffer);
-  llvm::StringRef name(base, pSize);
-  if (m_AreaMap.find(name) == m_AreaMap.end()) {
-    MemoryArea* result = allocate();
-    new (result) MemoryArea(base, pSize);
-    m_AreaMap[name] = result;
-    return result;
-  }
-
-  return m_AreaMap[name];
+  // An in-memory buffer is not cached. The same bytes may be given again at
+  // another address by a later link, and the caller owns the buffer.
+  MemoryArea* result = allocate();
+  new (result) MemoryArea(reinterpret_cast<const char*>(pMemBuffer), pSize);
+  return result;
 }
 
 MemoryArea* MemoryAreaFactory::produce(int pFD, FileHandle::OpenMode pMode) {
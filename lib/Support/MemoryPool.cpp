@@ -0,0 +1,149 @@
+//===- MemoryPool.cpp -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/MemoryPool.h"
+
+#include <llvm/Support/Format.h>
+#include <llvm/Support/Mutex.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <map>
+
+namespace mcld {
+
+/// the registered pools. The pools of ThreadArenas are created by the threads
+/// building the IR, so the list is guarded by getPoolListLock().
+static MemoryPool* g_pPoolList = NULL;
+
+namespace {
+
+/// getPoolListLock - the lock is leaked on purpose, since the static pools
+/// unregister themselves at exit
+llvm::sys::SmartMutex<true>& getPoolListLock() {
+  static llvm::sys::SmartMutex<true>* lock = new llvm::sys::SmartMutex<true>();
+  return *lock;
+}
+
+struct ReservedBytesCompare {
+  bool operator()(const MemoryPool::Usage& pX,
+                  const MemoryPool::Usage& pY) const {
+    return pX.reservedBytes > pY.reservedBytes;
+  }
+};
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// MemoryPool::Usage
+//===----------------------------------------------------------------------===//
+MemoryPool::Usage::Usage()
+    : objectSize(0),
+      pools(0),
+      chunks(0),
+      objects(0),
+      peakObjects(0),
+      reservedBytes(0),
+      peakReservedBytes(0),
+      usedBytes(0) {
+}
+
+//===----------------------------------------------------------------------===//
+// MemoryPool
+//===----------------------------------------------------------------------===//
+MemoryPool::MemoryPool() : m_pPrev(NULL), m_pNext(NULL) {
+  llvm::sys::SmartScopedLock<true> guard(getPoolListLock());
+  m_pNext = g_pPoolList;
+  if (g_pPoolList != NULL)
+    g_pPoolList->m_pPrev = this;
+  g_pPoolList = this;
+}
+
+MemoryPool::~MemoryPool() {
+  llvm::sys::SmartScopedLock<true> guard(getPoolListLock());
+  if (m_pPrev != NULL)
+    m_pPrev->m_pNext = m_pNext;
+  else
+    g_pPoolList = m_pNext;
+  if (m_pNext != NULL)
+    m_pNext->m_pPrev = m_pPrev;
+}
+
+std::string MemoryPool::ParseTypeName(llvm::StringRef pFunction) {
+  size_t begin = pFunction.find("T = ");
+  if (begin == llvm::StringRef::npos)
+    return "unknown";
+  begin += 4;
+  size_t end = pFunction.find_first_of(";]", begin);
+  llvm::StringRef name = pFunction.slice(begin, end);
+  if (name.startswith("mcld::"))
+    name = name.substr(6);
+  return name.str();
+}
+
+void MemoryPool::CollectUsage(UsageList& pUsages) {
+  std::map<std::string, Usage> usages;
+  llvm::sys::SmartScopedLock<true> guard(getPoolListLock());
+  for (const MemoryPool* pool = g_pPoolList; pool != NULL;
+       pool = pool->m_pNext) {
+    Usage usage;
+    pool->getUsage(usage);
+    Usage& total = usages[usage.name];
+    total.name = usage.name;
+    total.objectSize = usage.objectSize;
+    total.pools += 1;
+    total.chunks += usage.chunks;
+    total.objects += usage.objects;
+    total.peakObjects += usage.peakObjects;
+    total.reservedBytes += usage.reservedBytes;
+    total.peakReservedBytes += usage.peakReservedBytes;
+    total.usedBytes += usage.usedBytes;
+  }
+
+  pUsages.clear();
+  std::map<std::string, Usage>::const_iterator usage, usageEnd = usages.end();
+  for (usage = usages.begin(); usage != usageEnd; ++usage)
+    pUsages.push_back(usage->second);
+  std::stable_sort(pUsages.begin(), pUsages.end(), ReservedBytesCompare());
+}
+
+void MemoryPool::PrintUsage(llvm::raw_ostream& pOS) {
+  UsageList usages;
+  CollectUsage(usages);
+
+  pOS << "pool                       size  pools   chunks    objects"
+         "       peak  reserved(KB)  used(KB)  peak(KB)\n";
+
+  Usage total;
+  UsageList::const_iterator usage, usageEnd = usages.end();
+  for (usage = usages.begin(); usage != usageEnd; ++usage) {
+    pOS << llvm::format("%-24s %6u %6u %8u %10u %10u %13.1f %9.1f %9.1f\n",
+                        usage->name.c_str(),
+                        static_cast<unsigned>(usage->objectSize),
+                        static_cast<unsigned>(usage->pools),
+                        static_cast<unsigned>(usage->chunks),
+                        static_cast<unsigned>(usage->objects),
+                        static_cast<unsigned>(usage->peakObjects),
+                        usage->reservedBytes / 1024.0,
+                        usage->usedBytes / 1024.0,
+                        usage->peakReservedBytes / 1024.0);
+    total.chunks += usage->chunks;
+    total.reservedBytes += usage->reservedBytes;
+    total.usedBytes += usage->usedBytes;
+    total.peakReservedBytes += usage->peakReservedBytes;
+  }
+
+  pOS << llvm::format("total                                  %8u"
+                      "                       %13.1f %9.1f %9.1f\n",
+                      static_cast<unsigned>(total.chunks),
+                      total.reservedBytes / 1024.0,
+                      total.usedBytes / 1024.0,
+                      total.peakReservedBytes / 1024.0);
+}
+
+}  // namespace mcld
@@ -134,6 +134,11 @@ class AArch64GNULDBackend : public GNULDBackend {
   /// getRelEntrySize - the size in BYTE of rela type relocation
   size_t getRelaEntrySize() { return 24; }
 
+  /// isRelativeReloc - whether pReloc can be packed into .relr.dyn
+  bool isRelativeReloc(const Relocation& pReloc) const {
+    return pReloc.type() == llvm::ELF::R_AARCH64_RELATIVE;
+  }
+
   /// doCreateProgramHdrs - backend can implement this function to create the
   /// target-dependent segments
   virtual void doCreateProgramHdrs(Module& pModule);
@@ -11,13 +11,19 @@
 
 #include "ARMLDBackend.h"
 
+#include "mcld/LinkerConfig.h"
 #include "mcld/ADT/ilist_sort.h"
 #include "mcld/Fragment/RegionFragment.h"
+#include "mcld/Fragment/Relocation.h"
 #include "mcld/LD/ELFFileFormat.h"
 #include "mcld/LD/LDContext.h"
+#include "mcld/LD/RelocData.h"
 #include "mcld/Support/MsgHandling.h"
 
+#include <llvm/Support/Casting.h>
+
 #include <memory>
+#include <vector>
 
 static const char g_CantUnwindEntry[8] = {
   // Relocation to text section.
@@ -88,7 +94,7 @@ void ARMGNULDBackend::scanInputExceptionSections(Module& pModule,
       exTuple->setRelExIdxSection(sect);
     } else if (name.startswith(".rel.ARM.extab")) {
       ARMExSectionTuple* exTuple = exMap->getOrCreateByRelExSection(name);
-      exTuple->setRelExIdxSection(sect);
+      exTuple->setRelExTabSection(sect);
     }
   }
 
@@ -194,6 +200,85 @@ class ExIdxFragmentComparator {
   }
 };
 
+/// ExIdxEntry - the unwind part (the second word) of an .ARM.exidx entry.
+/// It is either EXIDX_CANTUNWIND, an inline entry with the high bit set, or a
+/// PREL31 reference to the .ARM.extab data given by the relocation.
+struct ExIdxEntry {
+  const ResolveInfo* symInfo;
+  uint32_t word;
+
+  ExIdxEntry() : symInfo(NULL), word(0x1) { }
+
+  bool isCantUnwind() const { return (symInfo == NULL) && (word == 0x1); }
+
+  bool operator==(const ExIdxEntry& pOther) const {
+    return (symInfo == pOther.symInfo) && (word == pOther.word);
+  }
+};
+
+/// GetExIdxEntries - decode the entries of the .ARM.exidx fragment of
+/// pTuple.
+///   @return false if the fragment is not a whole table of entries
+static bool GetExIdxEntries(const ARMExSectionTuple& pTuple,
+                            std::vector<ExIdxEntry>& pEntries) {
+  const RegionFragment* frag = pTuple.getExIdxFragment();
+  llvm::StringRef region = frag->getRegion();
+  if (region.empty() || (region.size() % 8) != 0)
+    return false;
+
+  // .ARM.exidx is little endian, as is g_CantUnwindEntry.
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(region.data());
+  pEntries.resize(region.size() / 8);
+  for (size_t i = 0; i < pEntries.size(); ++i) {
+    const uint8_t* word = data + i * 8 + 4;
+    pEntries[i].symInfo = NULL;
+    pEntries[i].word = word[0] | (word[1] << 8) | (word[2] << 16) |
+                       (static_cast<uint32_t>(word[3]) << 24);
+  }
+
+  RelocData* relocs = pTuple.getExIdxRelocData();
+  if (relocs == NULL)
+    return true;
+  for (RelocData::iterator it = relocs->begin(), end = relocs->end();
+       it != end; ++it) {
+    Relocation& reloc = llvm::cast<Relocation>(*it);
+    if (reloc.type() == llvm::ELF::R_ARM_NONE ||
+        reloc.targetRef().frag() != frag ||
+        (reloc.targetRef().offset() % 8) != 4)
+      continue;
+    ExIdxEntry& entry = pEntries[reloc.targetRef().offset() / 8];
+    entry.symInfo = reloc.symInfo();
+    entry.word += reloc.addend();
+  }
+  return true;
+}
+
+/// IsDuplicateExIdx - whether every entry of pTuple is the same as pLast, so
+/// that pLast can cover the text fragment of pTuple as well. (EHABI 5)
+static bool IsDuplicateExIdx(const ARMExSectionTuple& pTuple,
+                             const ExIdxEntry& pLast) {
+  std::vector<ExIdxEntry> entries;
+  if (!GetExIdxEntries(pTuple, entries))
+    return false;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (!(entries[i] == pLast))
+      return false;
+  }
+  return true;
+}
+
+/// GetLastExIdxEntry - get the last entry of the .ARM.exidx fragment of
+/// pTuple.
+///   @return false if the fragment cannot be decoded
+static bool GetLastExIdxEntry(const ARMExSectionTuple& pTuple,
+                              ExIdxEntry& pLast) {
+  std::vector<ExIdxEntry> entries;
+  if (!GetExIdxEntries(pTuple, entries))
+    return false;
+  pLast = entries.back();
+  return true;
+}
+
 static mcld::ResolveInfo*
 CreateLocalSymbolToFragmentEnd(mcld::Module& pModule, mcld::Fragment& pFrag) {
   // Create and add symbol to the name pool.
@@ -251,23 +336,35 @@ void ARMGNULDBackend::rewriteARMExIdxSection(Module& pModule) {
   // Sort the region fragments in the .ARM.exidx output section.
   sort(list, ExIdxFragmentComparator(m_ExData));
 
-  // Fix the coverage of the .ARM.exidx table.
+  // Fix the coverage of the .ARM.exidx table. When linking an executable or
+  // a shared object, an entry is also merged into the previous one if they
+  // unwind in the same way, since an entry covers the text up to the next
+  // entry. The relocations of a merged entry are dropped with it.
   llvm::StringRef cantUnwindRegion(g_CantUnwindEntry,
                                    sizeof(g_CantUnwindEntry));
+  const bool merge = (LinkerConfig::Object != config().codeGenType());
+  ExIdxEntry last;
+  bool hasLast = false;
+  Fragment* prevTextFrag = NULL;
 
   SectionData::FragmentListType::iterator it = list.begin();
   if (it != list.end()) {
-    Fragment* prevTextFrag = m_ExData.getTupleByExIdx(it)->getTextFragment();
+    ARMExSectionTuple* tuple = m_ExData.getTupleByExIdx(it);
+    prevTextFrag = tuple->getTextFragment();
     uint64_t prevTextEnd = prevTextFrag->getParent()->getSection().addr() +
                            prevTextFrag->getOffset() +
                            prevTextFrag->size();
+    hasLast = GetLastExIdxEntry(*tuple, last);
     ++it;
     while (it != list.end()) {
-      Fragment* currTextFrag = m_ExData.getTupleByExIdx(it)->getTextFragment();
+      tuple = m_ExData.getTupleByExIdx(it);
+      Fragment* currTextFrag = tuple->getTextFragment();
       uint64_t currTextBegin = currTextFrag->getParent()->getSection().addr() +
                                currTextFrag->getOffset();
 
-      if (currTextBegin > prevTextEnd) {
+      // A gap after a can't unwind entry is already covered by it.
+      if (currTextBegin > prevTextEnd &&
+          !(merge && hasLast && last.isCantUnwind())) {
         // Found a gap. Insert a can't unwind entry.
         RegionFragment* frag = new RegionFragment(cantUnwindRegion, nullptr);
         frag->setParent(sectData);
@@ -281,14 +378,32 @@ void ARMGNULDBackend::rewriteARMExIdxSection(Module& pModule) {
         reloc->setSymInfo(
             CreateLocalSymbolToFragmentEnd(pModule, *prevTextFrag));
         addExtraRelocation(reloc);
+
+        last = ExIdxEntry();
+        hasLast = true;
       }
 
       prevTextEnd = currTextBegin + currTextFrag->size();
       prevTextFrag = currTextFrag;
+
+      if (merge && hasLast && IsDuplicateExIdx(*tuple, last)) {
+        // The previous entry covers this text fragment as well.
+        if (tuple->getExIdxRelocData() != NULL)
+          tuple->getExIdxRelocData()->getSection().setKind(
+              LDFileFormat::Ignore);
+        SectionData::FragmentListType::iterator dup = it++;
+        m_ExData.discardExIdx(list.remove(dup));
+        continue;
+      }
+
+      hasLast = GetLastExIdxEntry(*tuple, last);
       ++it;
     }
+  }
 
-    // Add a can't unwind entry to terminate .ARM.exidx section.
+  // Add a can't unwind entry to terminate .ARM.exidx section, unless the
+  // last entry is already one.
+  if (prevTextFrag != NULL && !(merge && hasLast && last.isCantUnwind())) {
     RegionFragment* frag = new RegionFragment(cantUnwindRegion, nullptr);
     frag->setParent(sectData);
     list.push_back(frag);
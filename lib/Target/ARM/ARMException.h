@@ -9,6 +9,8 @@
 #ifndef TARGET_ARM_ARMEXCEPTION_H_
 #define TARGET_ARM_ARMEXCEPTION_H_
 
+#include "mcld/LD/SectionData.h"
+
 #include <llvm/ADT/PointerUnion.h>
 #include <llvm/ADT/StringRef.h>
 
@@ -254,12 +256,21 @@ class ARMExData {
     return it->second;
   }
 
+  // discardExIdx - keep the .ARM.exidx fragment pFragment which is removed
+  // from the output. The relocations of the input still refer to it.
+  void discardExIdx(Fragment* pFragment) {
+    m_DiscardedExIdx.push_back(pFragment);
+  }
+
  private:
   // Map from Input to ARMInputExMap
   InputMap m_Inputs;
 
   // Map from .ARM.exidx RegionFragment to ARMExSectionTuple
   ExIdxMap m_ExIdxToTuple;
+
+  // The .ARM.exidx fragments merged into their previous entries
+  SectionData::FragmentListType m_DiscardedExIdx;
 };
 
 }  // namespace mcld
@@ -167,6 +167,11 @@ class ARMGNULDBackend : public GNULDBackend {
     return 12;
   }
 
+  /// isRelativeReloc - whether pReloc can be packed into .relr.dyn
+  bool isRelativeReloc(const Relocation& pReloc) const {
+    return pReloc.type() == llvm::ELF::R_ARM_RELATIVE;
+  }
+
   /// doCreateProgramHdrs - backend can implement this function to create the
   /// target-dependent segments
   virtual void doCreateProgramHdrs(Module& pModule);
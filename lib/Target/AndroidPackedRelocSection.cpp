@@ -0,0 +1,317 @@
+//===- AndroidPackedRelocSection.cpp --------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Target/AndroidPackedRelocSection.h"
+
+#include "mcld/Fragment/Relocation.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/LDSymbol.h"
+#include "mcld/LD/RelocData.h"
+#include "mcld/LD/ResolveInfo.h"
+#include "mcld/Support/ELF.h"
+#include "mcld/Support/MsgHandling.h"
+#include "mcld/Target/GNULDBackend.h"
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/Support/ELF.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace mcld {
+
+namespace {
+
+// Relocations with the same offset delta are grouped if there are at least
+// this many of them in a row.
+const size_t kMinOffsetDeltaGroup = 3;
+
+/// GetSLEBWidth - the number of bytes to hold any value in (-pBound, pBound]
+unsigned int GetSLEBWidth(uint64_t pBound) {
+  unsigned int width = 1;
+  while (width < 10 && (pBound >> (7 * width - 1)) != 0)
+    ++width;
+  return width;
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// AndroidPackedRelocSection::EntryCompare
+//===----------------------------------------------------------------------===//
+bool AndroidPackedRelocSection::EntryCompare::operator()(const Entry& X,
+                                                         const Entry& Y) const {
+  if (X.relative != Y.relative)
+    return X.relative;
+  if (!X.relative && X.key != Y.key)
+    return X.key < Y.key;
+  return X.offset < Y.offset;
+}
+
+//===----------------------------------------------------------------------===//
+// AndroidPackedRelocSection
+//===----------------------------------------------------------------------===//
+AndroidPackedRelocSection::AndroidPackedRelocSection(
+    const GNULDBackend& pBackend,
+    LDSection& pSection,
+    unsigned int pBitClass)
+    : m_Backend(pBackend),
+      m_Section(pSection),
+      m_BitClass(pBitClass),
+      m_bIsRela(pSection.type() == llvm::ELF::SHT_RELA),
+      m_RelativeAddendWidth(pBitClass == 32 ? 5 : 10),
+      m_AddendWidth(pBitClass == 32 ? 5 : 10),
+      m_SymIdxBound(0) {
+  assert(pSection.hasRelocData());
+  m_Section.setType(m_bIsRela ? ELF::SHT_ANDROID_RELA : ELF::SHT_ANDROID_REL);
+  // the header only, the section is sized after layout
+  m_Section.setSize(4);
+}
+
+AndroidPackedRelocSection::~AndroidPackedRelocSection() {
+}
+
+bool AndroidPackedRelocSection::finalizeSectionSize(uint64_t pAddrEnd,
+                                                    size_t pNumDynSyms) {
+  m_SymIdxBound = pNumDynSyms;
+
+  // The addends of relative relocations are addresses in the image, so the
+  // delta between two of them is below the end of the image. One more bit
+  // leaves room for addresses slightly past the end, e.g. &array[N].
+  if (m_bIsRela)
+    m_RelativeAddendWidth = std::min(GetSLEBWidth(pAddrEnd << 1), m_AddendWidth);
+
+  EntryList entries;
+  collect(entries, false);
+  Buffer buffer;
+  encode(entries, buffer);
+
+  uint64_t size = buffer.size();
+  if (size <= m_Section.size())
+    return false;
+  m_Section.setSize(size);
+  return true;
+}
+
+void AndroidPackedRelocSection::emit(MemoryRegion& pRegion) const {
+  EntryList entries;
+  collect(entries, true);
+  Buffer buffer;
+  if (!encode(entries, buffer))
+    return;
+  assert(buffer.size() <= pRegion.size() && "Packed relocations overflow!");
+
+  // the remaining bytes are padding after the last group
+  memcpy(pRegion.begin(), buffer.data(), buffer.size());
+  memset(pRegion.begin() + buffer.size(), 0, pRegion.size() - buffer.size());
+}
+
+void AndroidPackedRelocSection::collect(EntryList& pEntries,
+                                        bool pFinal) const {
+  // The symbol indexes are assigned when .dynsym is emitted, after layout.
+  // Group the relocations by the order the symbols are first referred to,
+  // which is the same when sizing and when emitting, and size r_info by the
+  // number of dynamic symbols, which bounds any index.
+  typedef llvm::DenseMap<const ResolveInfo*, uint64_t> RankMap;
+  RankMap ranks;
+
+  const RelocData* reloc_data = m_Section.getRelocData();
+  pEntries.reserve(reloc_data->size());
+  RelocData::const_iterator it, ie = reloc_data->end();
+  for (it = reloc_data->begin(); it != ie; ++it) {
+    const Relocation& reloc = *it;
+    Entry entry;
+    entry.offset = reloc.place();
+    entry.addend = static_cast<int64_t>(reloc.addend());
+    entry.relative = m_Backend.isRelativeReloc(reloc);
+    entry.reloc = &reloc;
+
+    // the dynamic linker ignores the symbol of a relative relocation
+    uint64_t rank = 0;
+    uint32_t sym_idx = 0;
+    if (!entry.relative && reloc.symInfo() != NULL) {
+      std::pair<RankMap::iterator, bool> res =
+          ranks.insert(std::make_pair(reloc.symInfo(), ranks.size() + 1));
+      rank = res.first->second;
+      if (pFinal)
+        sym_idx = m_Backend.getSymbolIdx(reloc.symInfo()->outSymbol());
+      else
+        sym_idx = m_SymIdxBound;
+    }
+    entry.key = (rank << 32) | reloc.type();
+
+    // let the target compose r_info
+    if (m_BitClass == 32) {
+      llvm::ELF::Elf32_Rel rel;
+      m_Backend.emitRelocation(rel, reloc.type(), sym_idx, 0);
+      entry.info = rel.r_info;
+    } else {
+      llvm::ELF::Elf64_Rel rel;
+      m_Backend.emitRelocation(rel, reloc.type(), sym_idx, 0);
+      entry.info = rel.r_info;
+    }
+    pEntries.push_back(entry);
+  }
+  std::stable_sort(pEntries.begin(), pEntries.end(), EntryCompare());
+}
+
+bool AndroidPackedRelocSection::encode(const EntryList& pEntries,
+                                       Buffer& pOut) const {
+  static const char magic[] = {'A', 'P', 'S', '2'};
+  pOut.insert(pOut.end(), magic, magic + sizeof(magic));
+  writeSLEB(pEntries.size(), pOut);
+  writeSLEB(0, pOut);
+
+  uint64_t offset = 0;
+  int64_t addend = 0;
+  bool fit = true;
+  uint64_t has_addend = m_bIsRela ? GroupHasAddend : 0x0;
+
+  // relative relocations: runs with the same offset delta share the delta,
+  // and the others share the r_info only.
+  size_t i = 0, n = pEntries.size();
+  Group pending, run;
+  while (i < n && pEntries[i].relative) {
+    uint64_t prev = (i == 0) ? 0 : pEntries[i - 1].offset;
+    uint64_t delta = pEntries[i].offset - prev;
+    size_t j = i + 1;
+    while (j < n && pEntries[j].relative &&
+           pEntries[j].key == pEntries[i].key &&
+           pEntries[j].offset - pEntries[j - 1].offset == delta)
+      ++j;
+
+    if (!pending.empty() && pending.front()->key != pEntries[i].key) {
+      writeGroup(pending, GroupedByInfo | has_addend, offset, addend, fit,
+                 pOut);
+      pending.clear();
+    }
+
+    if (j - i < kMinOffsetDeltaGroup) {
+      pending.push_back(&pEntries[i]);
+      ++i;
+      continue;
+    }
+
+    if (!pending.empty()) {
+      writeGroup(pending, GroupedByInfo | has_addend, offset, addend, fit,
+                 pOut);
+      pending.clear();
+    }
+    run.clear();
+    for (; i < j; ++i)
+      run.push_back(&pEntries[i]);
+    writeGroup(run, GroupedByInfo | GroupedByOffsetDelta | has_addend, offset,
+               addend, fit, pOut);
+  }
+  if (!pending.empty()) {
+    writeGroup(pending, GroupedByInfo | has_addend, offset, addend, fit, pOut);
+    pending.clear();
+  }
+
+  // the others are in the order of their symbols: runs with the same r_info
+  // share it, and the rest are written in one ungrouped group.
+  while (i < n) {
+    size_t j = i + 1;
+    while (j < n && pEntries[j].key == pEntries[i].key)
+      ++j;
+    if (j - i == 1) {
+      pending.push_back(&pEntries[i]);
+      ++i;
+      continue;
+    }
+    if (!pending.empty()) {
+      writeGroup(pending, has_addend, offset, addend, fit, pOut);
+      pending.clear();
+    }
+    run.clear();
+    for (; i < j; ++i)
+      run.push_back(&pEntries[i]);
+    writeGroup(run, GroupedByInfo | has_addend, offset, addend, fit, pOut);
+  }
+  if (!pending.empty())
+    writeGroup(pending, has_addend, offset, addend, fit, pOut);
+
+  return fit;
+}
+
+void AndroidPackedRelocSection::writeGroup(const Group& pGroup,
+                                           uint64_t pFlags,
+                                           uint64_t& pOffset,
+                                           int64_t& pAddend,
+                                           bool& pFit,
+                                           Buffer& pOut) const {
+  assert(!pGroup.empty());
+  writeSLEB(pGroup.size(), pOut);
+  writeSLEB(pFlags, pOut);
+  if (pFlags & GroupedByOffsetDelta)
+    writeSLEB(getDelta(pGroup.front()->offset, pOffset), pOut);
+  if (pFlags & GroupedByInfo)
+    writeSLEB(getDelta(pGroup.front()->info, 0), pOut);
+
+  Group::const_iterator entry, entryEnd = pGroup.end();
+  for (entry = pGroup.begin(); entry != entryEnd; ++entry) {
+    if ((pFlags & GroupedByOffsetDelta) == 0)
+      writeSLEB(getDelta((*entry)->offset, pOffset), pOut);
+    pOffset = (*entry)->offset;
+    if ((pFlags & GroupedByInfo) == 0)
+      writeSLEB(getDelta((*entry)->info, 0), pOut);
+    if (pFlags & GroupHasAddend) {
+      unsigned int width =
+          (*entry)->relative ? m_RelativeAddendWidth : m_AddendWidth;
+      int64_t delta = getDelta((*entry)->addend, pAddend);
+      if (!writeSLEB(delta, width, pOut) && pFit) {
+        error(diag::err_cannot_pack_dyn_reloc) << (*entry)->offset
+                                               << m_Section.name();
+        pFit = false;
+      }
+      pAddend = (*entry)->addend;
+    }
+  }
+  if ((pFlags & GroupHasAddend) == 0)
+    pAddend = 0;
+}
+
+void AndroidPackedRelocSection::writeSLEB(int64_t pValue, Buffer& pOut) const {
+  bool more = true;
+  while (more) {
+    uint8_t byte = pValue & 0x7f;
+    pValue >>= 7;
+    if ((pValue == 0 && (byte & 0x40) == 0) ||
+        (pValue == -1 && (byte & 0x40) != 0))
+      more = false;
+    else
+      byte |= 0x80;
+    pOut.push_back(byte);
+  }
+}
+
+bool AndroidPackedRelocSection::writeSLEB(int64_t pValue,
+                                          unsigned int pWidth,
+                                          Buffer& pOut) const {
+  int64_t value = pValue;
+  for (unsigned int i = 0; i < pWidth; ++i) {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (i + 1 < pWidth)
+      byte |= 0x80;
+    pOut.push_back(byte);
+  }
+  // the last byte must carry the sign
+  return (value == 0 && (pOut.back() & 0x40) == 0) ||
+         (value == -1 && (pOut.back() & 0x40) != 0);
+}
+
+int64_t AndroidPackedRelocSection::getDelta(uint64_t pTo,
+                                            uint64_t pFrom) const {
+  if (m_BitClass == 32)
+    return static_cast<int32_t>(static_cast<uint32_t>(pTo - pFrom));
+  return static_cast<int64_t>(pTo - pFrom);
+}
+
+}  // namespace mcld
@@ -7,6 +7,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "mcld/LD/ELFFileFormat.h"
+#include "mcld/Support/ELF.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Target/ELFDynamic.h"
 #include "mcld/Target/GNULDBackend.h"
@@ -142,15 +143,31 @@ void ELFDynamic::reserveEntries(const ELFFileFormat& pFormat) {
   }
 
   if (pFormat.hasRelDyn()) {
-    reserveOne(llvm::ELF::DT_REL);
-    reserveOne(llvm::ELF::DT_RELSZ);
-    reserveOne(llvm::ELF::DT_RELENT);
+    if (pFormat.getRelDyn().type() == ELF::SHT_ANDROID_REL) {
+      reserveOne(ELF::DT_ANDROID_REL);
+      reserveOne(ELF::DT_ANDROID_RELSZ);
+    } else {
+      reserveOne(llvm::ELF::DT_REL);
+      reserveOne(llvm::ELF::DT_RELSZ);
+      reserveOne(llvm::ELF::DT_RELENT);
+    }
   }
 
   if (pFormat.hasRelaDyn()) {
-    reserveOne(llvm::ELF::DT_RELA);
-    reserveOne(llvm::ELF::DT_RELASZ);
-    reserveOne(llvm::ELF::DT_RELAENT);
+    if (pFormat.getRelaDyn().type() == ELF::SHT_ANDROID_RELA) {
+      reserveOne(ELF::DT_ANDROID_RELA);
+      reserveOne(ELF::DT_ANDROID_RELASZ);
+    } else {
+      reserveOne(llvm::ELF::DT_RELA);
+      reserveOne(llvm::ELF::DT_RELASZ);
+      reserveOne(llvm::ELF::DT_RELAENT);
+    }
+  }
+
+  if (pFormat.hasRelrDyn()) {
+    reserveOne(ELF::DT_RELR);
+    reserveOne(ELF::DT_RELRSZ);
+    reserveOne(ELF::DT_RELRENT);
   }
 
   uint64_t dt_flags = 0x0;
@@ -246,15 +263,31 @@ void ELFDynamic::applyEntries(const ELFFileFormat& pFormat) {
   }
 
   if (pFormat.hasRelDyn()) {
-    applyOne(llvm::ELF::DT_REL, pFormat.getRelDyn().addr());
-    applyOne(llvm::ELF::DT_RELSZ, pFormat.getRelDyn().size());
-    applyOne(llvm::ELF::DT_RELENT, m_pEntryFactory->relSize());
+    if (pFormat.getRelDyn().type() == ELF::SHT_ANDROID_REL) {
+      applyOne(ELF::DT_ANDROID_REL, pFormat.getRelDyn().addr());
+      applyOne(ELF::DT_ANDROID_RELSZ, pFormat.getRelDyn().size());
+    } else {
+      applyOne(llvm::ELF::DT_REL, pFormat.getRelDyn().addr());
+      applyOne(llvm::ELF::DT_RELSZ, pFormat.getRelDyn().size());
+      applyOne(llvm::ELF::DT_RELENT, m_pEntryFactory->relSize());
+    }
   }
 
   if (pFormat.hasRelaDyn()) {
-    applyOne(llvm::ELF::DT_RELA, pFormat.getRelaDyn().addr());
-    applyOne(llvm::ELF::DT_RELASZ, pFormat.getRelaDyn().size());
-    applyOne(llvm::ELF::DT_RELAENT, m_pEntryFactory->relaSize());
+    if (pFormat.getRelaDyn().type() == ELF::SHT_ANDROID_RELA) {
+      applyOne(ELF::DT_ANDROID_RELA, pFormat.getRelaDyn().addr());
+      applyOne(ELF::DT_ANDROID_RELASZ, pFormat.getRelaDyn().size());
+    } else {
+      applyOne(llvm::ELF::DT_RELA, pFormat.getRelaDyn().addr());
+      applyOne(llvm::ELF::DT_RELASZ, pFormat.getRelaDyn().size());
+      applyOne(llvm::ELF::DT_RELAENT, m_pEntryFactory->relaSize());
+    }
+  }
+
+  if (pFormat.hasRelrDyn()) {
+    applyOne(ELF::DT_RELR, pFormat.getRelrDyn().addr());
+    applyOne(ELF::DT_RELRSZ, pFormat.getRelrDyn().size());
+    applyOne(ELF::DT_RELRENT, m_Config.targets().bitclass() / 8);
   }
 
   if (m_Backend.hasTextRel()) {
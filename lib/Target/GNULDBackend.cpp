@@ -38,17 +38,20 @@
 #include "mcld/Script/RpnEvaluator.h"
 #include "mcld/Support/FileOutputBuffer.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/raw_ostream.h"
+#include "mcld/Target/AndroidPackedRelocSection.h"
 #include "mcld/Target/ELFAttribute.h"
 #include "mcld/Target/ELFDynamic.h"
 #include "mcld/Target/GNUInfo.h"
+#include "mcld/Target/RelrSection.h"
 
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Format.h>
 #include <llvm/Support/Host.h>
 
 #include <algorithm>
 #include <cstring>
 #include <cassert>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -79,6 +82,7 @@ namespace mcld {
 GNULDBackend::GNULDBackend(const LinkerConfig& pConfig, GNUInfo* pInfo)
     : TargetLDBackend(pConfig),
       m_pObjectReader(NULL),
+      m_pDynObjReader(NULL),
       m_pDynObjFileFormat(NULL),
       m_pExecFileFormat(NULL),
       m_pObjectFileFormat(NULL),
@@ -88,6 +92,9 @@ GNULDBackend::GNULDBackend(const LinkerConfig& pConfig, GNUInfo* pInfo)
       m_pStubFactory(NULL),
       m_pEhFrameHdr(NULL),
       m_pAttribute(NULL),
+      m_pRelrDyn(NULL),
+      m_pAndroidRelDyn(NULL),
+      m_GNUHashBucketCount(0),
       m_bHasTextRel(false),
       m_bHasStaticTLS(false),
       f_pPreInitArrayStart(NULL),
@@ -123,6 +130,8 @@ GNULDBackend::~GNULDBackend() {
   delete m_pSymIndexMap;
   delete m_pEhFrameHdr;
   delete m_pAttribute;
+  delete m_pRelrDyn;
+  delete m_pAndroidRelDyn;
   delete m_pBRIslandFactory;
   delete m_pStubFactory;
 }
@@ -158,7 +167,7 @@ uint64_t GNULDBackend::getSegmentStartAddr(const LinkerScript& pScript) const {
 
 GNUArchiveReader* GNULDBackend::createArchiveReader(Module& pModule) {
   assert(m_pObjectReader != NULL);
-  return new GNUArchiveReader(pModule, *m_pObjectReader);
+  return new GNUArchiveReader(pModule, *m_pObjectReader, m_pDynObjReader);
 }
 
 ELFObjectReader* GNULDBackend::createObjectReader(IRBuilder& pBuilder) {
@@ -167,7 +176,8 @@ ELFObjectReader* GNULDBackend::createObjectReader(IRBuilder& pBuilder) {
 }
 
 ELFDynObjReader* GNULDBackend::createDynObjReader(IRBuilder& pBuilder) {
-  return new ELFDynObjReader(*this, pBuilder, config());
+  m_pDynObjReader = new ELFDynObjReader(*this, pBuilder, config());
+  return m_pDynObjReader;
 }
 
 ELFBinaryReader* GNULDBackend::createBinaryReader(IRBuilder& pBuilder) {
@@ -777,18 +787,16 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
         // compute .gnu.hash
         if (GeneralOptions::GNU == config().options().getHashStyle() ||
             GeneralOptions::Both == config().options().getHashStyle()) {
-          // count the number of dynsym to hash
-          size_t hashed_sym_cnt = 0;
-          symEnd = symbols.dynamicEnd();
-          for (symbol = symbols.dynamicBegin(); symbol != symEnd; ++symbol) {
-            if (DynsymCompare().needGNUHash(**symbol))
-              ++hashed_sym_cnt;
-          }
+          // hash the dynsym and choose the bucket count by the hashes
+          std::vector<uint32_t> hashes;
+          computeGNUHashes(symbols, hashes);
+          size_t hashed_sym_cnt = hashes.size();
           // Special case for empty .dynsym
           if (hashed_sym_cnt == 0)
             gnuhash = 5 * 4 + config().targets().bitclass() / 8;
           else {
-            size_t nbucket = getHashBucketCount(hashed_sym_cnt, true);
+            m_GNUHashBucketCount = getGNUHashBucketCount(hashes);
+            size_t nbucket = m_GNUHashBucketCount;
             gnuhash = (4 + nbucket + hashed_sym_cnt) * 4;
             gnuhash += (1U << getGNUHashMaskbitslog2(hashed_sym_cnt)) / 8;
           }
@@ -798,7 +806,7 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
         if (GeneralOptions::SystemV == config().options().getHashStyle() ||
             GeneralOptions::Both == config().options().getHashStyle()) {
           // Both Elf32_Word and Elf64_Word are 4 bytes
-          hash = (2 + getHashBucketCount(dynsym, false) + dynsym) *
+          hash = (2 + getELFHashBucketCount(dynsym) + dynsym) *
                  sizeof(llvm::ELF::Elf32_Word);
         }
 
@@ -1115,7 +1123,7 @@ void GNULDBackend::emitELFHashTab(const Module::SymbolTable& pSymtab,
   uint32_t& nchain = word_array[1];
 
   size_t dynsymSize = 1 + pSymtab.numOfLocalDyns() + pSymtab.numOfDynamics();
-  nbucket = getHashBucketCount(dynsymSize, false);
+  nbucket = getELFHashBucketCount(dynsymSize);
   nchain = dynsymSize;
 
   uint32_t* bucket = (word_array + 2);
@@ -1196,8 +1204,18 @@ void GNULDBackend::emitGNUHashTab(Module::SymbolTable& pSymtab,
   uint32_t shift1 = config().targets().is32Bits() ? 5 : 6;
   uint32_t mask = (1u << shift1) - 1;
 
-  nbucket = getHashBucketCount(hashed_sym_cnt, true);
+  // the hashed symbols follow the unhashed ones
   symidx = 1 + unhashed_sym_cnt;
+  Module::SymbolTable::iterator hashed = pSymtab.localDynBegin() + symidx - 1;
+  std::vector<uint32_t> hashes(hashed_sym_cnt);
+  for (size_t i = 0; i < hashed_sym_cnt; ++i) {
+    hash::StringHash<hash::DJB> hasher;
+    hashes[i] = hasher((*(hashed + i))->name());
+  }
+
+  nbucket = m_GNUHashBucketCount;
+  if (nbucket == 0)
+    nbucket = getGNUHashBucketCount(hashes);
   maskwords = 1 << (maskbitslog2 - shift1);
   shift2 = maskbitslog2;
 
@@ -1205,50 +1223,49 @@ void GNULDBackend::emitGNUHashTab(Module::SymbolTable& pSymtab,
   bucket = reinterpret_cast<uint32_t*>(bitmask + maskbits / 8);
   chain = (bucket + nbucket);
 
-  // build the gnu style hash table
-  typedef std::multimap<uint32_t, std::pair<LDSymbol*, uint32_t> > SymMapType;
-  SymMapType symmap;
-  symEnd = pSymtab.dynamicEnd();
-  for (symbol = pSymtab.localDynBegin() + symidx - 1; symbol != symEnd;
-       ++symbol) {
-    hash::StringHash<hash::DJB> hasher;
-    uint32_t djbhash = hasher((*symbol)->name());
-    uint32_t hash = djbhash % nbucket;
-    symmap.insert(std::make_pair(hash, std::make_pair(*symbol, djbhash)));
-  }
+  // Sort the hashed symbols by bucket, so that every chain is contiguous in
+  // .dynsym. The sort is stable to keep the output deterministic.
+  std::vector<uint32_t> start(nbucket + 1, 0);
+  for (size_t i = 0; i < hashed_sym_cnt; ++i)
+    ++start[hashes[i] % nbucket + 1];
+  for (size_t idx = 0; idx < nbucket; ++idx)
+    start[idx + 1] += start[idx];
+
+  std::vector<LDSymbol*> sorted_syms(hashed_sym_cnt);
+  std::vector<uint32_t> sorted_hashes(hashed_sym_cnt);
+  std::vector<uint32_t> pos(start.begin(), start.end() - 1);
+  for (size_t i = 0; i < hashed_sym_cnt; ++i) {
+    uint32_t& p = pos[hashes[i] % nbucket];
+    sorted_syms[p] = *(hashed + i);
+    sorted_hashes[p] = hashes[i];
+    ++p;
+  }
+  std::copy(sorted_syms.begin(), sorted_syms.end(), hashed);
 
   // compute bucket, chain, and bitmask
   std::vector<uint64_t> bitmasks(maskwords);
-  size_t hashedidx = symidx;
   for (size_t idx = 0; idx < nbucket; ++idx) {
-    size_t count = 0;
-    std::pair<SymMapType::iterator, SymMapType::iterator> ret;
-    ret = symmap.equal_range(idx);
-    for (SymMapType::iterator it = ret.first; it != ret.second;) {
-      // rearrange the hashed symbol ordering
-      *(pSymtab.localDynBegin() + hashedidx - 1) = it->second.first;
-      uint32_t djbhash = it->second.second;
+    if (start[idx] == start[idx + 1]) {
+      bucket[idx] = 0;
+      continue;
+    }
+    bucket[idx] = symidx + start[idx];
+    for (uint32_t i = start[idx]; i < start[idx + 1]; ++i) {
+      uint32_t djbhash = sorted_hashes[i];
       uint32_t val = ((djbhash >> shift1) & ((maskbits >> shift1) - 1));
-      bitmasks[val] |= 1u << (djbhash & mask);
-      bitmasks[val] |= 1u << ((djbhash >> shift2) & mask);
+      bitmasks[val] |= UINT64_C(1) << (djbhash & mask);
+      bitmasks[val] |= UINT64_C(1) << ((djbhash >> shift2) & mask);
+      // the last element terminates the chain
       val = djbhash & ~1u;
-      // advance the iterator and check if we're dealing w/ the last elment
-      if (++it == ret.second) {
-        // last element terminates the chain
+      if (i + 1 == start[idx + 1])
         val |= 1;
-      }
-      chain[hashedidx - symidx] = val;
-
-      ++hashedidx;
-      ++count;
+      chain[i] = val;
     }
-
-    if (count == 0)
-      bucket[idx] = 0;
-    else
-      bucket[idx] = hashedidx - count;
   }
 
+  if (config().options().printHashStats())
+    printGNUHashStats(start, maskbits);
+
   // write the bitmasks
   if (config().targets().is32Bits()) {
     uint32_t* maskval = reinterpret_cast<uint32_t*>(bitmask);
@@ -2445,7 +2462,7 @@ void GNULDBackend::layout(Module& pModule) {
 
   // 2. update output sections in Module
   SectionMap& sectionMap = pModule.getScript().sectionMap();
-  pModule.getSectionTable().clear();
+  pModule.clearSections();
   for (SectionMap::iterator out = sectionMap.begin(), outEnd = sectionMap.end();
        out != outEnd;
        ++out) {
@@ -2454,7 +2471,7 @@ void GNULDBackend::layout(Module& pModule) {
         (*out)->getSection()->kind() == LDFileFormat::StackNote ||
         config().codeGenType() == LinkerConfig::Object) {
       (*out)->getSection()->setIndex(pModule.size());
-      pModule.getSectionTable().push_back((*out)->getSection());
+      pModule.addSection(*(*out)->getSection());
     }
   }  // for each output section description
 
@@ -2500,6 +2517,15 @@ void GNULDBackend::preLayout(Module& pModule, IRBuilder& pBuilder) {
   // prelayout target first
   doPreLayout(pBuilder);
 
+  // move relative relocations to .relr.dyn. Target sizes .got before, so the
+  // offsets of GOT entries are known.
+  if (config().options().hasPackRelativeRelocs())
+    packRelativeRelocs(pModule);
+
+  // pack the remaining dynamic relocations
+  if (config().options().hasAndroidPackedRelocs())
+    packAndroidRelocs(pModule);
+
   // change .tbss and .tdata section symbol from Local to LocalDyn category
   if (f_pTDATA != NULL)
     pModule.getSymbolTable().changeToDynamic(*f_pTDATA);
@@ -2523,7 +2549,7 @@ void GNULDBackend::preLayout(Module& pModule, IRBuilder& pBuilder) {
               (*rs)->name(), (*rs)->kind(), (*rs)->type(), (*rs)->flag());
 
           output_sect->setAlign((*rs)->align());
-          pModule.getSectionTable().push_back(output_sect);
+          pModule.addSection(*output_sect);
         }
 
         // set output relocation section link
@@ -2571,6 +2597,20 @@ void GNULDBackend::postLayout(Module& pModule, IRBuilder& pBuilder) {
   if (LinkerConfig::Object != config().codeGenType()) {
     // do relaxation
     relax(pModule, pBuilder);
+
+    // Packed relocations are encoded by the final addresses, and their sizes
+    // move the sections after them. Iterate with relaxation until the layout
+    // is stable.
+    while (updatePackedRelocSizes(pModule)) {
+      if (!mayRelax())
+        continue;
+      bool finished = true;
+      do {
+        if (doRelax(pModule, pBuilder, finished))
+          setOutputSectionAddress(pModule);
+      } while (!finished);
+    }
+
     // set up the attributes of program headers
     setupProgramHdrs(pModule.getScript());
   }
@@ -2584,6 +2624,146 @@ void GNULDBackend::postProcessing(FileOutputBuffer& pOutput) {
     // emit eh_frame_hdr
     m_pEhFrameHdr->emitOutput<32>(pOutput);
   }
+
+  // RELR has no addend field. The addends of the relative relocations taken
+  // from .rela.dyn are stored in their places.
+  if (m_pRelrDyn != NULL && getOutputFormat()->getRelaDyn().hasRelocData())
+    m_pRelrDyn->applyAddends(pOutput);
+}
+
+void GNULDBackend::packRelativeRelocs(Module& pModule) {
+  if (LinkerConfig::Object == config().codeGenType() ||
+      config().isCodeStatic())
+    return;
+
+  ELFFileFormat* file_format = getOutputFormat();
+  LDSection* rel_dyn = NULL;
+  if (file_format->getRelaDyn().hasRelocData())
+    rel_dyn = &file_format->getRelaDyn();
+  else if (file_format->getRelDyn().hasRelocData())
+    rel_dyn = &file_format->getRelDyn();
+  else
+    return;
+
+  // The eligibility is decided before layout by the alignment of the places
+  // in their output sections. updatePackedRelocSizes() checks it again by
+  // the final addresses.
+  unsigned int word_size = config().targets().bitclass() / 8;
+  RelrSection* relr =
+      new RelrSection(file_format->getRelrDyn(), *rel_dyn, word_size);
+  RelocData* reloc_data = rel_dyn->getRelocData();
+  RelocData::iterator reloc = reloc_data->begin();
+  while (reloc != reloc_data->end()) {
+    Relocation& rel = *reloc;
+    ++reloc;
+    if (!isRelativeReloc(rel) || !rel.targetRef().frag()->hasOffset())
+      continue;
+    const LDSection& target =
+        rel.targetRef().frag()->getParent()->getSection();
+    if (target.align() < word_size ||
+        (rel.targetRef().getOutputOffset() % word_size) != 0)
+      continue;
+    reloc_data->remove(rel);
+    relr->add(rel);
+  }
+
+  if (relr->empty()) {
+    delete relr;
+    return;
+  }
+  m_pRelrDyn = relr;
+
+  if (llvm::ELF::SHT_RELA == rel_dyn->type())
+    rel_dyn->setSize(reloc_data->size() * getRelaEntrySize());
+  else
+    rel_dyn->setSize(reloc_data->size() * getRelEntrySize());
+
+  // reserve one entry for now, .relr.dyn is sized after layout
+  m_pRelrDyn->getSection().setSize(word_size);
+}
+
+void GNULDBackend::packAndroidRelocs(Module& pModule) {
+  if (LinkerConfig::Object == config().codeGenType() ||
+      config().isCodeStatic())
+    return;
+
+  ELFFileFormat* file_format = getOutputFormat();
+  LDSection* rel_dyn = NULL;
+  if (file_format->getRelaDyn().hasRelocData())
+    rel_dyn = &file_format->getRelaDyn();
+  else if (file_format->getRelDyn().hasRelocData())
+    rel_dyn = &file_format->getRelDyn();
+  else
+    return;
+
+  RelocData* reloc_data = rel_dyn->getRelocData();
+  if (reloc_data->empty())
+    return;
+
+  // Some targets reserve blank entries and fill them when applying
+  // relocations, after the section is sized.
+  RelocData::const_iterator reloc, relocEnd = reloc_data->end();
+  for (reloc = reloc_data->begin(); reloc != relocEnd; ++reloc) {
+    if (reloc->targetRef().frag() == NULL) {
+      warning(diag::warn_cannot_pack_dyn_relocs) << rel_dyn->name();
+      return;
+    }
+  }
+
+  m_pAndroidRelDyn = new AndroidPackedRelocSection(
+      *this, *rel_dyn, config().targets().bitclass());
+}
+
+bool GNULDBackend::updatePackedRelocSizes(Module& pModule) {
+  bool changed = false;
+  if (m_pRelrDyn != NULL) {
+    // a place misaligned by the layout cannot be encoded in .relr.dyn. Keep
+    // it in .rel.dyn/.rela.dyn, which only grows, so the iteration converges.
+    // A packed .rel.dyn/.rela.dyn is resized by its encoding below.
+    if (m_pRelrDyn->giveBackUnaligned() != 0) {
+      LDSection& rel_dyn = m_pRelrDyn->getRelDyn();
+      size_t count = rel_dyn.getRelocData()->size();
+      if (m_pAndroidRelDyn == NULL) {
+        if (llvm::ELF::SHT_RELA == rel_dyn.type())
+          rel_dyn.setSize(count * getRelaEntrySize());
+        else
+          rel_dyn.setSize(count * getRelEntrySize());
+      }
+      changed = true;
+    }
+    if (m_pRelrDyn->finalizeSectionSize())
+      changed = true;
+  }
+
+  if (m_pAndroidRelDyn != NULL) {
+    uint64_t addr_end = 0;
+    Module::const_iterator sect, sectEnd = pModule.end();
+    for (sect = pModule.begin(); sect != sectEnd; ++sect) {
+      if (((*sect)->flag() & llvm::ELF::SHF_ALLOC) != 0 &&
+          (*sect)->addr() + (*sect)->size() > addr_end)
+        addr_end = (*sect)->addr() + (*sect)->size();
+    }
+    const LDSection& dynsym = getOutputFormat()->getDynSymTab();
+    size_t num_dynsyms = config().targets().is32Bits()
+                             ? dynsym.size() / sizeof(llvm::ELF::Elf32_Sym)
+                             : dynsym.size() / sizeof(llvm::ELF::Elf64_Sym);
+    if (m_pAndroidRelDyn->finalizeSectionSize(addr_end, num_dynsyms))
+      changed = true;
+  }
+
+  if (changed)
+    setOutputSectionAddress(pModule);
+  return changed;
+}
+
+void GNULDBackend::emitRelrDyn(MemoryRegion& pRegion) const {
+  assert(m_pRelrDyn != NULL && "Emit .relr.dyn without packed relocations!");
+  m_pRelrDyn->emit(pRegion);
+}
+
+void GNULDBackend::emitAndroidRelDyn(MemoryRegion& pRegion) const {
+  assert(m_pAndroidRelDyn != NULL && "Emit unpacked relocations as APS2!");
+  m_pAndroidRelDyn->emit(pRegion);
 }
 
 /// getHashBucketCount - calculate hash bucket count.
@@ -2610,21 +2790,106 @@ unsigned GNULDBackend::getHashBucketCount(unsigned pNumOfSymbols,
 
 /// getGNUHashMaskbitslog2 - calculate the number of mask bits in log2
 unsigned GNULDBackend::getGNUHashMaskbitslog2(unsigned pNumOfSymbols) const {
-  uint32_t maskbitslog2 = 1;
-  for (uint32_t x = pNumOfSymbols >> 1; x != 0; x >>= 1)
+  // Every symbol sets two bits of the bloom filter. With at least 12 bits
+  // per symbol, about 2% of the failed lookups pass the filter and probe a
+  // chain.
+  uint32_t maskbitslog2 = (config().targets().bitclass() == 64) ? 6 : 5;
+  while ((UINT64_C(1) << maskbitslog2) < UINT64_C(12) * pNumOfSymbols)
     ++maskbitslog2;
 
-  if (maskbitslog2 < 3)
-    maskbitslog2 = 5;
-  else if (((1U << (maskbitslog2 - 2)) & pNumOfSymbols) != 0)
-    maskbitslog2 += 3;
-  else
-    maskbitslog2 += 2;
+  return maskbitslog2;
+}
 
-  if (config().targets().bitclass() == 64 && maskbitslog2 == 5)
-    maskbitslog2 = 6;
+/// getELFHashBucketCount - the bucket count of .hash
+unsigned GNULDBackend::getELFHashBucketCount(unsigned pNumOfSymbols) const {
+  if (config().options().getHashSize() != 0)
+    return config().options().getHashSize();
+  return getHashBucketCount(pNumOfSymbols, false);
+}
 
-  return maskbitslog2;
+/// computeGNUHashes - compute the hashes of the dynamic symbols which are put
+/// in .gnu.hash
+void GNULDBackend::computeGNUHashes(const Module::SymbolTable& pSymtab,
+                                    std::vector<uint32_t>& pHashes) const {
+  pHashes.clear();
+  Module::const_sym_iterator symbol, symEnd = pSymtab.dynamicEnd();
+  for (symbol = pSymtab.dynamicBegin(); symbol != symEnd; ++symbol) {
+    if (!DynsymCompare().needGNUHash(**symbol))
+      continue;
+    hash::StringHash<hash::DJB> hasher;
+    pHashes.push_back(hasher((*symbol)->name()));
+  }
+}
+
+/// getGNUHashBucketCount - choose the bucket count of .gnu.hash
+unsigned GNULDBackend::getGNUHashBucketCount(
+    const std::vector<uint32_t>& pHashes) const {
+  if (config().options().getHashSize() != 0)
+    return config().options().getHashSize();
+
+  // A lookup walks the chain of its bucket, so the symbols in a chain of c
+  // symbols cost c * (c + 1) / 2 probes in total. As bfd ld does, weigh the
+  // probes against the table size:
+  //   (n + sum(c * c)) * (2 + n + nbucket)
+  // Its expectation is the smallest near nbucket = n / sqrt(2), so only the
+  // bucket counts around it are tried.
+  const uint64_t num = pHashes.size();
+  const uint64_t center = std::max<uint64_t>(1, num * 7 / 10);
+  const uint64_t first = (center > 32) ? center - 32 : 1;
+  const uint64_t last = center + 32;
+
+  std::vector<uint32_t> counts;
+  uint64_t best = center;
+  uint64_t best_cost = ~UINT64_C(0);
+  for (uint64_t nbucket = first; nbucket <= last; ++nbucket) {
+    counts.assign(nbucket, 0);
+    for (size_t i = 0; i < pHashes.size(); ++i)
+      ++counts[pHashes[i] % nbucket];
+
+    uint64_t cost = num;
+    for (size_t i = 0; i < nbucket; ++i)
+      cost += static_cast<uint64_t>(counts[i]) * counts[i];
+    cost *= (2 + num + nbucket);
+
+    if (cost < best_cost) {
+      best_cost = cost;
+      best = nbucket;
+    }
+  }
+  return static_cast<unsigned>(best);
+}
+
+/// printGNUHashStats - print the chain lengths of .gnu.hash
+void GNULDBackend::printGNUHashStats(const std::vector<uint32_t>& pStart,
+                                     uint32_t pMaskBits) const {
+  const size_t nbucket = pStart.size() - 1;
+  const size_t num = pStart.back();
+  const size_t max_len = 8;
+
+  std::vector<size_t> histogram(max_len + 1, 0);
+  size_t longest = 0;
+  uint64_t probes = 0;
+  for (size_t idx = 0; idx < nbucket; ++idx) {
+    size_t len = pStart[idx + 1] - pStart[idx];
+    ++histogram[std::min(len, max_len)];
+    longest = std::max(longest, len);
+    probes += static_cast<uint64_t>(len) * (len + 1) / 2;
+  }
+
+  mcld::outs() << ".gnu.hash: " << num << " symbols, " << nbucket
+               << " buckets, " << pMaskBits << " bloom filter bits\n";
+  mcld::outs() << "  chain length    buckets\n";
+  for (size_t len = 0; len <= max_len; ++len) {
+    const char* prefix = (len == max_len) ? ">=" : "  ";
+    mcld::outs() << llvm::format("  %s%-11u %10u\n",
+                                 prefix,
+                                 static_cast<unsigned>(len),
+                                 static_cast<unsigned>(histogram[len]));
+  }
+  mcld::outs() << llvm::format(
+      "  longest chain: %u, probes per successful lookup: %.2f\n",
+      static_cast<unsigned>(longest),
+      (num == 0) ? 0.0 : static_cast<double>(probes) / num);
 }
 
 /// isDynamicSymbol
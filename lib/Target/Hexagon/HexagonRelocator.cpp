@@ -481,13 +481,8 @@ void HexagonRelocator::partialScanRelocation(Relocation& pReloc,
 
     // 1. update the relocation target offset
     assert(input_sym->hasFragRef());
-    // 2. get the output LDSection which the symbol defined in
-    const LDSection& out_sect =
-        input_sym->fragRef()->frag()->getParent()->getSection();
-    ResolveInfo* sym_info =
-        pModule.getSectionSymbolSet().get(out_sect)->resolveInfo();
-    // set relocation target symbol to the output section symbol's resolveInfo
-    pReloc.setSymInfo(sym_info);
+    // 2. set relocation target symbol to the output section symbol
+    pReloc.setSymInfo(getOutputSectionSymbol(*input_sym, pModule));
   }
 }
 
@@ -17,6 +17,8 @@
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/ELF.h>
 
+#include <algorithm>
+
 namespace {
 const uint32_t Mips32ModulePtr = 1 << 31;
 const uint64_t Mips64ModulePtr = 1ull << 63;
@@ -39,10 +41,6 @@ MipsGOT::GOTMultipart::GOTMultipart(size_t local, size_t global)
       m_pLastGlobal(NULL) {
 }
 
-bool MipsGOT::GOTMultipart::isConsumed() const {
-  return m_LocalNum == m_ConsumedLocal && m_GlobalNum == m_ConsumedGlobal;
-}
-
 void MipsGOT::GOTMultipart::consumeLocal() {
   assert(m_ConsumedLocal < m_LocalNum && "Consumed too many local GOT entries");
   ++m_ConsumedLocal;
@@ -75,11 +73,46 @@ bool MipsGOT::LocalEntry::operator<(const LocalEntry& O) const {
   return m_IsGot16 < O.m_IsGot16;
 }
 
+//===----------------------------------------------------------------------===//
+// MipsGOT::InputDemand
+//===----------------------------------------------------------------------===//
+MipsGOT::InputDemand::InputDemand(const Input* pInput) : m_pInput(pInput) {
+}
+
+//===----------------------------------------------------------------------===//
+// MipsGOT::GOTBin
+//===----------------------------------------------------------------------===//
+size_t MipsGOT::GOTBin::growth(const InputDemand& pDemand) const {
+  size_t result = 0;
+  for (LocalSymbolSetType::const_iterator it = pDemand.m_Locals.begin(),
+                                          end = pDemand.m_Locals.end();
+       it != end;
+       ++it) {
+    if (!m_Locals.count(*it))
+      ++result;
+  }
+
+  for (std::vector<ResolveInfo*>::const_iterator
+           it = pDemand.m_Globals.begin(), end = pDemand.m_Globals.end();
+       it != end;
+       ++it) {
+    if (!m_Globals.count(*it))
+      ++result;
+  }
+  return result;
+}
+
+void MipsGOT::GOTBin::add(const InputDemand& pDemand, size_t pIndex) {
+  m_Locals.insert(pDemand.m_Locals.begin(), pDemand.m_Locals.end());
+  m_Globals.insert(pDemand.m_Globals.begin(), pDemand.m_Globals.end());
+  m_Inputs.push_back(pIndex);
+}
+
 //===----------------------------------------------------------------------===//
 // MipsGOT
 //===----------------------------------------------------------------------===//
 MipsGOT::MipsGOT(LDSection& pSection)
-    : GOT(pSection), m_pInput(NULL), m_CurrentGOTPart(0) {
+    : GOT(pSection), m_CurrentGOTPart(0) {
 }
 
 uint64_t MipsGOT::getGPDispAddress() const {
@@ -92,14 +125,170 @@ void MipsGOT::reserve(size_t pNum) {
 }
 
 bool MipsGOT::hasGOT1() const {
-  return !m_MultipartList.empty();
+  return !m_InputDemands.empty();
 }
 
 bool MipsGOT::hasMultipleGOT() const {
   return m_MultipartList.size() > 1;
 }
 
+void MipsGOT::getSecondaryGOTSections(
+    std::vector<const LDSection*>& pSections) const {
+  for (InputDemandListType::const_iterator it = m_InputDemands.begin(),
+                                           end = m_InputDemands.end();
+       it != end;
+       ++it) {
+    InputPartMapType::const_iterator part = m_InputPart.find(it->m_pInput);
+    if (part != m_InputPart.end() && part->second > 0)
+      pSections.insert(
+          pSections.end(), it->m_Sections.begin(), it->m_Sections.end());
+  }
+}
+
+size_t MipsGOT::getMaxEntryNum() const {
+  return MipsGOTSize / getEntrySize() - MipsGOT0Num;
+}
+
+void MipsGOT::partitionInInputOrder(PartitionType& pParts) const {
+  pParts.clear();
+  for (size_t i = 0; i < m_InputDemands.size(); ++i) {
+    const InputDemand& demand = m_InputDemands[i];
+    if (pParts.empty() ||
+        pParts.back().size() + pParts.back().growth(demand) >
+            getMaxEntryNum())
+      pParts.push_back(GOTBin());
+    pParts.back().add(demand, i);
+  }
+}
+
+namespace {
+
+struct DemandSizeCompare {
+  explicit DemandSizeCompare(const std::vector<size_t>& pSizes)
+      : m_Sizes(pSizes) {
+  }
+
+  bool operator()(size_t pX, size_t pY) const {
+    return m_Sizes[pX] > m_Sizes[pY];
+  }
+
+  const std::vector<size_t>& m_Sizes;
+};
+
+struct BinSizeCompare {
+  template <typename BinType>
+  bool operator()(const BinType& pX, const BinType& pY) const {
+    return pX.size() > pY.size();
+  }
+};
+
+}  // anonymous namespace
+
+void MipsGOT::partitionByBinPacking(PartitionType& pParts) const {
+  pParts.clear();
+
+  // Place the inputs needing the most entries first.
+  std::vector<size_t> sizes(m_InputDemands.size());
+  std::vector<size_t> order(m_InputDemands.size());
+  for (size_t i = 0; i < m_InputDemands.size(); ++i) {
+    sizes[i] = m_InputDemands[i].size();
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), DemandSizeCompare(sizes));
+
+  // Each input goes to the GOT which has the most of its entries already,
+  // or to a new GOT if it fits nowhere.
+  for (size_t i = 0; i < order.size(); ++i) {
+    const InputDemand& demand = m_InputDemands[order[i]];
+    size_t best = pParts.size();
+    size_t bestGrowth = 0;
+    for (size_t part = 0; part < pParts.size(); ++part) {
+      size_t growth = pParts[part].growth(demand);
+      if (pParts[part].size() + growth > getMaxEntryNum())
+        continue;
+      if (best == pParts.size() || growth < bestGrowth) {
+        best = part;
+        bestGrowth = growth;
+      }
+    }
+    if (best == pParts.size())
+      pParts.push_back(GOTBin());
+    pParts[best].add(demand, order[i]);
+  }
+
+  // The largest GOT is the primary one, which needs no dynamic relocations.
+  std::stable_sort(pParts.begin(), pParts.end(), BinSizeCompare());
+
+  // Keep the input order in each GOT, so that the global symbols are
+  // consumed in the order they are referenced.
+  for (PartitionType::iterator it = pParts.begin(); it != pParts.end(); ++it)
+    std::sort(it->m_Inputs.begin(), it->m_Inputs.end());
+}
+
+size_t MipsGOT::countDynRels(const PartitionType& pParts) {
+  // FIXME: (simon) Do not count local entries for non-pic.
+  size_t result = 0;
+  for (size_t i = 1; i < pParts.size(); ++i)
+    result += pParts[i].size();
+  return result;
+}
+
+void MipsGOT::applyPartition(const PartitionType& pParts) {
+  m_MultipartList.clear();
+  m_InputPart.clear();
+  m_SymbolOrderMap.clear();
+
+  for (size_t part = 0; part < pParts.size(); ++part) {
+    const GOTBin& bin = pParts[part];
+    m_MultipartList.push_back(
+        GOTMultipart(bin.m_Locals.size(), bin.m_Globals.size()));
+
+    for (std::vector<size_t>::const_iterator it = bin.m_Inputs.begin(),
+                                             end = bin.m_Inputs.end();
+         it != end;
+         ++it) {
+      const InputDemand& demand = m_InputDemands[*it];
+      m_MultipartList.back().m_Inputs.insert(demand.m_pInput);
+      m_InputPart[demand.m_pInput] = part;
+
+      // The global entries of the primary GOT come first in .dynsym, in the
+      // order they are referenced.
+      for (std::vector<ResolveInfo*>::const_iterator
+               sym = demand.m_Globals.begin(), symEnd = demand.m_Globals.end();
+           sym != symEnd;
+           ++sym) {
+        ResolveInfo* info = *sym;
+        if (info->reserved() & MipsRelocator::ReserveGot)
+          continue;
+        unsigned int order = m_SymbolOrderMap.size();
+        m_SymbolOrderMap[info->outSymbol()] = order;
+        info->setReserved(info->reserved() | MipsRelocator::ReserveGot);
+      }
+    }
+  }
+}
+
 void MipsGOT::finalizeScanning(OutputRelocSection& pRelDyn) {
+  PartitionType inputOrder;
+  partitionInInputOrder(inputOrder);
+
+  if (inputOrder.size() <= 1) {
+    applyPartition(inputOrder);
+  } else {
+    PartitionType binPacked;
+    partitionByBinPacking(binPacked);
+
+    size_t inputOrderRels = countDynRels(inputOrder);
+    size_t binPackedRels = countDynRels(binPacked);
+    note(diag::note_mips_multi_got) << inputOrder.size() << inputOrderRels
+                                    << binPacked.size() << binPackedRels;
+
+    if (binPackedRels <= inputOrderRels)
+      applyPartition(binPacked);
+    else
+      applyPartition(inputOrder);
+  }
+
   for (MultipartListType::iterator it = m_MultipartList.begin();
        it != m_MultipartList.end();
        ++it) {
@@ -135,133 +324,45 @@ bool MipsGOT::dynSymOrderCompare(const LDSymbol* pX, const LDSymbol* pY) const {
   return itX == m_SymbolOrderMap.end() && itY != m_SymbolOrderMap.end();
 }
 
-void MipsGOT::initGOTList() {
-  m_SymbolOrderMap.clear();
-
-  m_MultipartList.clear();
-  m_MultipartList.push_back(GOTMultipart());
-
-  m_MultipartList.back().m_Inputs.insert(m_pInput);
-
-  m_MergedGlobalSymbols.clear();
-  m_InputGlobalSymbols.clear();
-  m_MergedLocalSymbols.clear();
-  m_InputLocalSymbols.clear();
-}
-
-void MipsGOT::changeInput() {
-  m_MultipartList.back().m_Inputs.insert(m_pInput);
-
-  for (LocalSymbolSetType::iterator it = m_InputLocalSymbols.begin(),
-                                    end = m_InputLocalSymbols.end();
-       it != end;
-       ++it)
-    m_MergedLocalSymbols.insert(*it);
-
-  m_InputLocalSymbols.clear();
-
-  for (SymbolUniqueMapType::iterator it = m_InputGlobalSymbols.begin(),
-                                     end = m_InputGlobalSymbols.end();
-       it != end;
-       ++it)
-    m_MergedGlobalSymbols.insert(it->first);
-
-  m_InputGlobalSymbols.clear();
-}
-
-bool MipsGOT::isGOTFull() const {
-  uint64_t gotCount = MipsGOT0Num + m_MultipartList.back().m_LocalNum +
-                      m_MultipartList.back().m_GlobalNum;
-
-  gotCount += 1;
-
-  return gotCount * getEntrySize() > MipsGOTSize;
-}
-
-void MipsGOT::split() {
-  m_MergedLocalSymbols.clear();
-  m_MergedGlobalSymbols.clear();
-
-  size_t uniqueCount = 0;
-  for (SymbolUniqueMapType::const_iterator it = m_InputGlobalSymbols.begin(),
-                                           end = m_InputGlobalSymbols.end();
-       it != end;
-       ++it) {
-    if (it->second)
-      ++uniqueCount;
-  }
-
-  m_MultipartList.back().m_LocalNum -= m_InputLocalSymbols.size();
-  m_MultipartList.back().m_GlobalNum -= uniqueCount;
-  m_MultipartList.back().m_Inputs.erase(m_pInput);
-
-  m_MultipartList.push_back(
-      GOTMultipart(m_InputLocalSymbols.size(), m_InputGlobalSymbols.size()));
-  m_MultipartList.back().m_Inputs.insert(m_pInput);
-}
-
 void MipsGOT::initializeScan(const Input& pInput) {
-  if (m_pInput == NULL) {
-    m_pInput = &pInput;
-    initGOTList();
-  } else {
-    m_pInput = &pInput;
-    changeInput();
-  }
+  m_InputDemands.push_back(InputDemand(&pInput));
 }
 
 void MipsGOT::finalizeScan(const Input& pInput) {
 }
 
+void MipsGOT::initializeApply(const Input& pInput) {
+  InputPartMapType::const_iterator it = m_InputPart.find(&pInput);
+  m_CurrentGOTPart = (it == m_InputPart.end()) ? 0 : it->second;
+}
+
 bool MipsGOT::reserveLocalEntry(ResolveInfo& pInfo,
                                 int reloc,
                                 Relocation::DWord pAddend) {
   LocalEntry entry(&pInfo, pAddend, reloc == llvm::ELF::R_MIPS_GOT16);
 
-  if (m_InputLocalSymbols.count(entry))
-    // Do nothing, if we have seen this symbol
-    // in the current input already.
+  // Do nothing, if we have seen this symbol in the current input already.
+  if (!m_InputDemands.back().m_Locals.insert(entry).second)
     return false;
 
-  if (m_MergedLocalSymbols.count(entry)) {
-    // We have seen this symbol in previous inputs.
-    // Remember that it exists in the current input too.
-    m_InputLocalSymbols.insert(entry);
-    return false;
-  }
-
-  if (isGOTFull())
-    split();
-
-  m_InputLocalSymbols.insert(entry);
-
-  ++m_MultipartList.back().m_LocalNum;
   return true;
 }
 
 bool MipsGOT::reserveGlobalEntry(ResolveInfo& pInfo) {
-  if (m_InputGlobalSymbols.count(&pInfo))
-    return false;
-
-  if (m_MergedGlobalSymbols.count(&pInfo)) {
-    m_InputGlobalSymbols[&pInfo] = false;
+  InputDemand& demand = m_InputDemands.back();
+  if (!demand.m_GlobalSet.insert(&pInfo).second)
     return false;
-  }
-
-  if (isGOTFull())
-    split();
-
-  m_InputGlobalSymbols[&pInfo] = true;
-  ++m_MultipartList.back().m_GlobalNum;
-
-  if (!(pInfo.reserved() & MipsRelocator::ReserveGot)) {
-    m_SymbolOrderMap[pInfo.outSymbol()] = m_SymbolOrderMap.size();
-    pInfo.setReserved(pInfo.reserved() | MipsRelocator::ReserveGot);
-  }
 
+  demand.m_Globals.push_back(&pInfo);
   return true;
 }
 
+void MipsGOT::recordSection(const LDSection& pSection) {
+  std::vector<const LDSection*>& sections = m_InputDemands.back().m_Sections;
+  if (std::find(sections.begin(), sections.end(), &pSection) == sections.end())
+    sections.push_back(&pSection);
+}
+
 bool MipsGOT::isPrimaryGOTConsumed() {
   return m_CurrentGOTPart > 0;
 }
@@ -270,9 +371,6 @@ Fragment* MipsGOT::consumeLocal() {
   assert(m_CurrentGOTPart < m_MultipartList.size() &&
          "GOT number is out of range!");
 
-  if (m_MultipartList[m_CurrentGOTPart].isConsumed())
-    ++m_CurrentGOTPart;
-
   m_MultipartList[m_CurrentGOTPart].consumeLocal();
 
   return m_MultipartList[m_CurrentGOTPart].m_pLastLocal;
@@ -282,9 +380,6 @@ Fragment* MipsGOT::consumeGlobal() {
   assert(m_CurrentGOTPart < m_MultipartList.size() &&
          "GOT number is out of range!");
 
-  if (m_MultipartList[m_CurrentGOTPart].isConsumed())
-    ++m_CurrentGOTPart;
-
   m_MultipartList[m_CurrentGOTPart].consumeGlobal();
 
   return m_MultipartList[m_CurrentGOTPart].m_pLastGlobal;
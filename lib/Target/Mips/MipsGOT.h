@@ -29,6 +29,13 @@ class OutputRelocSection;
 
 /** \class MipsGOT
  *  \brief Mips Global Offset Table.
+ *
+ *  A GOT can only hold the entries reachable by the 16-bit offsets from $gp.
+ *  If the inputs need more entries, they are partitioned into multiple GOTs.
+ *  The entries needed by each input are collected while scanning
+ *  relocations, and the inputs are bin-packed into GOTs in finalizeScanning()
+ *  so that the inputs sharing global symbols are placed in the same GOT.
+ *  Every entry of a secondary GOT needs a R_MIPS_REL32 dynamic relocation.
  */
 class MipsGOT : public GOT {
  public:
@@ -46,14 +53,24 @@ class MipsGOT : public GOT {
   void initializeScan(const Input& pInput);
   void finalizeScan(const Input& pInput);
 
+  /// initializeApply - select the GOT of pInput before applying its
+  /// relocations
+  void initializeApply(const Input& pInput);
+
   bool reserveLocalEntry(ResolveInfo& pInfo,
                          int reloc,
                          Relocation::DWord pAddend);
   bool reserveGlobalEntry(ResolveInfo& pInfo);
 
+  /// recordSection - record that the relocations of pSection in the input
+  /// being scanned reserved GOT entries
+  void recordSection(const LDSection& pSection);
+
   size_t getLocalNum() const;   ///< number of local symbols in primary GOT
   size_t getGlobalNum() const;  ///< total number of global symbols
 
+  /// isPrimaryGOTConsumed - return if the GOT of the applying input is a
+  /// secondary GOT
   bool isPrimaryGOTConsumed();
 
   Fragment* consumeLocal();
@@ -74,8 +91,14 @@ class MipsGOT : public GOT {
   /// hasGOT1 - return if this got section has any GOT1 entry
   bool hasGOT1() const;
 
+  /// hasMultipleGOT - return if the inputs are partitioned into more than
+  /// one GOT. It is only known after finalizeScanning().
   bool hasMultipleGOT() const;
 
+  /// getSecondaryGOTSections - the sections recorded by the inputs which are
+  /// placed in secondary GOTs. It is only known after finalizeScanning().
+  void getSecondaryGOTSections(std::vector<const LDSection*>& pSections) const;
+
   /// Create GOT entries and reserve dynrel entries.
   void finalizeScanning(OutputRelocSection& pRelDyn);
 
@@ -112,8 +135,6 @@ class MipsGOT : public GOT {
 
     InputSetType m_Inputs;
 
-    bool isConsumed() const;
-
     void consumeLocal();
     void consumeGlobal();
   };
@@ -137,38 +158,74 @@ class MipsGOT : public GOT {
 
   // Set of global symbols.
   typedef llvm::DenseSet<const ResolveInfo*> SymbolSetType;
-  // Map of symbols. If value is true, the symbol is referenced
-  // in the current input only. If value is false, the symbol
-  // is referenced in the other modules merged to the current GOT.
-  typedef llvm::DenseMap<const ResolveInfo*, bool> SymbolUniqueMapType;
 
   // Set of local symbols.
   typedef std::set<LocalEntry> LocalSymbolSetType;
 
+  /** \class InputDemand
+   *  \brief InputDemand records the GOT entries needed by an input.
+   */
+  struct InputDemand {
+    explicit InputDemand(const Input* pInput);
+
+    size_t size() const { return m_Locals.size() + m_Globals.size(); }
+
+    const Input* m_pInput;
+    LocalSymbolSetType m_Locals;
+    std::vector<ResolveInfo*> m_Globals;  ///< in the order of reference
+    SymbolSetType m_GlobalSet;
+    std::vector<const LDSection*> m_Sections;  ///< see recordSection()
+  };
+
+  /** \class GOTBin
+   *  \brief GOTBin is the set of entries of a GOT while partitioning.
+   */
+  struct GOTBin {
+    size_t size() const { return m_Locals.size() + m_Globals.size(); }
+
+    /// growth - number of new entries if pDemand is added
+    size_t growth(const InputDemand& pDemand) const;
+
+    void add(const InputDemand& pDemand, size_t pIndex);
+
+    LocalSymbolSetType m_Locals;
+    SymbolSetType m_Globals;
+    std::vector<size_t> m_Inputs;  ///< indices of InputDemand
+  };
+
+  typedef std::vector<InputDemand> InputDemandListType;
+  typedef std::vector<GOTBin> PartitionType;
+
   MultipartListType m_MultipartList;  ///< list of GOT's descriptors
-  const Input* m_pInput;              ///< current input
-
-  // Global symbols merged to the current GOT
-  // except symbols from the current input.
-  SymbolSetType m_MergedGlobalSymbols;
-  // Global symbols from the current input.
-  SymbolUniqueMapType m_InputGlobalSymbols;
-  // Local symbols merged to the current GOT
-  // except symbols from the current input.
-  LocalSymbolSetType m_MergedLocalSymbols;
-  // Local symbols from the current input.
-  LocalSymbolSetType m_InputLocalSymbols;
+
+  // Entries needed by each input, in the input order
+  InputDemandListType m_InputDemands;
+  // Map from input to the index of its GOT
+  typedef llvm::DenseMap<const Input*, size_t> InputPartMapType;
+  InputPartMapType m_InputPart;
 
   size_t m_CurrentGOTPart;
 
   typedef llvm::DenseMap<const LDSymbol*, unsigned> SymbolOrderMapType;
   SymbolOrderMapType m_SymbolOrderMap;
 
-  void initGOTList();
+  /// getMaxEntryNum - max number of local and global entries in a GOT
+  size_t getMaxEntryNum() const;
+
+  /// partitionInInputOrder - fill GOTs greedily in the input order
+  void partitionInInputOrder(PartitionType& pParts) const;
+
+  /// partitionByBinPacking - place the largest inputs first, each into the
+  /// GOT sharing the most entries with it
+  void partitionByBinPacking(PartitionType& pParts) const;
+
+  /// countDynRels - number of R_MIPS_REL32 relocations needed by pParts
+  static size_t countDynRels(const PartitionType& pParts);
+
+  /// applyPartition - build the GOT descriptors and the order of global
+  /// symbols from pParts
+  void applyPartition(const PartitionType& pParts);
 
-  void changeInput();
-  bool isGOTFull() const;
-  void split();
   void reserve(size_t pNum);
 
  private:
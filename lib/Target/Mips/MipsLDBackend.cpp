@@ -171,6 +171,15 @@ void MipsGNULDBackend::doPreLayout(IRBuilder& pBuilder) {
       m_pGOT->finalizeScanning(*m_pRelDyn);
       m_pGOT->finalizeSectionSize();
 
+      // The entries of secondary GOTs need dynamic relocations, so the
+      // sections using them are known to need them only after the inputs
+      // are partitioned.
+      std::vector<const LDSection*> sections;
+      m_pGOT->getSecondaryGOTSections(sections);
+      for (std::vector<const LDSection*>::const_iterator
+               it = sections.begin(), ie = sections.end(); it != ie; ++it)
+        checkAndSetHasTextRel(**it);
+
       defineGOTSymbol(pBuilder);
     }
 
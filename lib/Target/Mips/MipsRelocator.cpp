@@ -234,6 +234,8 @@ bool MipsRelocator::finalizeScan(Input& pInput) {
 
 bool MipsRelocator::initializeApply(Input& pInput) {
   m_pApplyingInput = &pInput;
+  if (LinkerConfig::Object != config().codeGenType())
+    getTarget().getGOT().initializeApply(pInput);
   return true;
 }
 
@@ -295,12 +297,12 @@ void MipsRelocator::scanLocalReloc(MipsRelocationInfo& pReloc,
     case llvm::ELF::R_MIPS_GOT_DISP:
     case llvm::ELF::R_MIPS_GOT_PAGE:
     case llvm::ELF::R_MIPS_GOT_OFST:
+      // Whether the entry is in a secondary GOT is known after scanning.
+      // See MipsGNULDBackend::doPreLayout().
       if (getTarget()
               .getGOT()
-              .reserveLocalEntry(*rsym, pReloc.type(), pReloc.A())) {
-        if (getTarget().getGOT().hasMultipleGOT())
-          getTarget().checkAndSetHasTextRel(*pSection.getLink());
-      }
+              .reserveLocalEntry(*rsym, pReloc.type(), pReloc.A()))
+        getTarget().getGOT().recordSection(*pSection.getLink());
       break;
     case llvm::ELF::R_MIPS_GPREL32:
     case llvm::ELF::R_MIPS_GPREL16:
@@ -371,10 +373,8 @@ void MipsRelocator::scanGlobalReloc(MipsRelocationInfo& pReloc,
     case llvm::ELF::R_MIPS_CALL_LO16:
     case llvm::ELF::R_MIPS_GOT_PAGE:
     case llvm::ELF::R_MIPS_GOT_OFST:
-      if (getTarget().getGOT().reserveGlobalEntry(*rsym)) {
-        if (getTarget().getGOT().hasMultipleGOT())
-          getTarget().checkAndSetHasTextRel(*pSection.getLink());
-      }
+      if (getTarget().getGOT().reserveGlobalEntry(*rsym))
+        getTarget().getGOT().recordSection(*pSection.getLink());
       break;
     case llvm::ELF::R_MIPS_LITERAL:
     case llvm::ELF::R_MIPS_GPREL32:
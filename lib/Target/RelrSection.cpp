@@ -0,0 +1,143 @@
+//===- RelrSection.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Target/RelrSection.h"
+
+#include "mcld/Fragment/Relocation.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/RelocData.h"
+#include "mcld/LD/SectionData.h"
+#include "mcld/Support/FileOutputBuffer.h"
+#include "mcld/Support/MemoryRegion.h"
+
+#include <llvm/Support/ELF.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// RelrSection
+//===----------------------------------------------------------------------===//
+RelrSection::RelrSection(LDSection& pSection,
+                         LDSection& pRelDyn,
+                         unsigned int pWordSize)
+    : m_Section(pSection), m_RelDyn(pRelDyn), m_WordSize(pWordSize) {
+  assert((m_WordSize == 4 || m_WordSize == 8) && "Unsupported word size!");
+}
+
+RelrSection::~RelrSection() {
+}
+
+void RelrSection::add(Relocation& pReloc) {
+  m_Relocs.push_back(&pReloc);
+}
+
+size_t RelrSection::giveBackUnaligned() {
+  RelocData* reloc_data = m_RelDyn.getRelocData();
+  size_t count = 0;
+  RelocList::iterator reloc = m_Relocs.begin();
+  while (reloc != m_Relocs.end()) {
+    if (((*reloc)->place() % m_WordSize) == 0) {
+      ++reloc;
+      continue;
+    }
+    reloc_data->append(**reloc);
+    reloc = m_Relocs.erase(reloc);
+    ++count;
+  }
+  return count;
+}
+
+bool RelrSection::finalizeSectionSize() {
+  std::vector<uint64_t> places;
+  places.reserve(m_Relocs.size());
+  RelocList::const_iterator reloc, relocEnd = m_Relocs.end();
+  for (reloc = m_Relocs.begin(); reloc != relocEnd; ++reloc) {
+    assert(((*reloc)->place() % m_WordSize) == 0 && "Unaligned RELR place!");
+    places.push_back((*reloc)->place());
+  }
+  std::sort(places.begin(), places.end());
+  places.erase(std::unique(places.begin(), places.end()), places.end());
+
+  // Each bitmap covers (word-size * 8 - 1) words after the current base.
+  const uint64_t num_bits = m_WordSize * 8 - 1;
+  m_Entries.clear();
+  size_t i = 0, n = places.size();
+  while (i < n) {
+    m_Entries.push_back(places[i]);
+    uint64_t base = places[i] + m_WordSize;
+    ++i;
+
+    while (true) {
+      uint64_t bitmap = 0;
+      for (; i < n; ++i) {
+        uint64_t delta = places[i] - base;
+        if (delta >= num_bits * m_WordSize)
+          break;
+        bitmap |= uint64_t(1) << (delta / m_WordSize);
+      }
+      if (bitmap == 0)
+        break;
+      m_Entries.push_back((bitmap << 1) | 1);
+      base += num_bits * m_WordSize;
+    }
+  }
+
+  // Do not shrink, or the layout may oscillate. A bitmap with no bit set
+  // does not relocate anything, so it is used to pad.
+  uint64_t size = m_Entries.size() * m_WordSize;
+  if (size < m_Section.size()) {
+    m_Entries.resize(m_Section.size() / m_WordSize, 1);
+    size = m_Section.size();
+  }
+
+  if (size == m_Section.size())
+    return false;
+  m_Section.setSize(size);
+  return true;
+}
+
+void RelrSection::emit(MemoryRegion& pRegion) const {
+  uint8_t* buffer = pRegion.begin();
+  EntryList::const_iterator entry, entryEnd = m_Entries.end();
+  for (entry = m_Entries.begin(); entry != entryEnd; ++entry) {
+    if (m_WordSize == 4) {
+      uint32_t value = static_cast<uint32_t>(*entry);
+      memcpy(buffer, &value, m_WordSize);
+    } else {
+      uint64_t value = *entry;
+      memcpy(buffer, &value, m_WordSize);
+    }
+    buffer += m_WordSize;
+  }
+}
+
+void RelrSection::applyAddends(FileOutputBuffer& pOutput) const {
+  RelocList::const_iterator reloc, relocEnd = m_Relocs.end();
+  for (reloc = m_Relocs.begin(); reloc != relocEnd; ++reloc) {
+    const FragmentRef& target = (*reloc)->targetRef();
+    const LDSection& section = target.frag()->getParent()->getSection();
+    if (section.type() == llvm::ELF::SHT_NOBITS)
+      continue;
+    MemoryRegion region =
+        pOutput.request(section.offset() + target.getOutputOffset(),
+                        m_WordSize);
+    if (m_WordSize == 4) {
+      uint32_t value = static_cast<uint32_t>((*reloc)->addend());
+      memcpy(region.begin(), &value, m_WordSize);
+    } else {
+      uint64_t value = (*reloc)->addend();
+      memcpy(region.begin(), &value, m_WordSize);
+    }
+  }
+}
+
+}  // namespace mcld
@@ -50,14 +50,18 @@ X86GNULDBackend::X86GNULDBackend(const LinkerConfig& pConfig,
       pConfig.targets().triple().getEnvironment() == llvm::Triple::GNUX32) {
     m_RelEntrySize = 8;
     m_RelaEntrySize = 12;
-    if (arch == llvm::Triple::x86)
+    if (arch == llvm::Triple::x86) {
       m_PointerRel = llvm::ELF::R_386_32;
-    else
+      m_RelativeRel = llvm::ELF::R_386_RELATIVE;
+    } else {
       m_PointerRel = llvm::ELF::R_X86_64_32;
+      m_RelativeRel = llvm::ELF::R_X86_64_RELATIVE;
+    }
   } else {
     m_RelEntrySize = 16;
     m_RelaEntrySize = 24;
     m_PointerRel = llvm::ELF::R_X86_64_64;
+    m_RelativeRel = llvm::ELF::R_X86_64_RELATIVE;
   }
 }
 
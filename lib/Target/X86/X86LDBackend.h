@@ -113,6 +113,11 @@ class X86GNULDBackend : public GNULDBackend {
   /// getRelEntrySize - the size in BYTE of rela type relocation
   size_t getRelaEntrySize() { return m_RelaEntrySize; }
 
+  /// isRelativeReloc - whether pReloc can be packed into .relr.dyn
+  bool isRelativeReloc(const Relocation& pReloc) const {
+    return pReloc.type() == m_RelativeRel;
+  }
+
  private:
   /// doCreateProgramHdrs - backend can implement this function to create the
   /// target-dependent segments
@@ -149,6 +154,7 @@ class X86GNULDBackend : public GNULDBackend {
 
   Relocation::Type m_CopyRel;
   Relocation::Type m_PointerRel;
+  Relocation::Type m_RelativeRel;
 };
 
 //
@@ -9,8 +9,10 @@
 #ifndef TARGET_X86_X86RELOCATIONFUNCTIONS_H_
 #define TARGET_X86_X86RELOCATIONFUNCTIONS_H_
 
-#define DECL_X86_32_APPLY_RELOC_FUNC(Name)             \
-  static X86Relocator::Result Name(Relocation& pEntry, \
+#define DECL_X86_32_APPLY_RELOC_FUNC(Name)                     \
+  static X86Relocator::Result Name(Relocation& pEntry,         \
+                                   Relocator::Address pPlace,    \
+                                   Relocator::Address pSymValue, \
                                    X86_32Relocator& pParent);
 
 #define DECL_X86_32_APPLY_RELOC_FUNCS      \
@@ -76,8 +78,10 @@
   { &unsupported,  43, "R_386_NUM",           0  }, \
   { &none,         44, "R_386_TLS_OPT",       32 }
 
-#define DECL_X86_64_APPLY_RELOC_FUNC(Name)             \
-  static X86Relocator::Result Name(Relocation& pEntry, \
+#define DECL_X86_64_APPLY_RELOC_FUNC(Name)                     \
+  static X86Relocator::Result Name(Relocation& pEntry,         \
+                                   Relocator::Address pPlace,    \
+                                   Relocator::Address pSymValue, \
                                    X86_64Relocator& pParent);
 
 #define DECL_X86_64_APPLY_RELOC_FUNCS    \
@@ -11,10 +11,13 @@
 
 #include "mcld/IRBuilder.h"
 #include "mcld/LinkerConfig.h"
+#include "mcld/Module.h"
 #include "mcld/LD/ELFFileFormat.h"
 #include "mcld/LD/ELFSegmentFactory.h"
 #include "mcld/LD/ELFSegment.h"
+#include "mcld/LD/LDSection.h"
 #include "mcld/LD/LDSymbol.h"
+#include "mcld/LD/SectionData.h"
 #include "mcld/Object/ObjectBuilder.h"
 #include "mcld/Support/MsgHandling.h"
 
@@ -24,6 +27,83 @@
 
 namespace mcld {
 
+//===--------------------------------------------------------------------===//
+// Relocation batching helper function
+//===--------------------------------------------------------------------===//
+/// helper_ApplyByType - apply pRelocs in runs of the same type, in their
+/// original order. The applying function is looked up once per run instead
+/// of once per relocation.
+///
+/// The places and the symbol values of all relocations are computed into the
+/// flat arrays pPlaces and pSymValues in one pass before applying. The
+/// relocations of an input section mostly target one fragment, so the address
+/// of the last fragment is kept and the section of a relocation is only
+/// looked up when its fragment changes.
+template <typename RelocatorType, typename TripleType, size_t N>
+static void helper_ApplyByType(Relocator::RelocList& pRelocs,
+                               const TripleType (&pTable)[N],
+                               RelocatorType& pParent,
+                               std::vector<Relocator::Address>& pPlaces,
+                               std::vector<Relocator::Address>& pSymValues) {
+  size_t size = pRelocs.size();
+  pPlaces.resize(size);
+  pSymValues.resize(size);
+  const Fragment* frag = NULL;
+  Relocator::Address fragAddr = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const FragmentRef& target = pRelocs[i]->targetRef();
+    if (target.frag() != frag) {
+      frag = target.frag();
+      fragAddr = frag->getParent()->getSection().addr() + frag->getOffset();
+    }
+    pPlaces[i] = fragAddr + target.offset();
+    pSymValues[i] = pRelocs[i]->symValue();
+  }
+
+  size_t i = 0;
+  while (i != size) {
+    Relocation::Type type = pRelocs[i]->type();
+    size_t batchEnd = i;
+    while (batchEnd != size && pRelocs[batchEnd]->type() == type)
+      ++batchEnd;
+
+    if (type >= N) {
+      for (; i != batchEnd; ++i)
+        pParent.checkResult(Relocator::Unknown, *pRelocs[i]);
+      continue;
+    }
+
+    const TripleType& triple = pTable[type];
+    for (; i != batchEnd; ++i) {
+      pParent.checkResult(
+          triple.func(*pRelocs[i], pPlaces[i], pSymValues[i], pParent),
+          *pRelocs[i]);
+    }
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Relocation scanning helper function
+//===--------------------------------------------------------------------===//
+/// helper_is_stable - whether the scan never changes pSym. A dynamic symbol
+/// may be redefined by a copy relocation, so its relocations are decided when
+/// they are reserved.
+static bool helper_is_stable(const ResolveInfo& pSym) {
+  return !pSym.isDyn();
+}
+
+/// helper_PLT32_needs_PLT - whether R_386_PLT32 or R_X86_64_PLT32 against
+/// the stable global symbol pSym reserves a PLT entry, as scanGlobalReloc
+/// decides it
+static bool helper_PLT32_needs_PLT(const ResolveInfo& pSym,
+                                   const GNULDBackend& pTarget) {
+  if (pTarget.symbolFinalValueIsKnown(pSym))
+    return false;
+  if (pSym.isDefine() && !pSym.isDyn() && !pTarget.isSymbolPreemptible(pSym))
+    return false;
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // X86_32 Relocation helper function
 //===--------------------------------------------------------------------===//
@@ -133,8 +213,11 @@ static Relocator::Address helper_get_PLT_address(ResolveInfo& pSym,
 DECL_X86_32_APPLY_RELOC_FUNCS
 
 /// the prototype of applying function
-typedef Relocator::Result (*X86_32ApplyFunctionType)(Relocation& pReloc,
-                                                     X86_32Relocator& pParent);
+typedef Relocator::Result (*X86_32ApplyFunctionType)(
+    Relocation& pReloc,
+    Relocator::Address pPlace,
+    Relocator::Address pSymValue,
+    X86_32Relocator& pParent);
 
 // the table entry of applying functions
 struct X86_32ApplyFunctionTriple {
@@ -186,6 +269,111 @@ void X86Relocator::scanRelocation(Relocation& pReloc,
     issueUndefRef(pReloc, pSection, pInput);
 }
 
+/// prepareScan - give every stable symbol a GOT and a PLT claim slot
+void X86Relocator::prepareScan(Module& pModule) {
+  m_ClaimIndex.clear();
+  Module::const_sym_iterator sym, symEnd = pModule.sym_end();
+  for (sym = pModule.sym_begin(); sym != symEnd; ++sym) {
+    const ResolveInfo* info = (*sym)->resolveInfo();
+    if (info != NULL && helper_is_stable(*info))
+      m_ClaimIndex.insert(std::make_pair(info, m_ClaimIndex.size()));
+  }
+
+  size_t size = 2 * m_ClaimIndex.size();
+  m_Claims.reset(new std::atomic<uint64_t>[size]);
+  for (size_t i = 0; i < size; ++i)
+    m_Claims[i].store(~uint64_t(0), std::memory_order_relaxed);
+}
+
+void X86Relocator::decideScan(Relocation& pReloc,
+                              LDSection& pSection,
+                              uint64_t pOrder,
+                              ScanIntentList& pIntents) {
+  // rsym - The relocation target symbol
+  const ResolveInfo* rsym = pReloc.symInfo();
+  assert(rsym != NULL && "ResolveInfo of relocation not set while decideScan");
+
+  assert(pSection.getLink() != NULL);
+  if ((pSection.getLink()->flag() & llvm::ELF::SHF_ALLOC) == 0)
+    return;
+
+  uint32_t flags = 0x0;
+  if (rsym->isLocal())
+    flags = decideLocalReloc(pReloc);
+  else
+    flags = decideGlobalReloc(pReloc);
+
+  if (rsym->isUndef() && !rsym->isDyn() && !rsym->isWeak() && !rsym->isNull())
+    flags |= ScanUndefRef;
+
+  if (flags == 0x0)
+    return;
+
+  if ((flags & ScanClaimGOT) != 0x0)
+    claim(*rsym, ScanClaimGOT, pOrder);
+  if ((flags & ScanClaimPLT) != 0x0)
+    claim(*rsym, ScanClaimPLT, pOrder);
+
+  ScanIntent intent = {&pReloc, &pSection, pOrder, flags};
+  pIntents.push_back(intent);
+}
+
+void X86Relocator::reserveScan(const ScanIntent& pIntent,
+                               IRBuilder& pBuilder,
+                               Module& pModule,
+                               Input& pInput) {
+  ResolveInfo* rsym = pIntent.reloc->symInfo();
+
+  // a claim lost to an earlier relocation finds its entry reserved
+  bool reserve = ((pIntent.flags & ScanReserve) != 0x0);
+  if (reserve && (pIntent.flags & ScanClaimGOT) != 0x0)
+    reserve = isClaimedBy(*rsym, ScanClaimGOT, pIntent.order);
+  if (reserve && (pIntent.flags & ScanClaimPLT) != 0x0)
+    reserve = isClaimedBy(*rsym, ScanClaimPLT, pIntent.order);
+
+  if (reserve) {
+    if (rsym->isLocal())
+      scanLocalReloc(*pIntent.reloc, pBuilder, pModule, *pIntent.section);
+    else
+      scanGlobalReloc(*pIntent.reloc, pBuilder, pModule, *pIntent.section);
+  }
+
+  if ((pIntent.flags & ScanUndefRef) != 0x0)
+    issueUndefRef(*pIntent.reloc, *pIntent.section, pInput);
+}
+
+/// claim - keep the earliest order that claims the entry. The decisions of
+/// different inputs may claim at the same time.
+void X86Relocator::claim(const ResolveInfo& pSym,
+                         ScanClaimType pType,
+                         uint64_t pOrder) {
+  ClaimIndex::const_iterator entry = m_ClaimIndex.find(&pSym);
+  if (entry == m_ClaimIndex.end())
+    return;
+
+  std::atomic<uint64_t>& slot =
+      m_Claims[2 * entry->second + (pType == ScanClaimPLT ? 1 : 0)];
+  uint64_t current = slot.load(std::memory_order_relaxed);
+  while (pOrder < current &&
+         !slot.compare_exchange_weak(
+             current, pOrder, std::memory_order_relaxed)) {
+  }
+}
+
+/// isClaimedBy - the decision pass is over when this is asked. A symbol
+/// without claim slots is reserved at every intent.
+bool X86Relocator::isClaimedBy(const ResolveInfo& pSym,
+                               ScanClaimType pType,
+                               uint64_t pOrder) const {
+  ClaimIndex::const_iterator entry = m_ClaimIndex.find(&pSym);
+  if (entry == m_ClaimIndex.end())
+    return true;
+
+  const std::atomic<uint64_t>& slot =
+      m_Claims[2 * entry->second + (pType == ScanClaimPLT ? 1 : 0)];
+  return slot.load(std::memory_order_relaxed) == pOrder;
+}
+
 void X86Relocator::addCopyReloc(ResolveInfo& pSym, X86GNULDBackend& pTarget) {
   Relocation& rel_entry = *pTarget.getRelDyn().create();
   rel_entry.setType(pTarget.getCopyRelType());
@@ -283,7 +471,15 @@ Relocator::Result X86_32Relocator::applyRelocation(Relocation& pRelocation) {
   }
 
   // apply the relocation
-  return X86_32ApplyFunctions[type].func(pRelocation, *this);
+  return X86_32ApplyFunctions[type].func(pRelocation,
+                                         pRelocation.place(),
+                                         pRelocation.symValue(),
+                                         *this);
+}
+
+void X86_32Relocator::applyRelocations(RelocList& pRelocs) {
+  helper_ApplyByType(pRelocs, X86_32ApplyFunctions, *this, m_Places,
+                     m_SymValues);
 }
 
 const char* X86_32Relocator::getName(Relocation::Type pType) const {
@@ -761,6 +957,56 @@ void X86_32Relocator::scanGlobalReloc(Relocation& pReloc,
   }  // end switch
 }
 
+uint32_t X86_32Relocator::decideLocalReloc(const Relocation& pReloc) const {
+  switch (pReloc.type()) {
+    case llvm::ELF::R_386_32:
+    case llvm::ELF::R_386_16:
+    case llvm::ELF::R_386_8:
+      return config().isCodeIndep() ? ScanReserve : 0x0;
+
+    case llvm::ELF::R_386_PLT32:
+    case llvm::ELF::R_386_GOTOFF:
+    case llvm::ELF::R_386_GOTPC:
+    case llvm::ELF::R_386_PC32:
+    case llvm::ELF::R_386_PC16:
+    case llvm::ELF::R_386_PC8:
+    case llvm::ELF::R_386_TLS_LDO_32:
+      return 0x0;
+
+    case llvm::ELF::R_386_GOT32:
+      return ScanReserve | ScanClaimGOT;
+
+    default:
+      // TLS and unsupported relocations are left to scanLocalReloc
+      return ScanReserve;
+  }
+}
+
+uint32_t X86_32Relocator::decideGlobalReloc(const Relocation& pReloc) const {
+  const ResolveInfo* rsym = pReloc.symInfo();
+  switch (pReloc.type()) {
+    case llvm::ELF::R_386_GOTOFF:
+    case llvm::ELF::R_386_GOTPC:
+    case llvm::ELF::R_386_TLS_LDO_32:
+      return 0x0;
+
+    case llvm::ELF::R_386_PLT32:
+      if (!helper_is_stable(*rsym))
+        return ScanReserve;
+      if (!helper_PLT32_needs_PLT(*rsym, getTarget()))
+        return 0x0;
+      return ScanReserve | ScanClaimPLT;
+
+    case llvm::ELF::R_386_GOT32:
+      return ScanReserve | ScanClaimGOT;
+
+    default:
+      // the absolute and PC relative relocations may need a dynamic
+      // relocation at every place, depending on the PLT reserved so far
+      return ScanReserve;
+  }
+}
+
 // Create a GOT entry for the TLS module index
 X86_32GOTEntry& X86_32Relocator::getTLSModuleID() {
   static X86_32GOTEntry* got_entry = NULL;
@@ -852,17 +1098,23 @@ void X86_32Relocator::applyDebugStringOffset(Relocation& pReloc,
 //================================================//
 
 // R_386_NONE
-Relocator::Result none(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result none(Relocation& pReloc,
+                       Relocator::Address pPlace,
+                       Relocator::Address pSymValue,
+                       X86_32Relocator& pParent) {
   return Relocator::OK;
 }
 
 // R_386_32: S + A
 // R_386_16
 // R_386_8
-Relocator::Result abs(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result abs(Relocation& pReloc,
+                      Relocator::Address pPlace,
+                      Relocator::Address pSymValue,
+                      X86_32Relocator& pParent) {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::DWord A = pReloc.target() + pReloc.addend();
-  Relocator::DWord S = pReloc.symValue();
+  Relocator::DWord S = pSymValue;
   bool has_dyn_rel = pParent.getTarget().symbolNeedsDynRel(
       *rsym, (rsym->reserved() & X86Relocator::ReservePLT), true);
 
@@ -896,11 +1148,14 @@ Relocator::Result abs(Relocation& pReloc, X86_32Relocator& pParent) {
 // R_386_PC32: S + A - P
 // R_386_PC16
 // R_386_PC8
-Relocator::Result rel(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result rel(Relocation& pReloc,
+                      Relocator::Address pPlace,
+                      Relocator::Address pSymValue,
+                      X86_32Relocator& pParent) {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::DWord A = pReloc.target() + pReloc.addend();
-  Relocator::DWord S = pReloc.symValue();
-  Relocator::DWord P = pReloc.place();
+  Relocator::DWord S = pSymValue;
+  Relocator::DWord P = pPlace;
   bool has_dyn_rel = pParent.getTarget().symbolNeedsDynRel(
       *rsym, (rsym->reserved() & X86Relocator::ReservePLT), true);
 
@@ -930,26 +1185,35 @@ Relocator::Result rel(Relocation& pReloc, X86_32Relocator& pParent) {
 }
 
 // R_386_GOTOFF: S + A - GOT_ORG
-Relocator::Result gotoff32(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result gotoff32(Relocation& pReloc,
+                           Relocator::Address pPlace,
+                           Relocator::Address pSymValue,
+                           X86_32Relocator& pParent) {
   Relocator::DWord A = pReloc.target() + pReloc.addend();
   Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
-  Relocator::Address S = pReloc.symValue();
+  Relocator::Address S = pSymValue;
 
   pReloc.target() = S + A - GOT_ORG;
   return Relocator::OK;
 }
 
 // R_386_GOTPC: GOT_ORG + A - P
-Relocator::Result gotpc32(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result gotpc32(Relocation& pReloc,
+                          Relocator::Address pPlace,
+                          Relocator::Address pSymValue,
+                          X86_32Relocator& pParent) {
   Relocator::DWord A = pReloc.target() + pReloc.addend();
   Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
   // Apply relocation.
-  pReloc.target() = GOT_ORG + A - pReloc.place();
+  pReloc.target() = GOT_ORG + A - pPlace;
   return Relocator::OK;
 }
 
 // R_386_GOT32: GOT(S) + A - GOT_ORG
-Relocator::Result got32(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result got32(Relocation& pReloc,
+                        Relocator::Address pPlace,
+                        Relocator::Address pSymValue,
+                        X86_32Relocator& pParent) {
   ResolveInfo* rsym = pReloc.symInfo();
   if (!(rsym->reserved() & (X86Relocator::ReserveGOT)))
     return Relocator::BadReloc;
@@ -959,7 +1223,7 @@ Relocator::Result got32(Relocation& pReloc, X86_32Relocator& pParent) {
   X86_32GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
   assert(got_entry != NULL);
   if (got_entry->getValue() == X86Relocator::SymVal)
-    got_entry->setValue(pReloc.symValue());
+    got_entry->setValue(pSymValue);
 
   Relocator::Address GOT_S = helper_get_GOT_address(pReloc, pParent);
   Relocator::DWord A = pReloc.target() + pReloc.addend();
@@ -970,21 +1234,27 @@ Relocator::Result got32(Relocation& pReloc, X86_32Relocator& pParent) {
 }
 
 // R_386_PLT32: PLT(S) + A - P
-Relocator::Result plt32(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result plt32(Relocation& pReloc,
+                        Relocator::Address pPlace,
+                        Relocator::Address pSymValue,
+                        X86_32Relocator& pParent) {
   // PLT_S depends on if there is a PLT entry.
   Relocator::Address PLT_S;
   if ((pReloc.symInfo()->reserved() & X86Relocator::ReservePLT))
     PLT_S = helper_get_PLT_address(*pReloc.symInfo(), pParent);
   else
-    PLT_S = pReloc.symValue();
+    PLT_S = pSymValue;
   Relocator::DWord A = pReloc.target() + pReloc.addend();
-  Relocator::Address P = pReloc.place();
+  Relocator::Address P = pPlace;
   pReloc.target() = PLT_S + A - P;
   return Relocator::OK;
 }
 
 // R_386_TLS_GD:
-Relocator::Result tls_gd(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result tls_gd(Relocation& pReloc,
+                         Relocator::Address pPlace,
+                         Relocator::Address pSymValue,
+                         X86_32Relocator& pParent) {
   // global-dynamic
   ResolveInfo* rsym = pReloc.symInfo();
   // must reserve two pairs of got and dynamic relocation
@@ -1000,8 +1270,7 @@ Relocator::Result tls_gd(Relocation& pReloc, X86_32Relocator& pParent) {
 
   // set the got_entry2 value to symbol value
   if (rsym->isLocal())
-    pParent.getSymGOTMap().lookUpSecondEntry(*rsym)->setValue(
-        pReloc.symValue());
+    pParent.getSymGOTMap().lookUpSecondEntry(*rsym)->setValue(pSymValue);
 
   // perform relocation to the first got entry
   Relocator::DWord A = pReloc.target() + pReloc.addend();
@@ -1015,7 +1284,10 @@ Relocator::Result tls_gd(Relocation& pReloc, X86_32Relocator& pParent) {
 }
 
 // R_386_TLS_LDM
-Relocator::Result tls_ldm(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result tls_ldm(Relocation& pReloc,
+                          Relocator::Address pPlace,
+                          Relocator::Address pSymValue,
+                          X86_32Relocator& pParent) {
   // FIXME: no linker optimization for TLS relocation
   const X86_32GOTEntry& got_entry = pParent.getTLSModuleID();
 
@@ -1030,16 +1302,22 @@ Relocator::Result tls_ldm(Relocation& pReloc, X86_32Relocator& pParent) {
 }
 
 // R_386_TLS_LDO_32
-Relocator::Result tls_ldo_32(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result tls_ldo_32(Relocation& pReloc,
+                             Relocator::Address pPlace,
+                             Relocator::Address pSymValue,
+                             X86_32Relocator& pParent) {
   // FIXME: no linker optimization for TLS relocation
   Relocator::DWord A = pReloc.target() + pReloc.addend();
-  Relocator::Address S = pReloc.symValue();
+  Relocator::Address S = pSymValue;
   pReloc.target() = S + A;
   return Relocator::OK;
 }
 
 // R_X86_TLS_IE
-Relocator::Result tls_ie(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result tls_ie(Relocation& pReloc,
+                         Relocator::Address pPlace,
+                         Relocator::Address pSymValue,
+                         X86_32Relocator& pParent) {
   ResolveInfo* rsym = pReloc.symInfo();
   if (!(rsym->reserved() & X86Relocator::ReserveGOT)) {
     return Relocator::BadReloc;
@@ -1059,7 +1337,10 @@ Relocator::Result tls_ie(Relocation& pReloc, X86_32Relocator& pParent) {
 }
 
 // R_386_TLS_GOTIE
-Relocator::Result tls_gotie(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result tls_gotie(Relocation& pReloc,
+                            Relocator::Address pPlace,
+                            Relocator::Address pSymValue,
+                            X86_32Relocator& pParent) {
   ResolveInfo* rsym = pReloc.symInfo();
   if (!(rsym->reserved() & X86Relocator::ReserveGOT)) {
     return Relocator::BadReloc;
@@ -1080,7 +1361,10 @@ Relocator::Result tls_gotie(Relocation& pReloc, X86_32Relocator& pParent) {
 }
 
 // R_X86_TLS_LE
-Relocator::Result tls_le(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result tls_le(Relocation& pReloc,
+                         Relocator::Address pPlace,
+                         Relocator::Address pSymValue,
+                         X86_32Relocator& pParent) {
   if (pReloc.symInfo()->reserved() & X86Relocator::ReserveRel)
     return Relocator::OK;
 
@@ -1091,12 +1375,15 @@ Relocator::Result tls_le(Relocation& pReloc, X86_32Relocator& pParent) {
           llvm::ELF::PT_TLS, llvm::ELF::PF_R, 0x0);
   assert(tls_seg != pParent.getTarget().elfSegmentTable().end());
   Relocator::DWord A = pReloc.target() + pReloc.addend();
-  Relocator::Address S = pReloc.symValue();
+  Relocator::Address S = pSymValue;
   pReloc.target() = S + A - (*tls_seg)->memsz();
   return Relocator::OK;
 }
 
-Relocator::Result unsupported(Relocation& pReloc, X86_32Relocator& pParent) {
+Relocator::Result unsupported(Relocation& pReloc,
+                              Relocator::Address pPlace,
+                              Relocator::Address pSymValue,
+                              X86_32Relocator& pParent) {
   return Relocator::Unsupported;
 }
 
@@ -1211,8 +1498,11 @@ static PLTEntryBase& helper_PLT_init(Relocation& pReloc,
 DECL_X86_64_APPLY_RELOC_FUNCS
 
 /// the prototype of applying function
-typedef Relocator::Result (*X86_64ApplyFunctionType)(Relocation& pReloc,
-                                                     X86_64Relocator& pParent);
+typedef Relocator::Result (*X86_64ApplyFunctionType)(
+    Relocation& pReloc,
+    Relocator::Address pPlace,
+    Relocator::Address pSymValue,
+    X86_64Relocator& pParent);
 
 // the table entry of applying functions
 struct X86_64ApplyFunctionTriple {
@@ -1242,7 +1532,15 @@ Relocator::Result X86_64Relocator::applyRelocation(Relocation& pRelocation) {
   }
 
   // apply the relocation
-  return X86_64ApplyFunctions[type].func(pRelocation, *this);
+  return X86_64ApplyFunctions[type].func(pRelocation,
+                                         pRelocation.place(),
+                                         pRelocation.symValue(),
+                                         *this);
+}
+
+void X86_64Relocator::applyRelocations(RelocList& pRelocs) {
+  helper_ApplyByType(pRelocs, X86_64ApplyFunctions, *this, m_Places,
+                     m_SymValues);
 }
 
 const char* X86_64Relocator::getName(Relocation::Type pType) const {
@@ -1499,6 +1797,61 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
   }  // end switch
 }
 
+uint32_t X86_64Relocator::decideLocalReloc(const Relocation& pReloc) const {
+  switch (pReloc.type()) {
+    case llvm::ELF::R_X86_64_64:
+    case llvm::ELF::R_X86_64_32:
+    case llvm::ELF::R_X86_64_16:
+    case llvm::ELF::R_X86_64_8:
+    case llvm::ELF::R_X86_64_32S:
+      return config().isCodeIndep() ? ScanReserve : 0x0;
+
+    case llvm::ELF::R_X86_64_PC32:
+    case llvm::ELF::R_X86_64_PC16:
+    case llvm::ELF::R_X86_64_PC8:
+      return 0x0;
+
+    case llvm::ELF::R_X86_64_GOTPCREL:
+      return ScanReserve | ScanClaimGOT;
+
+    default:
+      // unsupported relocations are reported by scanLocalReloc
+      return ScanReserve;
+  }
+}
+
+uint32_t X86_64Relocator::decideGlobalReloc(const Relocation& pReloc) const {
+  const ResolveInfo* rsym = pReloc.symInfo();
+  switch (pReloc.type()) {
+    case llvm::ELF::R_X86_64_GOTPCREL:
+      return ScanReserve | ScanClaimGOT;
+
+    case llvm::ELF::R_X86_64_PLT32:
+      if (!helper_is_stable(*rsym))
+        return ScanReserve;
+      if (!helper_PLT32_needs_PLT(*rsym, getTarget()))
+        return 0x0;
+      return ScanReserve | ScanClaimPLT;
+
+    case llvm::ELF::R_X86_64_PC32:
+    case llvm::ELF::R_X86_64_PC16:
+    case llvm::ELF::R_X86_64_PC8:
+      if (!helper_is_stable(*rsym))
+        return ScanReserve;
+      // a stable symbol takes no copy relocation, so only the PLT entry is
+      // left to reserve
+      if (getTarget().symbolNeedsPLT(*rsym) &&
+          LinkerConfig::DynObj != config().codeGenType())
+        return ScanReserve | ScanClaimPLT;
+      return 0x0;
+
+    default:
+      // the absolute relocations may need a dynamic relocation at every
+      // place, depending on the PLT reserved so far
+      return ScanReserve;
+  }
+}
+
 uint32_t X86_64Relocator::getDebugStringOffset(Relocation& pReloc) const {
   if (pReloc.type() != llvm::ELF::R_X86_64_32)
     error(diag::unsupport_reloc_for_debug_string)
@@ -1520,7 +1873,10 @@ void X86_64Relocator::applyDebugStringOffset(Relocation& pReloc,
 // X86_64 Each relocation function implementation //
 //------------------------------------------------//
 // R_X86_64_NONE
-Relocator::Result none(Relocation& pReloc, X86_64Relocator& pParent) {
+Relocator::Result none(Relocation& pReloc,
+                       Relocator::Address pPlace,
+                       Relocator::Address pSymValue,
+                       X86_64Relocator& pParent) {
   return Relocator::OK;
 }
 
@@ -1528,10 +1884,13 @@ Relocator::Result none(Relocation& pReloc, X86_64Relocator& pParent) {
 // R_X86_64_32:
 // R_X86_64_16:
 // R_X86_64_8
-Relocator::Result abs(Relocation& pReloc, X86_64Relocator& pParent) {
+Relocator::Result abs(Relocation& pReloc,
+                      Relocator::Address pPlace,
+                      Relocator::Address pSymValue,
+                      X86_64Relocator& pParent) {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::DWord A = pReloc.target() + pReloc.addend();
-  Relocator::DWord S = pReloc.symValue();
+  Relocator::DWord S = pSymValue;
   Relocation* dyn_rel = pParent.getRelRelMap().lookUp(pReloc);
   bool has_dyn_rel = (dyn_rel != NULL);
 
@@ -1574,10 +1933,13 @@ Relocator::Result abs(Relocation& pReloc, X86_64Relocator& pParent) {
 }
 
 // R_X86_64_32S: S + A
-Relocator::Result signed32(Relocation& pReloc, X86_64Relocator& pParent) {
+Relocator::Result signed32(Relocation& pReloc,
+                           Relocator::Address pPlace,
+                           Relocator::Address pSymValue,
+                           X86_64Relocator& pParent) {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::DWord A = pReloc.target() + pReloc.addend();
-  Relocator::DWord S = pReloc.symValue();
+  Relocator::DWord S = pSymValue;
 
   // There should be no dynamic relocations for R_X86_64_32S.
   if (pParent.getRelRelMap().lookUp(pReloc) != NULL)
@@ -1604,7 +1966,10 @@ Relocator::Result signed32(Relocation& pReloc, X86_64Relocator& pParent) {
 }
 
 // R_X86_64_GOTPCREL: GOT(S) + GOT_ORG + A - P
-Relocator::Result gotpcrel(Relocation& pReloc, X86_64Relocator& pParent) {
+Relocator::Result gotpcrel(Relocation& pReloc,
+                           Relocator::Address pPlace,
+                           Relocator::Address pSymValue,
+                           X86_64Relocator& pParent) {
   if (!(pReloc.symInfo()->reserved() & X86Relocator::ReserveGOT)) {
     return Relocator::BadReloc;
   }
@@ -1612,32 +1977,35 @@ Relocator::Result gotpcrel(Relocation& pReloc, X86_64Relocator& pParent) {
   // set symbol value of the got entry if needed
   X86_64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
   if (X86Relocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+    got_entry->setValue(pSymValue);
 
   // setup relocation addend if needed
   Relocation* dyn_rel = pParent.getRelRelMap().lookUp(pReloc);
   if ((dyn_rel != NULL) && (X86Relocator::SymVal == dyn_rel->addend())) {
-    dyn_rel->setAddend(pReloc.symValue());
+    dyn_rel->setAddend(pSymValue);
   }
 
   Relocator::Address GOT_S = helper_get_GOT_address(pReloc, pParent);
   Relocator::DWord A = pReloc.target() + pReloc.addend();
   Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
   // Apply relocation.
-  pReloc.target() = GOT_S + GOT_ORG + A - pReloc.place();
+  pReloc.target() = GOT_S + GOT_ORG + A - pPlace;
   return Relocator::OK;
 }
 
 // R_X86_64_PLT32: PLT(S) + A - P
-Relocator::Result plt32(Relocation& pReloc, X86_64Relocator& pParent) {
+Relocator::Result plt32(Relocation& pReloc,
+                        Relocator::Address pPlace,
+                        Relocator::Address pSymValue,
+                        X86_64Relocator& pParent) {
   // PLT_S depends on if there is a PLT entry.
   Relocator::Address PLT_S;
   if ((pReloc.symInfo()->reserved() & X86Relocator::ReservePLT))
     PLT_S = helper_get_PLT_address(*pReloc.symInfo(), pParent);
   else
-    PLT_S = pReloc.symValue();
+    PLT_S = pSymValue;
   Relocator::DWord A = pReloc.target() + pReloc.addend();
-  Relocator::Address P = pReloc.place();
+  Relocator::Address P = pPlace;
   pReloc.target() = PLT_S + A - P;
   return Relocator::OK;
 }
@@ -1645,11 +2013,14 @@ Relocator::Result plt32(Relocation& pReloc, X86_64Relocator& pParent) {
 // R_X86_64_PC32: S + A - P
 // R_X86_64_PC16
 // R_X86_64_PC8
-Relocator::Result rel(Relocation& pReloc, X86_64Relocator& pParent) {
+Relocator::Result rel(Relocation& pReloc,
+                      Relocator::Address pPlace,
+                      Relocator::Address pSymValue,
+                      X86_64Relocator& pParent) {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::DWord A = pReloc.target() + pReloc.addend();
-  Relocator::DWord S = pReloc.symValue();
-  Relocator::DWord P = pReloc.place();
+  Relocator::DWord S = pSymValue;
+  Relocator::DWord P = pPlace;
 
   LDSection& target_sect = pReloc.targetRef().frag()->getParent()->getSection();
   // If the flag of target section is not ALLOC, we will not scan this
@@ -1682,7 +2053,10 @@ Relocator::Result rel(Relocation& pReloc, X86_64Relocator& pParent) {
   return Relocator::OK;
 }
 
-Relocator::Result unsupported(Relocation& pReloc, X86_64Relocator& pParent) {
+Relocator::Result unsupported(Relocation& pReloc,
+                              Relocator::Address pPlace,
+                              Relocator::Address pSymValue,
+                              X86_64Relocator& pParent) {
   return Relocator::Unsupported;
 }
 
@@ -15,6 +15,12 @@
 #include "mcld/Target/KeyEntryMap.h"
 #include "X86LDBackend.h"
 
+#include <llvm/ADT/DenseMap.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
 namespace mcld {
 
 class LinkerConfig;
@@ -60,6 +66,17 @@ class X86Relocator : public Relocator {
    */
   enum EntryValue { Default = 0, SymVal = 1 };
 
+  /** \enum ScanClaimType
+   *  \brief The intent of a relocation which may reserve nothing but the GOT
+   *  or the PLT entry of its symbol claims the entry. Only the earliest claim
+   *  in the input order is reserved; the entry exists by the time any later
+   *  one would be.
+   */
+  enum ScanClaimType {
+    ScanClaimGOT = ScanTarget,
+    ScanClaimPLT = ScanTarget << 1
+  };
+
  public:
   explicit X86Relocator(const LinkerConfig& pConfig);
   ~X86Relocator();
@@ -83,6 +100,24 @@ class X86Relocator : public Relocator {
                       LDSection& pSection,
                       Input& pInput);
 
+  /// X86 splits the scan. The decision pass drops the relocations that need
+  /// no entry and claims the GOT and PLT entries with atomic flags. The
+  /// reservation pass runs scanLocalReloc() and scanGlobalReloc() for the
+  /// rest in the input order.
+  bool hasSplitScan() const { return true; }
+
+  void prepareScan(Module& pModule);
+
+  void decideScan(Relocation& pReloc,
+                  LDSection& pSection,
+                  uint64_t pOrder,
+                  ScanIntentList& pIntents);
+
+  void reserveScan(const ScanIntent& pIntent,
+                   IRBuilder& pBuilder,
+                   Module& pModule,
+                   Input& pInput);
+
  protected:
   /// addCopyReloc - add a copy relocation into .rel.dyn for pSym
   /// @param pSym - A resolved copy symbol that defined in BSS section
@@ -95,6 +130,12 @@ class X86Relocator : public Relocator {
                                      const ResolveInfo& pSym,
                                      X86GNULDBackend& pTarget);
 
+ protected:
+  // the places and the symbol values of the relocations being applied by
+  // applyRelocations(), reused across inputs
+  std::vector<Address> m_Places;
+  std::vector<Address> m_SymValues;
+
  private:
   virtual void scanLocalReloc(Relocation& pReloc,
                               IRBuilder& pBuilder,
@@ -106,8 +147,33 @@ class X86Relocator : public Relocator {
                                Module& pModule,
                                LDSection& pSection) = 0;
 
+  /// decideLocalReloc - the ScanIntentFlag and ScanClaimType bits of a
+  /// relocation against a local symbol, or 0 if it needs no entry
+  virtual uint32_t decideLocalReloc(const Relocation& pReloc) const = 0;
+
+  /// decideGlobalReloc - the ScanIntentFlag and ScanClaimType bits of a
+  /// relocation against a global symbol, or 0 if it needs no entry
+  virtual uint32_t decideGlobalReloc(const Relocation& pReloc) const = 0;
+
+  /// claim - claim the entry pType of pSym for the relocation at pOrder
+  void claim(const ResolveInfo& pSym, ScanClaimType pType, uint64_t pOrder);
+
+  /// isClaimedBy - whether the relocation at pOrder holds the claim of the
+  /// entry pType of pSym
+  bool isClaimedBy(const ResolveInfo& pSym,
+                   ScanClaimType pType,
+                   uint64_t pOrder) const;
+
+ private:
+  typedef llvm::DenseMap<const ResolveInfo*, size_t> ClaimIndex;
+
  private:
   SymPLTMap m_SymPLTMap;
+
+  // the claim slots of the stable symbols, two per symbol: the earliest
+  // order that claims the GOT entry and the PLT entry
+  ClaimIndex m_ClaimIndex;
+  std::unique_ptr<std::atomic<uint64_t>[]> m_Claims;
 };
 
 /** \class X86_32Relocator
@@ -128,6 +194,8 @@ class X86_32Relocator : public X86Relocator {
 
   Result applyRelocation(Relocation& pRelocation);
 
+  void applyRelocations(RelocList& pRelocs);
+
   X86_32GNULDBackend& getTarget() { return m_Target; }
 
   const X86_32GNULDBackend& getTarget() const { return m_Target; }
@@ -167,6 +235,10 @@ class X86_32Relocator : public X86Relocator {
                        Module& pModule,
                        LDSection& pSection);
 
+  uint32_t decideLocalReloc(const Relocation& pReloc) const;
+
+  uint32_t decideGlobalReloc(const Relocation& pReloc) const;
+
   /// -----  tls optimization  ----- ///
   /// convert R_386_TLS_IE to R_386_TLS_LE
   void convertTLSIEtoLE(Relocation& pReloc, LDSection& pSection);
@@ -192,6 +264,8 @@ class X86_64Relocator : public X86Relocator {
 
   Result applyRelocation(Relocation& pRelocation);
 
+  void applyRelocations(RelocList& pRelocs);
+
   X86_64GNULDBackend& getTarget() { return m_Target; }
 
   const X86_64GNULDBackend& getTarget() const { return m_Target; }
@@ -232,6 +306,10 @@ class X86_64Relocator : public X86Relocator {
                        Module& pModule,
                        LDSection& pSection);
 
+  uint32_t decideLocalReloc(const Relocation& pReloc) const;
+
+  uint32_t decideGlobalReloc(const Relocation& pReloc) const;
+
  private:
   X86_64GNULDBackend& m_Target;
   SymGOTMap m_SymGOTMap;
@@ -0,0 +1,49 @@
+; --archive-index-cache keeps the symbol index of an archive in a directory.
+; An archive modified in the last seconds is not cached, so the archives here
+; are dated back.
+; RUN: rm -rf %t.cache %t.a
+; RUN: llvm-ar rcs %t.a %p/obj/index_value1.o
+; RUN: touch -t 200001010000 %t.a
+
+; The first link misses and writes the index.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --archive-index-cache=%t.cache --verbose=1 \
+; RUN: %p/obj/index_main.o %t.a -o %t.miss.exe 2>&1 \
+; RUN: | FileCheck %s -check-prefix=MISS
+; RUN: ls %t.cache | FileCheck %s -check-prefix=INDEX
+
+; MISS-NOT: from the archive index cache
+; MISS: Note: wrote the symbol index of archive {{.*}}.a to the archive index cache
+; INDEX: {{^[0-9a-f]+\.idx$}}
+
+; The second link reads the index, and the output is the same as without
+; the cache.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --archive-index-cache=%t.cache --verbose=1 \
+; RUN: %p/obj/index_main.o %t.a -o %t.hit.exe 2>&1 \
+; RUN: | FileCheck %s -check-prefix=HIT
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %p/obj/index_main.o %t.a -o %t.plain.exe
+; RUN: cmp %t.miss.exe %t.hit.exe
+; RUN: cmp %t.plain.exe %t.hit.exe
+; RUN: llvm-objdump -s -j .data %t.hit.exe | FileCheck %s -check-prefix=V1
+
+; HIT: Note: read the symbol index of archive {{.*}}.a from the archive index cache
+; HIT-NOT: to the archive index cache
+; V1: Contents of section .data:
+; V1: 11111111 11111111
+
+; Rewriting the archive invalidates the index: it is read again, a new index
+; replaces the old one, and the new member is linked.
+; RUN: rm -f %t.a
+; RUN: llvm-ar rcs %t.a %p/obj/index_value2.o
+; RUN: touch -t 200101010000 %t.a
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --archive-index-cache=%t.cache --verbose=1 \
+; RUN: %p/obj/index_main.o %t.a -o %t.new.exe 2>&1 \
+; RUN: | FileCheck %s -check-prefix=MISS
+; RUN: ls %t.cache | FileCheck %s -check-prefix=INDEX
+; RUN: llvm-objdump -s -j .data %t.new.exe | FileCheck %s -check-prefix=V2
+
+; V2: Contents of section .data:
+; V2: 22222222 22222222
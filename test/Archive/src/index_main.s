@@ -0,0 +1,8 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj index_main.s -o ../obj/index_main.o
+  .text
+  .globl _start
+_start:
+  ret
+
+  .data
+  .quad value
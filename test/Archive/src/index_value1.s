@@ -0,0 +1,5 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj index_value1.s -o ../obj/index_value1.o
+  .data
+  .globl value
+value:
+  .quad 0x1111111111111111
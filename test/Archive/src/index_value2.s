@@ -0,0 +1,9 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj index_value2.s -o ../obj/index_value2.o
+# The rewritten member, with another value and one more symbol.
+  .data
+  .globl value
+value:
+  .quad 0x2222222222222222
+  .globl other
+other:
+  .quad 0
@@ -0,0 +1,29 @@
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=pic %s -o %t.o
+; RUN: %MCLinker -march=x86-64 -mtriple="x86_64-linux-gnu" -shared \
+; RUN: --print-stats --time-trace=%t.json %t.o -o %t.so | FileCheck %s
+; RUN: FileCheck %s -check-prefix=TRACE < %t.json
+
+; Every phase is a row of the table, followed by the totals.
+; CHECK: phase {{ +}}wall(ms) {{ +}}cpu(ms) {{ +}}rss(MB) {{ +}}inputs
+; CHECK: normalize {{ +[0-9]+\.[0-9]+ +[0-9]+\.[0-9]+ +[0-9]+\.[0-9]}} {{ +}}1
+; CHECK: relocation {{ +[0-9]+\.[0-9]+ +[0-9]+\.[0-9]+ +[0-9]+\.[0-9]}} {{ +}}1
+; CHECK: emitOutput {{ +[0-9]+\.[0-9]+ +[0-9]+\.[0-9]+ +[0-9]+\.[0-9]}} {{ +}}1
+; CHECK: total {{ +[0-9]+\.[0-9]+ +[0-9]+\.[0-9]+ +[0-9]+\.[0-9]}}
+
+; One complete event per phase, with its duration and the peak RSS.
+; TRACE: {"traceEvents":[
+; TRACE: {"name":"normalize","cat":"mcld","ph":"X","pid":1,"tid":0,"ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"cpu_us":{{[0-9]+}},"peak_rss":{{[1-9][0-9]*}},"inputs":1,
+; TRACE: {"name":"relocation","cat":"mcld","ph":"X","pid":1,"tid":0,"ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"cpu_us":{{[0-9]+}},"peak_rss":{{[1-9][0-9]*}},"inputs":1,
+; TRACE: {"name":"emitOutput","cat":"mcld","ph":"X","pid":1,"tid":0,"ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"cpu_us":{{[0-9]+}},"peak_rss":{{[1-9][0-9]*}},"inputs":1,
+; TRACE: ],"displayTimeUnit":"ms"}
+
+target triple = "x86_64-linux-gnu"
+
+@value = global i32 42, align 4
+
+define i32 @get() nounwind {
+entry:
+  %0 = load i32, i32* @value, align 4
+  ret i32 %0
+}
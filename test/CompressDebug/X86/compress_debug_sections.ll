@@ -0,0 +1,44 @@
+; --compress-debug-sections=zlib compresses the non-allocated debug sections
+; of the output and marks them SHF_COMPRESSED.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --compress-debug-sections=zlib %p/obj/debug.o -o %t.exe
+; RUN: llvm-readelf -S %t.exe | FileCheck %s -check-prefix=COMPRESSED
+; RUN: llvm-objcopy --decompress-debug-sections %t.exe %t.plain.exe
+; RUN: llvm-objdump -s -j .debug_info %t.plain.exe \
+; RUN: | FileCheck %s -check-prefix=CONTENT
+
+; COMPRESSED: .debug_info PROGBITS {{[0-9a-f]+}} {{[0-9a-f]+}} {{[0-9a-f]+}} 00 C
+
+; CONTENT: Contents of section .debug_info:
+; CONTENT: ible debug infor
+
+; The compressed sections of the inputs are uncompressed, and the output is
+; not compressed without the option.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %p/obj/debug_zlib.o -o %t.in.exe
+; RUN: llvm-readelf -S %t.in.exe | FileCheck %s -check-prefix=PLAIN
+; RUN: llvm-objdump -s -j .debug_info %t.in.exe \
+; RUN: | FileCheck %s -check-prefix=CONTENT
+
+; PLAIN: .debug_info PROGBITS {{[0-9a-f]+}} {{[0-9a-f]+}} {{[0-9a-f]+}} 00 0 0
+
+; The relocations against a section compressed by the link are applied
+; before it is compressed, and those against a section that was decompressed
+; from an input are applied as usual. Neither is reported as a relocation
+; against a compressed section.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --section-start .text=0x1000 --compress-debug-sections=zlib \
+; RUN: %p/obj/debug_zlib.o -o %t.both.exe 2>&1 \
+; RUN: | FileCheck %s -check-prefix=NOERR -allow-empty
+; RUN: llvm-objcopy --decompress-debug-sections %t.both.exe %t.both.plain.exe
+; RUN: llvm-objdump -s -j .debug_info %t.both.plain.exe \
+; RUN: | FileCheck %s -check-prefix=RELOC
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --section-start .text=0x1000 %p/obj/debug_zlib.o -o %t.in.reloc.exe
+; RUN: llvm-objdump -s -j .debug_info %t.in.reloc.exe \
+; RUN: | FileCheck %s -check-prefix=RELOC
+
+; NOERR-NOT: compressed section
+
+; RELOC: Contents of section .debug_info:
+; RELOC-NEXT: 0000 00100000 00000000 636f6d70 72657373
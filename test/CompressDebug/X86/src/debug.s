@@ -0,0 +1,16 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj debug.s -o ../obj/debug.o
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj -compress-debug-sections=zlib \
+#   debug.s -o ../obj/debug_zlib.o
+  .text
+  .globl _start
+_start:
+  ret
+
+  .section .debug_info,"",@progbits
+  .quad _start
+  .rept 64
+  .ascii "compressible debug information "
+  .endr
+
+  .section .debug_str,"MS",@progbits,1
+  .asciz "producer"
@@ -0,0 +1,17 @@
+; The .ARM.exidx entries which unwind like the previous entry are merged into
+; it: f2 can't unwind like f1, and f4 has the same inline entry as f3. The
+; table ends with a can't unwind sentinel after _start.
+; RUN: %MCLinker -march=arm -mtriple=armv7-none-linux-gnueabi -e _start \
+; RUN: %p/exidx_merge.o -o %t.exe
+; RUN: llvm-readelf -S %t.exe | FileCheck %s -check-prefix=SECT
+; RUN: llvm-readobj --unwind %t.exe | FileCheck %s
+
+; SECT: .ARM.exidx ARM_EXIDX {{[0-9a-f]+}} {{[0-9a-f]+}} 000020
+
+; CHECK: FunctionName: f1
+; CHECK-NEXT: Model: CantUnwind
+; CHECK-NOT: FunctionName: f2
+; CHECK: FunctionName: f3
+; CHECK-NOT: FunctionName: f4
+; CHECK: FunctionName: _start
+; CHECK: Model: CantUnwind
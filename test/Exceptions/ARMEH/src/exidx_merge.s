@@ -0,0 +1,57 @@
+@ llvm-mc -triple=armv7-none-linux-gnueabi -filetype=obj exidx_merge.s \
+@   -o ../exidx_merge.o
+  .syntax unified
+
+  .section .text.f1,"ax",%progbits
+  .globl f1
+  .type f1,%function
+f1:
+  .fnstart
+  .cantunwind
+  bx lr
+  .fnend
+
+  .section .text.f2,"ax",%progbits
+  .globl f2
+  .type f2,%function
+f2:
+  .fnstart
+  .cantunwind
+  bx lr
+  .fnend
+
+  .section .text.f3,"ax",%progbits
+  .globl f3
+  .type f3,%function
+f3:
+  .fnstart
+  .save {r4, lr}
+  push {r4, lr}
+  pop {r4, pc}
+  .fnend
+
+  .section .text.f4,"ax",%progbits
+  .globl f4
+  .type f4,%function
+f4:
+  .fnstart
+  .save {r4, lr}
+  push {r4, lr}
+  pop {r4, pc}
+  .fnend
+
+  .section .text.f5,"ax",%progbits
+  .globl _start
+  .type _start,%function
+_start:
+  .fnstart
+  .save {r4, r5, lr}
+  push {r4, r5, lr}
+  pop {r4, r5, pc}
+  .fnend
+
+  .text
+  .globl __aeabi_unwind_cpp_pr0
+  .type __aeabi_unwind_cpp_pr0,%function
+__aeabi_unwind_cpp_pr0:
+  bx lr
@@ -0,0 +1,24 @@
+; --hash-size overrides the bucket count of both .hash and .gnu.hash. The
+; .gnu.hash bloom filter keeps at least 12 bits per hashed symbol.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: --hash-style=both --hash-size=5 %p/obj/hash.o -o %t.so
+; RUN: llvm-readobj --hash-table --gnu-hash-table %t.so | FileCheck %s
+
+; CHECK:      HashTable {
+; CHECK-NEXT:   Num Buckets: 5
+; CHECK-NEXT:   Num Chains: 7
+; CHECK:      GnuHashTable {
+; CHECK-NEXT:   Num Buckets: 5
+; CHECK-NEXT:   First Hashed Symbol Index: 1
+; CHECK-NEXT:   Num Mask Words: 2
+; CHECK-NEXT:   Shift Count: 7
+
+; --hash-style=gnu emits .gnu.hash alone.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: --hash-style=gnu %p/obj/hash.o -o %t.gnu.so
+; RUN: llvm-readelf -S -d %t.gnu.so | FileCheck %s -check-prefix=GNU
+
+; GNU-NOT: .hash HASH
+; GNU:     .gnu.hash GNU_HASH
+; GNU-NOT: (HASH)
+; GNU:     (GNU_HASH)
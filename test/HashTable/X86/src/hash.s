@@ -0,0 +1,9 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj hash.s -o ../obj/hash.o
+  .text
+  .irp name, foo, bar, baz, qux, quux, corge
+  .globl \name
+  .type \name,@function
+\name:
+  ret
+  .size \name, 1
+  .endr
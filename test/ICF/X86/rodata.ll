@@ -0,0 +1,29 @@
+; Identical read-only data sections are folded unless .llvm_addrsig marks
+; one of their symbols as address-significant. The table itself is not
+; copied to the output.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %p/rodata.o --icf=all -o %t.all.exe
+; RUN: llvm-nm %t.all.exe | FileCheck %s
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %p/rodata.o --icf=safe -o %t.safe.exe
+; RUN: llvm-nm %t.safe.exe | FileCheck %s
+; RUN: llvm-readelf -S %t.safe.exe | FileCheck %s -check-prefix=SECTIONS
+
+; CHECK:     [[ADDR:[0-9a-f]+]] R a
+; CHECK-NEXT: [[ADDR]] R b
+; CHECK-NOT: [[ADDR]] R c
+
+; SECTIONS-NOT: .llvm_addrsig
+
+; With --icf=safe, an input without .llvm_addrsig keeps all its data.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %p/rodata_noaddrsig.o --icf=safe -o %t.noaddrsig.exe
+; RUN: llvm-nm %t.noaddrsig.exe | FileCheck %s -check-prefix=NOADDRSIG
+
+; NOADDRSIG:      [[A:[0-9a-f]+]] R a
+; NOADDRSIG-NOT:  [[A]] R b
+
+; Without --icf, nothing is folded.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %p/rodata.o -o %t.none.exe
+; RUN: llvm-nm %t.none.exe | FileCheck %s -check-prefix=NOADDRSIG
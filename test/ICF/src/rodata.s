@@ -0,0 +1,25 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj rodata.s -o ../X86/rodata.o
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj -defsym=NOADDRSIG=1 rodata.s \
+#   -o ../X86/rodata_noaddrsig.o
+  .text
+  .globl _start
+  .type _start,@function
+_start:
+  movq a(%rip), %rax
+  movq b(%rip), %rax
+  movq c(%rip), %rax
+  ret
+
+  .irp name, a, b, c
+  .section .rodata.\name,"a",@progbits
+  .globl \name
+  .type \name,@object
+\name:
+  .quad 0x1122334455667788
+  .size \name, 8
+  .endr
+
+.ifndef NOADDRSIG
+  .addrsig
+  .addrsig_sym c
+.endif
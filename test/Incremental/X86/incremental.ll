@@ -0,0 +1,36 @@
+; --incremental patches a section whose contents changed into the output of
+; the previous link, and falls back to a full link on any other change.
+; RUN: rm -f %t.exe %t.exe.mcld-state
+; RUN: cp %p/obj/v1.o %t.o
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --incremental --verbose=1 %t.o -o %t.exe 2>&1 \
+; RUN: | FileCheck %s -check-prefix=FIRST
+; RUN: llvm-objdump -s -j .rodata %t.exe | FileCheck %s -check-prefix=V1
+
+; FIRST: Note: incremental link of `{{.*}}.exe' falls back to a full link: no state of a previous link
+; V1: first!
+
+; Only the contents of .rodata.msg changed, so it is patched in place. The
+; result is the same as a full link.
+; RUN: cp %p/obj/v2.o %t.o
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --incremental --verbose=1 %t.o -o %t.exe 2>&1 \
+; RUN: | FileCheck %s -check-prefix=PATCH
+; RUN: llvm-objdump -s -j .rodata %t.exe | FileCheck %s -check-prefix=V2
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %t.o -o %t.full.exe
+; RUN: cmp %t.exe %t.full.exe
+
+; PATCH: Note: incremental link patched 1 section(s) of 1 file(s) into `{{.*}}.exe'
+; V2: second
+
+; The size of .rodata.msg changed. No slack is reserved for it to grow, so
+; the layout is redone.
+; RUN: cp %p/obj/v3.o %t.o
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --incremental --verbose=1 %t.o -o %t.exe 2>&1 \
+; RUN: | FileCheck %s -check-prefix=FALLBACK
+; RUN: llvm-objdump -s -j .rodata %t.exe | FileCheck %s -check-prefix=V3
+
+; FALLBACK: Note: incremental link of `{{.*}}.exe' falls back to a full link: the size of a section of `{{.*}}.o' changed, and only same-size changes are patched
+; V3: a longer third
@@ -0,0 +1,25 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj main.s -o ../obj/v1.o
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj -defsym=V2=1 main.s \
+#   -o ../obj/v2.o
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj -defsym=V3=1 main.s \
+#   -o ../obj/v3.o
+  .text
+  .globl _start
+  .type _start,@function
+_start:
+  leaq msg(%rip), %rax
+  ret
+
+  .section .rodata.msg,"a",@progbits
+  .type msg,@object
+msg:
+.ifdef V2
+  .ascii "second"
+.else
+.ifdef V3
+  .ascii "a longer third"
+.else
+  .ascii "first!"
+.endif
+.endif
+  .size msg, . - msg
@@ -0,0 +1,24 @@
+; The sections of SORT_BY_NAME(.text.*) are sorted by name and placed before
+; the sections of the unsorted .text pattern in the same description.
+; RUN: echo "SECTIONS {                                          \
+; RUN:   .text : { *(SORT_BY_NAME(.text.*) .text) }              \
+; RUN:   .init_array : { *(SORT_BY_INIT_PRIORITY(.init_array.*)) } \
+; RUN:   .ctors : { *(SORT_BY_INIT_PRIORITY(.ctors.*)) }         \
+; RUN: }" > %t.x
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: -T %t.x %p/obj/sort_sections.o -o %t.exe
+; RUN: llvm-nm -n %t.exe | FileCheck %s
+
+; CHECK: T a
+; CHECK-NEXT: T b
+; CHECK-NEXT: T c
+; CHECK-NEXT: T _start
+
+; .init_array.N ascend by N.
+; CHECK: init100
+; CHECK-NEXT: init200
+
+; .ctors.N descend by N. The priority above 65535 is clamped rather than
+; wrapped around, so it stays first.
+; CHECK: ctor70000
+; CHECK-NEXT: ctor100
@@ -0,0 +1,41 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj sort_sections.s \
+#   -o ../obj/sort_sections.o
+  .section .text.c,"ax",@progbits
+  .globl c
+c:
+  ret
+
+  .section .text.a,"ax",@progbits
+  .globl a
+a:
+  ret
+
+  .section .text,"ax",@progbits
+  .globl _start
+_start:
+  ret
+
+  .section .text.b,"ax",@progbits
+  .globl b
+b:
+  ret
+
+  .section .init_array.200,"aw",@init_array
+  .globl init200
+init200:
+  .quad c
+
+  .section .init_array.100,"aw",@init_array
+  .globl init100
+init100:
+  .quad a
+
+  .section .ctors.70000,"aw",@progbits
+  .globl ctor70000
+ctor70000:
+  .quad b
+
+  .section .ctors.100,"aw",@progbits
+  .globl ctor100
+ctor100:
+  .quad a
@@ -0,0 +1,18 @@
+; -Map writes the output sections, the input sections placed in them and the
+; symbols defined in them, in the order of the addresses.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %p/obj/map.o -o %t.exe -Map %t.map
+; RUN: FileCheck %s < %t.map
+
+; CHECK: Linker script and memory map
+; CHECK: .text 0x[[TEXT:[0-9a-f]+]] 0x7
+; CHECK-NEXT: .text 0x[[TEXT]] 0x7 {{.*}}map.o
+; CHECK-NEXT: 0x[[TEXT]] _start
+; CHECK-NEXT: 0x{{[0-9a-f]+}} helper
+; CHECK: .data 0x[[DATA:[0-9a-f]+]] 0x8
+; CHECK-NEXT: .data 0x[[DATA]] 0x8 {{.*}}map.o
+; CHECK-NEXT: 0x[[DATA]] counter
+
+; -M prints the same map to the standard output.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %p/obj/map.o -o %t.M.exe -M | FileCheck %s
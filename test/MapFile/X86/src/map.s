@@ -0,0 +1,15 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj map.s -o ../obj/map.o
+  .text
+  .globl _start
+_start:
+  call helper
+  ret
+
+  .globl helper
+helper:
+  ret
+
+  .data
+  .globl counter
+counter:
+  .quad 0
@@ -0,0 +1,13 @@
+; A file written just before the link is mapped again every time it is
+; opened, since its status cannot tell whether it changed. Listing it twice
+; must keep the first mapping alive for the sections read from it.
+; RUN: cp %p/obj/weak.o %t.o
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %t.o %t.o -o %t.exe
+; RUN: llvm-objdump -s -j .text -j .data %t.exe | FileCheck %s
+
+; Both copies of the sections are read intact.
+; CHECK:      Contents of section .text:
+; CHECK-NEXT: 488b05{{[0-9a-f]+}} {{[0-9a-f]+}}c3 488b05{{[0-9a-f]+}} {{[0-9a-f]+}}c3
+; CHECK:      Contents of section .data:
+; CHECK-NEXT: 88776655 44332211 88776655 44332211
@@ -0,0 +1,14 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj weak.s -o ../obj/weak.o
+  .text
+  .weak _start
+  .type _start,@function
+_start:
+  movq value(%rip), %rax
+  ret
+
+  .data
+  .weak value
+  .type value,@object
+value:
+  .quad 0x1122334455667788
+  .size value, 8
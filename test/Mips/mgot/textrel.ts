@@ -0,0 +1,27 @@
+; The entries of a secondary GOT need dynamic relocations, so the sections
+; using them set DT_TEXTREL. That is only known once the inputs are
+; partitioned into GOTs, not while their relocations are scanned.
+;
+; mgot0.o and mgot1.o need more entries than a GOT holds.
+; RUN: %MCLinker -march mipsel -mtriple=mipsel-none-linux-gnueabi \
+; RUN:           -filetype=dso -shared --verbose=1 \
+; RUN:           -o %t.so %p/mgot0.o %p/mgot1.o 2>&1 \
+; RUN:   | FileCheck %s -check-prefix=NOTE
+; RUN: readelf -d %t.so | FileCheck %s -check-prefix=MULTI
+;
+; NOTE: multi-GOT: {{[2-9]}} GOTs, {{[0-9]+}} dynamic relocations in input order; {{[2-9]}} GOTs
+; MULTI: (TEXTREL)
+;
+; In the other order, the secondary GOT is decided by the same partition.
+; RUN: %MCLinker -march mipsel -mtriple=mipsel-none-linux-gnueabi \
+; RUN:           -filetype=dso -shared \
+; RUN:           -o %t.rev.so %p/mgot1.o %p/mgot0.o
+; RUN: readelf -d %t.rev.so | FileCheck %s -check-prefix=MULTI
+;
+; mgot1.o alone fits in one GOT, and needs no text relocation.
+; RUN: %MCLinker -march mipsel -mtriple=mipsel-none-linux-gnueabi \
+; RUN:           -filetype=dso -shared \
+; RUN:           -o %t.one.so %p/mgot1.o
+; RUN: readelf -d %t.one.so | FileCheck %s -check-prefix=SINGLE
+;
+; SINGLE-NOT: (TEXTREL)
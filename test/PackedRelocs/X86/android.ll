@@ -0,0 +1,28 @@
+; --pack-dyn-relocs=android packs .rela.dyn in the Android APS2 format and
+; tags it with DT_ANDROID_RELA and DT_ANDROID_RELASZ.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: --pack-dyn-relocs=android %p/obj/relocs.o -o %t.so
+; RUN: llvm-readelf -S -d %t.so | FileCheck %s
+; RUN: llvm-objdump -s -j .rela.dyn %t.so | FileCheck %s -check-prefix=MAGIC
+; RUN: llvm-readelf -r %t.so | FileCheck %s -check-prefix=RELOCS
+
+; CHECK: .rela.dyn ANDROID_RELA
+; CHECK: (ANDROID_RELA)
+; CHECK: (ANDROID_RELASZ)
+; CHECK-NOT: (RELASZ)
+
+; MAGIC: Contents of section .rela.dyn:
+; MAGIC-NEXT: APS2
+
+; The decoded relocations are the unpacked ones.
+; RELOCS-COUNT-5: R_X86_64_RELATIVE
+; RELOCS: R_X86_64_64 {{.*}} func
+
+; With android+relr, the word-aligned relative relocations go to .relr.dyn
+; and the rest is packed in APS2.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: --pack-dyn-relocs=android+relr %p/obj/relocs.o -o %t.both.so
+; RUN: llvm-readelf -S %t.both.so | FileCheck %s -check-prefix=BOTH
+
+; BOTH-DAG: .rela.dyn ANDROID_RELA
+; BOTH-DAG: .relr.dyn RELR
@@ -0,0 +1,20 @@
+; The APS2 section is sized before .dynsym is emitted. The relocations
+; against symbols are grouped by symbol and type, so the ones sharing r_info
+; are decoded next to each other, and they refer to the right symbols.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: --pack-dyn-relocs=android %p/obj/symbols.o -o %t.so
+; RUN: llvm-readelf -r %t.so | FileCheck %s
+; RUN: llvm-readelf -r %t.so | FileCheck %s -check-prefix=BAR
+; RUN: llvm-readelf -r %t.so | FileCheck %s -check-prefix=FOO
+
+; CHECK: R_X86_64_RELATIVE
+; CHECK-NOT: R_X86_64_RELATIVE
+; CHECK: R_X86_64_GLOB_DAT {{.*}} baz + 0
+
+; BAR: R_X86_64_64 {{.*}} bar + 0
+; BAR-NEXT: R_X86_64_64 {{.*}} bar + 8
+; BAR-NEXT: R_X86_64_64 {{.*}} bar + 0
+
+; FOO: R_X86_64_64 {{.*}} foo + 0
+; FOO-NEXT: R_X86_64_64 {{.*}} foo + 0
+; FOO-NEXT: R_X86_64_64 {{.*}} foo + 10
@@ -0,0 +1,28 @@
+; --pack-dyn-relocs=relr moves the relative relocations with word-aligned
+; places to .relr.dyn. The misaligned one stays in .rela.dyn.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: --pack-dyn-relocs=relr %p/obj/relocs.o -o %t.so
+; RUN: llvm-readelf -S -d %t.so | FileCheck %s
+; RUN: llvm-readelf -r %t.so | FileCheck %s -check-prefix=RELOCS
+; RUN: llvm-readelf -r %t.so | FileCheck %s -check-prefix=RELR
+
+; CHECK: .relr.dyn RELR
+; CHECK: (RELR)
+; CHECK: (RELRSZ) 0x10
+; CHECK: (RELRENT) 0x8
+
+; RELOCS: '.rela.dyn'
+; RELOCS-SAME: contains 2 entries
+; RELOCS-DAG: R_X86_64_RELATIVE
+; RELOCS-DAG: R_X86_64_64 {{.*}} func
+
+; RELR: '.relr.dyn'
+
+; Without the option, all relative relocations are in .rela.dyn.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: %p/obj/relocs.o -o %t.plain.so
+; RUN: llvm-readelf -S -r %t.plain.so | FileCheck %s -check-prefix=PLAIN
+
+; PLAIN-NOT: .relr.dyn
+; PLAIN: '.rela.dyn'
+; PLAIN-SAME: contains 6 entries
@@ -0,0 +1,25 @@
+; The places are word-aligned in .data before layout, but
+; --section-start moves .data to a misaligned address. The relative
+; relocations are given back to .rela.dyn after layout.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: --pack-dyn-relocs=relr --section-start .data=0x20004 \
+; RUN: %p/obj/relocs.o -o %t.so
+; RUN: llvm-readelf -S -r %t.so | FileCheck %s
+
+; CHECK: '.rela.dyn'
+; CHECK-SAME: contains 6 entries
+; CHECK-COUNT-5: R_X86_64_RELATIVE
+
+; With android+relr, the packed .rela.dyn is resized by its encoding, not
+; to the size of unpacked entries, and holds all of them.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: --pack-dyn-relocs=android+relr --section-start .data=0x20004 \
+; RUN: %p/obj/relocs.o -o %t.both.so
+; RUN: llvm-readelf -S %t.both.so | FileCheck %s -check-prefix=BOTH
+; RUN: llvm-readelf -r %t.both.so | FileCheck %s -check-prefix=DECODED
+
+; Six unpacked entries take 0x90 bytes.
+; BOTH: .rela.dyn ANDROID_RELA {{[0-9a-f]+}} {{[0-9a-f]+}} 0000{{[0-7][0-9a-f]}}
+
+; DECODED-COUNT-5: R_X86_64_RELATIVE
+; DECODED: R_X86_64_64 {{.*}} func
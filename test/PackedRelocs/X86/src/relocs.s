@@ -0,0 +1,27 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj relocs.s -o ../obj/relocs.o
+  .text
+  .globl func
+  .type func,@function
+func:
+  ret
+
+  .data
+  .p2align 3
+  .globl table
+table:
+  .quad local0
+  .quad local1
+  .quad local2
+  .quad local0 + 8
+  .byte 0
+  # not word-aligned, so it stays in .rela.dyn
+  .quad local1
+  .p2align 3
+  .quad func
+
+local0:
+  .quad 0
+local1:
+  .quad 0
+local2:
+  .quad 0
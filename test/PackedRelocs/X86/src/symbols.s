@@ -0,0 +1,26 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj symbols.s -o ../obj/symbols.o
+  .text
+  .globl foo
+  .type foo,@function
+foo:
+  ret
+
+  .globl bar
+  .type bar,@function
+bar:
+  .reloc ., R_X86_64_GOTPCREL, baz - 4
+  .long 0
+  ret
+
+  .data
+  .p2align 3
+  .globl baz
+baz:
+  .quad bar
+  .quad foo
+  .quad bar + 8
+  .quad foo
+  .quad bar
+  .quad local
+local:
+  .quad foo + 16
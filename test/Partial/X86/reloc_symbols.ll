@@ -0,0 +1,42 @@
+; A partial link rewrites the relocations against section symbols to the
+; output section symbols, and emits the symbol index of every relocation.
+; The relocations here alternate between section and global symbols, and
+; must come out as the golden model linker writes them.
+; RUN: %MCLinker -r -march=x86-64 -mtriple=x86_64-linux-gnu \
+; RUN: %p/obj/reloc_a.o %p/obj/reloc_b.o -o %t.o
+; RUN: llvm-readelf -r %t.o | FileCheck %s -check-prefix=RELOC
+; RUN: %GOLDLD -r %p/obj/reloc_a.o %p/obj/reloc_b.o -o %t.golden.o
+; RUN: llvm-readelf -r %t.golden.o | FileCheck %s -check-prefix=RELOC
+
+; RELOC: Relocation section '.rela.data' {{.*}} contains 12 entries:
+; RELOC: 0000000000000000 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} .text + 1
+; RELOC-NEXT: 0000000000000008 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} .rodata + 0
+; RELOC-NEXT: 0000000000000010 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} func_b + 0
+; RELOC-NEXT: 0000000000000018 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} .text + 1
+; RELOC-NEXT: 0000000000000020 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} data_a + 0
+; RELOC-NEXT: 0000000000000028 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} .rodata + 8
+; RELOC-NEXT: 0000000000000030 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} .text + 6
+; RELOC-NEXT: 0000000000000038 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} .rodata + 8
+; RELOC-NEXT: 0000000000000040 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} .text + 6
+; RELOC-NEXT: 0000000000000048 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} func_b + 0
+; RELOC-NEXT: 0000000000000050 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} .rodata + 8
+; RELOC-NEXT: 0000000000000058 {{[0-9a-f]+}} R_X86_64_64 {{[0-9a-f]+}} data_a + 0
+
+; Linking the partial output gives the same bytes as linking the objects.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --section-start .text=0x10000 --section-start .rodata=0x20000 \
+; RUN: --section-start .data=0x30000 \
+; RUN: %p/obj/reloc_a.o %p/obj/reloc_b.o -o %t.exe
+; RUN: llvm-objdump -s -j .data %t.exe | FileCheck %s -check-prefix=DATA
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --section-start .text=0x10000 --section-start .rodata=0x20000 \
+; RUN: --section-start .data=0x30000 %t.o -o %t.partial.exe
+; RUN: llvm-objdump -s -j .data %t.partial.exe | FileCheck %s -check-prefix=DATA
+
+; DATA: Contents of section .data:
+; DATA-NEXT: 30000 01000100 00000000 00000200 00000000
+; DATA-NEXT: 30010 04000100 00000000 01000100 00000000
+; DATA-NEXT: 30020 00000300 00000000 08000200 00000000
+; DATA-NEXT: 30030 06000100 00000000 08000200 00000000
+; DATA-NEXT: 30040 06000100 00000000 04000100 00000000
+; DATA-NEXT: 30050 08000200 00000000 00000300 00000000
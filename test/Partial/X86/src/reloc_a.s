@@ -0,0 +1,22 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj reloc_a.s -o ../obj/reloc_a.o
+# The relocations alternate between section symbols and global symbols.
+  .text
+  .globl _start
+_start:
+  ret
+local_a:
+  ret
+
+  .section .rodata,"a",@progbits
+ro_a:
+  .quad 1
+
+  .data
+  .globl data_a
+data_a:
+  .quad local_a
+  .quad ro_a
+  .quad func_b
+  .quad local_a
+  .quad data_a
+  .quad ro_a + 8
@@ -0,0 +1,20 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj reloc_b.s -o ../obj/reloc_b.o
+  .text
+  .globl func_b
+func_b:
+  nop
+  ret
+local_b:
+  ret
+
+  .section .rodata,"a",@progbits
+ro_b:
+  .quad 2
+
+  .data
+  .quad local_b
+  .quad ro_b
+  .quad local_b
+  .quad func_b
+  .quad ro_b
+  .quad data_a
@@ -0,0 +1,22 @@
+; The relocations of one input are applied in their original order, with
+; their places and symbol values computed up front. The relocated bytes must
+; match the golden model linker, whatever the types interleave like.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %p/obj/mixed_types.o %p/obj/abs_syms.o -o %t.exe
+; RUN: llvm-objdump -s -j .data %t.exe | FileCheck %s
+; RUN: %GOLDLD -static -e _start \
+; RUN: %p/obj/mixed_types.o %p/obj/abs_syms.o -o %t.golden.exe
+; RUN: llvm-objdump -s -j .data %t.golden.exe | FileCheck %s
+
+; Applying them again after a partial link gives the same bytes.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -r \
+; RUN: %p/obj/mixed_types.o %p/obj/abs_syms.o -o %t.o
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %t.o -o %t.partial.exe
+; RUN: llvm-objdump -s -j .data %t.partial.exe | FileCheck %s
+
+; CHECK: Contents of section .data:
+; CHECK-NEXT: {{[0-9a-f]+}} 44332211 00000000 26000000 88776655
+; CHECK-NEXT: {{[0-9a-f]+}} 88776655 00000000 44332211 12008877
+; CHECK-NEXT: {{[0-9a-f]+}} 0e000000 0a885433 22110000 00000000
+; CHECK-NEXT: {{[0-9a-f]+}} 0000
@@ -0,0 +1,5 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj abs_syms.s -o ../obj/abs_syms.o
+  .globl abs1
+  .set abs1, 0x11223344
+  .globl abs2
+  .set abs2, 0x55667788
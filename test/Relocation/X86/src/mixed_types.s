@@ -0,0 +1,42 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj mixed_types.s -o ../obj/mixed_types.o
+# Relocations of different types interleave, so runs of one type are short.
+# Their values depend neither on the layout nor on the order of applying.
+# abs1 and abs2 are defined in abs_syms.s.
+  .text
+  .globl _start
+  .type _start,@function
+_start:
+  ret
+
+  .globl abs1
+  .globl abs2
+
+  .data
+  .p2align 3
+  .globl table
+table:
+  .reloc ., R_X86_64_64, abs1
+  .quad 0
+  .reloc ., R_X86_64_PC32, mark
+  .long 0
+  .reloc ., R_X86_64_32, abs2
+  .long 0
+  .reloc ., R_X86_64_64, abs2
+  .quad 0
+  .reloc ., R_X86_64_32S, abs1
+  .long 0
+  .reloc ., R_X86_64_PC16, mark
+  .word 0
+  .reloc ., R_X86_64_16, abs2 - 0x55660000
+  .word 0
+  .reloc ., R_X86_64_PC32, mark
+  .long 0
+  .reloc ., R_X86_64_PC8, mark
+  .byte 0
+  .reloc ., R_X86_64_8, abs2 - 0x55667700
+  .byte 0
+  .reloc ., R_X86_64_64, abs1 + 0x10
+  .quad 0
+  .globl mark
+mark:
+  .long 0
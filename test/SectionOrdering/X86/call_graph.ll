@@ -0,0 +1,22 @@
+; --call-graph-profile-sort clusters the callers with their hottest callees
+; by the C3 heuristic. warm is the most likely caller of hot, and _start is
+; the most likely caller of warm. The sections out of the call graph follow
+; in the input order.
+; RUN: printf "_start hot 10\nwarm hot 100\n_start warm 50\n" > %t.cg
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --call-graph-profile-sort=%t.cg %p/obj/ordering.o -o %t.exe
+; RUN: llvm-nm -n %t.exe | FileCheck %s
+
+; CHECK: T _start
+; CHECK-NEXT: T warm
+; CHECK-NEXT: T hot
+; CHECK-NEXT: T cold
+; CHECK-NEXT: T aaa
+
+; A malformed line is an error.
+; RUN: printf "_start hot\n" > %t.bad
+; RUN: not %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --call-graph-profile-sort=%t.bad %p/obj/ordering.o -o %t.bad.exe 2>&1 \
+; RUN: | FileCheck %s -check-prefix=BAD
+
+; BAD: 1: invalid call graph profile entry `_start hot'
@@ -0,0 +1,35 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj ordering.s \
+#   -o ../obj/ordering.o
+  .section .text.main,"ax",@progbits
+  .globl _start
+  .type _start,@function
+_start:
+  call hot
+  call warm
+  ret
+
+  .section .text.cold,"ax",@progbits
+  .globl cold
+  .type cold,@function
+cold:
+  .fill 256, 1, 0x90
+  ret
+
+  .section .text.warm,"ax",@progbits
+  .globl warm
+  .type warm,@function
+warm:
+  call hot
+  ret
+
+  .section .text.hot,"ax",@progbits
+  .globl hot
+  .type hot,@function
+hot:
+  ret
+
+  .section .text.aaa,"ax",@progbits
+  .globl aaa
+  .type aaa,@function
+aaa:
+  ret
@@ -0,0 +1,30 @@
+; The input sections defining the symbols of --symbol-ordering-file are placed
+; first, in the order of the file. The missing symbols are reported in the
+; order of the file.
+; RUN: printf "hot\nmissing2\nwarm\nhot\nmissing1\n" > %t.order
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --symbol-ordering-file=%t.order %p/obj/ordering.o -o %t.exe 2>&1 \
+; RUN: | FileCheck %s -check-prefix=WARN
+; RUN: llvm-nm -n %t.exe | FileCheck %s
+
+; WARN: no such symbol `missing2'
+; WARN-NEXT: no such symbol `missing1'
+
+; CHECK: T hot
+; CHECK-NEXT: T warm
+; CHECK-NEXT: T _start
+; CHECK-NEXT: T cold
+; CHECK-NEXT: T aaa
+
+; The ordering also applies to the descriptions using SORT_*. The ordered
+; sections go first and the others are sorted by the policy.
+; RUN: echo "SECTIONS { .text : { *(SORT_BY_NAME(.text.*)) } }" > %t.x
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --symbol-ordering-file=%t.order -T %t.x %p/obj/ordering.o -o %t.sort.exe
+; RUN: llvm-nm -n %t.sort.exe | FileCheck %s -check-prefix=SORT
+
+; SORT: T hot
+; SORT-NEXT: T warm
+; SORT-NEXT: T aaa
+; SORT-NEXT: T cold
+; SORT-NEXT: T _start
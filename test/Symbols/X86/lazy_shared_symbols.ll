@@ -0,0 +1,33 @@
+; --lazy-shared-symbols reads only the entries of the shared libraries that
+; the link needs, and the output is the same as with all entries read: the
+; same .dynsym and DT_NEEDED. provided is defined by a PROVIDE in a script,
+; and _edata is a standard symbol, so both names are only looked up after
+; the inputs are read.
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: -soname=liblazy.so %p/obj/lazy_lib.o -o %t.lib.so
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: -soname=libprovide.so %p/obj/lazy_provide.o -o %t.provide.so
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -shared \
+; RUN: -soname=libstd.so %p/obj/lazy_std.o -o %t.std.so
+; RUN: echo "PROVIDE(provided = 0x1234);" > %t.t
+
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %p/obj/lazy_main.o %t.t --as-needed %t.lib.so %t.provide.so \
+; RUN: %t.std.so -o %t.eager
+; RUN: %MCLinker -march=x86-64 -mtriple=x86_64-linux-gnu -e _start \
+; RUN: --lazy-shared-symbols \
+; RUN: %p/obj/lazy_main.o %t.t --as-needed %t.lib.so %t.provide.so \
+; RUN: %t.std.so -o %t.lazy
+
+; RUN: llvm-readelf -d --dyn-syms %t.eager > %t.eager.txt
+; RUN: llvm-readelf -d --dyn-syms %t.lazy > %t.lazy.txt
+; RUN: diff %t.eager.txt %t.lazy.txt
+; RUN: FileCheck %s < %t.lazy.txt
+
+; CHECK-DAG: (NEEDED) Shared library: [liblazy.so]
+; CHECK-DAG: (NEEDED) Shared library: [libprovide.so]
+; CHECK-DAG: (NEEDED) Shared library: [libstd.so]
+; CHECK-DAG: foo
+; CHECK-DAG: bar
+; CHECK-DAG: obj
+; CHECK-NOT: unused
@@ -0,0 +1,28 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj lazy_lib.s -o ../obj/lazy_lib.o
+  .text
+  .globl foo
+  .type foo,@function
+foo:
+  ret
+
+  .globl bar
+  .type bar,@function
+bar:
+  ret
+
+  .globl unused
+  .type unused,@function
+unused:
+  ret
+
+  .data
+  .p2align 3
+  .globl obj
+  .weak obj_alias
+  .type obj,@object
+  .type obj_alias,@object
+  .size obj, 8
+  .size obj_alias, 8
+obj:
+obj_alias:
+  .quad 0
@@ -0,0 +1,13 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj lazy_main.s -o ../obj/lazy_main.o
+  .text
+  .globl _start
+  .type _start,@function
+_start:
+  call foo@PLT
+  movq obj(%rip), %rax
+  ret
+
+  .data
+  .p2align 3
+  .weak bar
+  .quad bar
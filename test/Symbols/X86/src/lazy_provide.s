@@ -0,0 +1,7 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj lazy_provide.s -o ../obj/lazy_provide.o
+  .data
+  .globl provided
+  .type provided,@object
+  .size provided, 4
+provided:
+  .long 0
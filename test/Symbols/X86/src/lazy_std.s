@@ -0,0 +1,7 @@
+# llvm-mc -triple=x86_64-linux-gnu -filetype=obj lazy_std.s -o ../obj/lazy_std.o
+  .data
+  .globl _edata
+  .type _edata,@object
+  .size _edata, 4
+_edata:
+  .long 0
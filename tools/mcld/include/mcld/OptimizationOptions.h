@@ -29,6 +29,12 @@ class OptimizationOptions {
   llvm::cl::opt<mcld::GeneralOptions::ICF>& m_ICF;
   llvm::cl::opt<unsigned>& m_ICFIterations;
   llvm::cl::opt<bool>& m_PrintICFSections;
+  llvm::cl::opt<std::string>& m_SymbolOrderingFile;
+  llvm::cl::opt<std::string>& m_CallGraphProfileSort;
+  llvm::cl::opt<mcld::GeneralOptions::CompressDebug>& m_CompressDebugSections;
+  bool& m_LazySharedSymbols;
+  llvm::cl::opt<std::string>& m_ArchiveIndexCache;
+  bool& m_Incremental;
   llvm::cl::opt<char>& m_OptLevel;
   llvm::cl::list<std::string>& m_Plugin;
   llvm::cl::list<std::string>& m_PluginOpt;
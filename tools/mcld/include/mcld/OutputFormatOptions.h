@@ -46,6 +46,8 @@ class OutputFormatOptions {
   llvm::cl::opt<bool>& m_NMagic;
   llvm::cl::opt<bool>& m_OMagic;
   llvm::cl::opt<mcld::GeneralOptions::HashStyle>& m_HashStyle;
+  llvm::cl::opt<unsigned>& m_HashSize;
+  llvm::cl::opt<mcld::GeneralOptions::PackDynRelocs>& m_PackDynRelocs;
 
   llvm::cl::opt<bool>& m_ExportDynamic;
   llvm::cl::opt<std::string>& m_BuildID;
@@ -32,6 +32,11 @@ class PreferenceOptions {
   llvm::cl::opt<int>& m_MaxWarnNum;
   llvm::cl::opt<Color>& m_Color;
   llvm::cl::opt<bool>& m_PrintMap;
+  llvm::cl::opt<std::string>& m_MapFile;
+  llvm::cl::opt<bool>& m_PrintStats;
+  llvm::cl::opt<bool>& m_PrintHashStats;
+  llvm::cl::opt<bool>& m_PrintMemoryUsage;
+  llvm::cl::opt<std::string>& m_TimeTrace;
   bool& m_FatalWarnings;
 };
 
@@ -93,6 +93,65 @@ llvm::cl::opt<bool> ArgPrintICFSections(
     llvm::cl::desc("Print the folded identical sections."),
     llvm::cl::init(false));
 
+llvm::cl::opt<std::string> ArgSymbolOrderingFile(
+    "symbol-ordering-file",
+    llvm::cl::desc("Place the sections of the listed symbols first, in the "
+                   "listed order."),
+    llvm::cl::value_desc("file"));
+
+llvm::cl::opt<std::string> ArgCallGraphProfileSort(
+    "call-graph-profile-sort",
+    llvm::cl::desc("Sort sections by a call graph profile of \"caller callee "
+                   "weight\" lines."),
+    llvm::cl::value_desc("file"));
+
+llvm::cl::opt<mcld::GeneralOptions::CompressDebug> ArgCompressDebugSections(
+    "compress-debug-sections",
+    llvm::cl::ZeroOrMore,
+    llvm::cl::desc("Compress the non-allocated debug sections of the output."),
+    llvm::cl::init(mcld::GeneralOptions::CompressDebug_None),
+    llvm::cl::values(
+        clEnumValN(mcld::GeneralOptions::CompressDebug_None,
+                   "none",
+                   "do not compress debug sections"),
+        clEnumValN(mcld::GeneralOptions::CompressDebug_Zlib,
+                   "zlib",
+                   "compress debug sections with zlib (ELFCOMPRESS_ZLIB)"),
+        clEnumValN(mcld::GeneralOptions::CompressDebug_Zlib,
+                   "zlib-gabi",
+                   "the same as zlib"),
+        clEnumValN(mcld::GeneralOptions::CompressDebug_Zstd,
+                   "zstd",
+                   "compress debug sections with zstd (ELFCOMPRESS_ZSTD)"),
+        clEnumValEnd));
+
+bool ArgLazySharedSymbols;
+
+llvm::cl::opt<bool, true> ArgLazySharedSymbolsFlag(
+    "lazy-shared-symbols",
+    llvm::cl::ZeroOrMore,
+    llvm::cl::location(ArgLazySharedSymbols),
+    llvm::cl::desc("Read the symbols of shared libraries only when they are "
+                   "referred to."),
+    llvm::cl::init(false));
+
+llvm::cl::opt<std::string> ArgArchiveIndexCache(
+    "archive-index-cache",
+    llvm::cl::desc("Keep the symbol indexes of archives in <dir> and reuse "
+                   "them in later links."),
+    llvm::cl::value_desc("dir"));
+
+bool ArgIncremental;
+
+llvm::cl::opt<bool, true> ArgIncrementalFlag(
+    "incremental",
+    llvm::cl::ZeroOrMore,
+    llvm::cl::location(ArgIncremental),
+    llvm::cl::desc("Patch the changed sections into the output of the last "
+                   "link instead of linking from scratch when their sizes, "
+                   "symbols and relocations are unchanged."),
+    llvm::cl::init(false));
+
 llvm::cl::opt<char> ArgOptLevel(
     "O",
     llvm::cl::desc(
@@ -125,6 +184,12 @@ OptimizationOptions::OptimizationOptions()
       m_ICF(ArgICF),
       m_ICFIterations(ArgICFIterations),
       m_PrintICFSections(ArgPrintICFSections),
+      m_SymbolOrderingFile(ArgSymbolOrderingFile),
+      m_CallGraphProfileSort(ArgCallGraphProfileSort),
+      m_CompressDebugSections(ArgCompressDebugSections),
+      m_LazySharedSymbols(ArgLazySharedSymbols),
+      m_ArchiveIndexCache(ArgArchiveIndexCache),
+      m_Incremental(ArgIncremental),
       m_OptLevel(ArgOptLevel),
       m_Plugin(ArgPlugin),
       m_PluginOpt(ArgPluginOpt) {
@@ -147,5 +212,24 @@ bool OptimizationOptions::parse(LinkerConfig& pConfig) {
   pConfig.options().setICFIterations(m_ICFIterations);
   pConfig.options().setPrintICFSections(m_PrintICFSections);
 
+  // set --symbol-ordering-file and --call-graph-profile-sort
+  if (!m_SymbolOrderingFile.empty())
+    pConfig.options().setSymbolOrderingFile(m_SymbolOrderingFile);
+  if (!m_CallGraphProfileSort.empty())
+    pConfig.options().setCallGraphProfileFile(m_CallGraphProfileSort);
+
+  // set --compress-debug-sections [type]
+  pConfig.options().setCompressDebugSections(m_CompressDebugSections);
+
+  // set --lazy-shared-symbols
+  pConfig.options().setLazySharedSymbols(m_LazySharedSymbols);
+
+  // set --archive-index-cache=<dir>
+  if (!m_ArchiveIndexCache.empty())
+    pConfig.options().setArchiveIndexCache(m_ArchiveIndexCache);
+
+  // set --incremental
+  pConfig.options().setIncremental(m_Incremental);
+
   return true;
 }
@@ -171,6 +171,33 @@ llvm::cl::opt<mcld::GeneralOptions::HashStyle> ArgHashStyle(
                    "both the classic ELF and new style GNU hash tables"),
         clEnumValEnd));
 
+llvm::cl::opt<unsigned> ArgHashSize(
+    "hash-size",
+    llvm::cl::ZeroOrMore,
+    llvm::cl::init(0),
+    llvm::cl::desc("Set the number of buckets of the hash table(s)."),
+    llvm::cl::value_desc("number"));
+
+llvm::cl::opt<mcld::GeneralOptions::PackDynRelocs> ArgPackDynRelocs(
+    "pack-dyn-relocs",
+    llvm::cl::ZeroOrMore,
+    llvm::cl::init(mcld::GeneralOptions::PackDynRelocs_None),
+    llvm::cl::desc("Pack the dynamic relocations of the output."),
+    llvm::cl::values(
+        clEnumValN(mcld::GeneralOptions::PackDynRelocs_None,
+                   "none",
+                   "plain .rel.dyn/.rela.dyn arrays"),
+        clEnumValN(mcld::GeneralOptions::PackDynRelocs_Android,
+                   "android",
+                   "Android APS2 packed .rel.dyn/.rela.dyn"),
+        clEnumValN(mcld::GeneralOptions::PackDynRelocs_Relr,
+                   "relr",
+                   "relative relocations in .relr.dyn"),
+        clEnumValN(mcld::GeneralOptions::PackDynRelocs_AndroidRelr,
+                   "android+relr",
+                   "both .relr.dyn and Android APS2 packing"),
+        clEnumValEnd));
+
 llvm::cl::opt<bool> ArgNoWarnMismatch(
     "no-warn-mismatch",
     llvm::cl::desc("Allow linking together mismatched input files."),
@@ -225,6 +252,8 @@ OutputFormatOptions::OutputFormatOptions()
       m_NMagic(ArgNMagic),
       m_OMagic(ArgOMagic),
       m_HashStyle(ArgHashStyle),
+      m_HashSize(ArgHashSize),
+      m_PackDynRelocs(ArgPackDynRelocs),
       m_ExportDynamic(ArgExportDynamic),
       m_BuildID(ArgBuildID),
       m_ExcludeLIBS(ArgExcludeLIBS),
@@ -255,6 +284,8 @@ bool OutputFormatOptions::parse(mcld::Module& pModule, LinkerConfig& pConfig) {
   pConfig.options().setNMagic(m_NMagic);
   pConfig.options().setOMagic(m_OMagic);
   pConfig.options().setHashStyle(m_HashStyle);
+  pConfig.options().setHashSize(m_HashSize);
+  pConfig.options().setPackDynRelocs(m_PackDynRelocs);
   pConfig.options().setExportDynamic(m_ExportDynamic);
 
   // --exclude-libs
@@ -91,6 +91,33 @@ llvm::cl::alias ArgPrintMapAlias("print-map",
                                  llvm::cl::desc("alias for -M"),
                                  llvm::cl::aliasopt(ArgPrintMap));
 
+llvm::cl::opt<std::string> ArgMapFile(
+    "Map",
+    llvm::cl::desc("Write a link map to <file>."),
+    llvm::cl::value_desc("file"));
+
+llvm::cl::opt<bool> ArgPrintStats(
+    "print-stats",
+    llvm::cl::desc(
+        "Print the time, memory usage and IR size of each linking phase."),
+    llvm::cl::init(false));
+
+llvm::cl::opt<bool> ArgPrintHashStats(
+    "print-hash-stats",
+    llvm::cl::desc("Print the chain lengths of the .gnu.hash section."),
+    llvm::cl::init(false));
+
+llvm::cl::opt<bool> ArgPrintMemoryUsage(
+    "print-memory-usage",
+    llvm::cl::desc("Print the chunks, objects and bytes of each memory pool."),
+    llvm::cl::init(false));
+
+llvm::cl::opt<std::string> ArgTimeTrace(
+    "time-trace",
+    llvm::cl::desc(
+        "Write the linking phases to <file> in Chrome trace-event format."),
+    llvm::cl::value_desc("file"));
+
 bool ArgFatalWarnings;
 
 llvm::cl::opt<bool, true, llvm::cl::FalseParser> ArgNoFatalWarnings(
@@ -141,6 +168,11 @@ PreferenceOptions::PreferenceOptions()
       m_MaxWarnNum(ArgMaxWarnNum),
       m_Color(ArgColor),
       m_PrintMap(ArgPrintMap),
+      m_MapFile(ArgMapFile),
+      m_PrintStats(ArgPrintStats),
+      m_PrintHashStats(ArgPrintHashStats),
+      m_PrintMemoryUsage(ArgPrintMemoryUsage),
+      m_TimeTrace(ArgTimeTrace),
       m_FatalWarnings(ArgFatalWarnings) {
 }
 
@@ -151,6 +183,26 @@ bool PreferenceOptions::parse(LinkerConfig& pConfig) {
   // set --verbose
   pConfig.options().setVerbose(m_Verbose);
 
+  // set -M
+  pConfig.options().setPrintMap(m_PrintMap);
+
+  // set -Map=<file>
+  if (!m_MapFile.empty())
+    pConfig.options().setMapFile(m_MapFile);
+
+  // set --print-stats
+  pConfig.options().setPrintStats(m_PrintStats);
+
+  // set --print-hash-stats
+  pConfig.options().setPrintHashStats(m_PrintHashStats);
+
+  // set --print-memory-usage
+  pConfig.options().setPrintMemoryUsage(m_PrintMemoryUsage);
+
+  // set --time-trace=<file>
+  if (!m_TimeTrace.empty())
+    pConfig.options().setTimeTraceFile(m_TimeTrace);
+
   // set --error-limit [number]
   pConfig.options().setMaxErrorNum(m_MaxErrorNum);
 
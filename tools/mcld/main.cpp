@@ -88,6 +88,16 @@ static inline bool ConfigLinker(
   if (pConfig.options().soname().empty())
     pConfig.options().setSOName(pModule.name());
 
+  // an incremental link patches only the output of the same command line
+  if (pConfig.options().incremental()) {
+    std::string key;
+    for (int i = 1; i < pArgc; ++i) {
+      key += pArgv[i];
+      key += '\0';
+    }
+    pConfig.options().setIncrementalKey(key);
+  }
+
   return true;
 }
 
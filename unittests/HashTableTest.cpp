@@ -10,6 +10,7 @@
 #include "HashTableTest.h"
 #include "mcld/ADT/HashEntry.h"
 #include "mcld/ADT/HashTable.h"
+#include "mcld/ADT/StringHash.h"
 #include <cstdlib>
 
 using namespace std;
@@ -313,3 +314,16 @@ TEST_F(HashTableTest, chain_iterator_list) {
   ASSERT_EQ(16, count);
   delete hashTable;
 }
+
+TEST_F(HashTableTest, elf_and_gnu_hash_of_high_bit_names) {
+  hash::StringHash<hash::ELF> elf_hash;
+  hash::StringHash<hash::DJB> gnu_hash;
+
+  EXPECT_EQ(0x077905a6u, elf_hash("printf"));
+  EXPECT_EQ(0x156b2bb8u, gnu_hash("printf"));
+
+  // "caf\xc3\xa9" (UTF-8 cafe with an acute accent). The bytes are hashed as
+  // unsigned char, as the System V ABI and GNU ld/gold/lld do.
+  EXPECT_EQ(0x006982d9u, elf_hash("caf\xc3\xa9"));
+  EXPECT_EQ(0x0f35767bu, gnu_hash("caf\xc3\xa9"));
+}
@@ -131,3 +131,37 @@ TEST_F(LinearAllocatorTest, multi_allocN_ctor_iterate) {
           }
   **/
 }
+
+TEST_F(LinearAllocatorTest, usage) {
+  Data* pointer = m_pTestee->allocate(10);
+  m_pTestee->allocate();
+  m_pTestee->deallocate(pointer, 1);
+
+  MemoryPool::Usage usage;
+  m_pTestee->getUsage(usage);
+  ASSERT_EQ(sizeof(Data), usage.objectSize);
+  ASSERT_EQ(1u, usage.chunks);
+  ASSERT_EQ(11u, usage.objects);
+  ASSERT_EQ(11u, usage.peakObjects);
+  ASSERT_EQ(11 * sizeof(Data), usage.usedBytes);
+  ASSERT_TRUE(usage.reservedBytes >= CHUNK_SIZE * sizeof(Data));
+
+  m_pTestee->clear();
+  m_pTestee->getUsage(usage);
+  ASSERT_EQ(0u, usage.chunks);
+  ASSERT_EQ(0u, usage.objects);
+  ASSERT_EQ(11u, usage.peakObjects);
+}
+
+TEST_F(LinearAllocatorTest, chunks_grow) {
+  for (int i = 0; i < 100000; ++i)
+    m_pTestee->construct(m_pTestee->allocate());
+
+  MemoryPool::Usage usage;
+  m_pTestee->getUsage(usage);
+  ASSERT_EQ(100000u, usage.objects);
+  // the chunks grow up to 64 times the first one
+  ASSERT_TRUE(usage.chunks < 100000 / CHUNK_SIZE / 16);
+  // the last chunk wastes at most a quarter of the pool
+  ASSERT_TRUE(m_pTestee->max_size() * 4 <= 100000u * 5 + CHUNK_SIZE * 4);
+}
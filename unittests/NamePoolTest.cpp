@@ -139,6 +139,27 @@ TEST_F(NamePoolTest, insert_global_reference_Symbol) {
   EXPECT_NE(result1.info, result3.info);
 }
 
+TEST_F(NamePoolTest, findInfo_by_hash) {
+  const char* name = "Hello MCLinker";
+  Resolver::Result result;
+  m_pTestee->insertSymbol(name,
+                          false,
+                          ResolveInfo::NoType,
+                          ResolveInfo::Undefined,
+                          ResolveInfo::Global,
+                          0,
+                          ResolveInfo::Default,
+                          NULL,
+                          result);
+
+  const NamePool& pool = *m_pTestee;
+  unsigned int hash = NamePool::hash(name);
+  EXPECT_EQ(result.info, pool.findInfo(name, hash));
+  EXPECT_EQ(pool.findInfo(name), pool.findInfo(name, hash));
+  EXPECT_TRUE(NULL == pool.findInfo("Different Symbol",
+                                    NamePool::hash("Different Symbol")));
+}
+
 TEST_F(NamePoolTest, insertSymbol_after_insert_same_string) {
   const char* name = "Hello MCLinker";
   bool isDyn = false;
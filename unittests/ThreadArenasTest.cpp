@@ -0,0 +1,137 @@
+//===- ThreadArenasTest.cpp -----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "ThreadArenasTest.h"
+
+#include "mcld/Fragment/FillFragment.h"
+#include "mcld/LD/LDFileFormat.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/RelocData.h"
+#include "mcld/LD/SectionData.h"
+
+#include <llvm/Support/Casting.h>
+
+#include <thread>
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+const unsigned int NumOfFragments = 1000;
+
+struct Built {
+  LDSection* section;
+  SectionData* data;
+  RelocData* relocs;
+};
+
+/// Build - build a section with its fragments, as a reader thread does
+void Build(Built* pOut, const char* pName) {
+  pOut->section = LDSection::Create(pName, LDFileFormat::TEXT, 0, 0);
+  pOut->data = SectionData::Create(*pOut->section);
+  for (unsigned int i = 0; i < NumOfFragments; ++i)
+    new FillFragment(i, 1, 1, pOut->data);
+  pOut->relocs = RelocData::Create(*pOut->section);
+}
+
+/// IsIntact - the fragments of pBuilt are in the order they were appended
+bool IsIntact(const Built& pBuilt) {
+  if (&pBuilt.data->getSection() != pBuilt.section ||
+      &pBuilt.relocs->getSection() != pBuilt.section ||
+      pBuilt.data->size() != NumOfFragments)
+    return false;
+  int64_t value = 0;
+  SectionData::const_iterator frag, fragEnd = pBuilt.data->end();
+  for (frag = pBuilt.data->begin(); frag != fragEnd; ++frag, ++value) {
+    const FillFragment* fill = llvm::dyn_cast<FillFragment>(&*frag);
+    if (fill == NULL || fill->getValue() != value)
+      return false;
+  }
+  return true;
+}
+
+}  // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+ThreadArenasTest::ThreadArenasTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ThreadArenasTest::~ThreadArenasTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void ThreadArenasTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void ThreadArenasTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(ThreadArenasTest, build_in_two_threads) {
+  Built a, b;
+  std::thread first(Build, &a, "a");
+  std::thread second(Build, &b, "b");
+  first.join();
+  second.join();
+
+  ASSERT_TRUE(a.data != b.data);
+  ASSERT_TRUE(a.relocs != b.relocs);
+  EXPECT_TRUE(a.section->name() == "a");
+  EXPECT_TRUE(b.section->name() == "b");
+  EXPECT_TRUE(IsIntact(a));
+  EXPECT_TRUE(IsIntact(b));
+}
+
+TEST_F(ThreadArenasTest, destroy_from_another_arena) {
+  Built a, b;
+  std::thread first(Build, &a, "a");
+  std::thread second(Build, &b, "b");
+  first.join();
+  second.join();
+
+  // the main thread has an arena of its own
+  Built c;
+  Build(&c, "c");
+
+  // giving the objects of other arenas back to the arena of the main thread
+  // does nothing to them and to the objects of the main thread
+  SectionData::Destroy(a.data);
+  RelocData::Destroy(a.relocs);
+  EXPECT_TRUE(a.data == NULL);
+  EXPECT_TRUE(a.relocs == NULL);
+  EXPECT_TRUE(IsIntact(b));
+  EXPECT_TRUE(IsIntact(c));
+
+  // the next object of the main thread does not reuse their memory
+  Built d;
+  Build(&d, "d");
+  EXPECT_TRUE(IsIntact(b));
+  EXPECT_TRUE(IsIntact(c));
+  EXPECT_TRUE(IsIntact(d));
+}
+
+TEST_F(ThreadArenasTest, clear_after_threads_exit) {
+  Built a;
+  std::thread first(Build, &a, "a");
+  first.join();
+  EXPECT_TRUE(IsIntact(a));
+
+  // the arena of an exited thread is cleared as well
+  SectionData::Clear();
+  RelocData::Clear();
+
+  Built b;
+  std::thread second(Build, &b, "b");
+  second.join();
+  EXPECT_TRUE(IsIntact(b));
+}
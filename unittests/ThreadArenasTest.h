@@ -0,0 +1,38 @@
+//===- ThreadArenasTest.h -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_THREADARENAS_TEST_H
+#define MCLD_THREADARENAS_TEST_H
+
+#include <gtest.h>
+
+namespace mcldtest {
+
+/** \class ThreadArenasTest
+ *  \brief The IR built by several threads in their own arenas.
+ *
+ *  \see ThreadArenas
+ */
+class ThreadArenasTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  ThreadArenasTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~ThreadArenasTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+};
+
+}  // namespace of mcldtest
+
+#endif